@@ -4,6 +4,7 @@
 
 #include "Graphics/GraphicsUtils.h"
 #include "Math/Angle.h"
+#include "Math/DualGeometry.h"
 #include "Math/Intersections.h"
 #include "Math/Length.h"
 
@@ -14,8 +15,6 @@
 namespace LM
 {
 
-    constexpr size_t kSections = 36;
-
     glm::mat4 GetGrindingWheelMatrix(float _OffsetToolCenter, float _OffsetToolAxis, float _ToolAngle,
                                      float _RotatinOffset)
     {
@@ -23,6 +22,13 @@ namespace LM
                glm::rotate(glm::mat4(1.0f), glm::radians(90.0f - _ToolAngle), glm::vec3(0.0f, -1.0f, 0.0f));
     }
 
+    ParamsDualMat4 GetGrindingWheelMatrix(const ParamsDual& _OffsetToolCenter, const ParamsDual& _OffsetToolAxis,
+                                          const ParamsDual& _ToolAngle, const ParamsDual& _RotatinOffset)
+    {
+        return Translate(_OffsetToolAxis, _OffsetToolCenter, _RotatinOffset) *
+               Rotate(Radians(90.0 - _ToolAngle), glm::vec3(0.0f, -1.0f, 0.0f));
+    }
+
     float MoveOverToolAxisRotationRadToOffset(float _RotationRad, float _ToolDiametr, float _ToolAngle)
     {
         return (_RotationRad * _ToolDiametr / 2.0f) * glm::tan(glm::radians(_ToolAngle));
@@ -130,12 +136,34 @@ namespace LM
                                    const GrindingWheelProfileParams& _WheelProfileParams, const ToolParams& _ToolParams,
                                    const ParamsToFind& _ParamsToFind, ParamsToFind* _NearestParamsToFind,
                                    float* _LowestDelta, BestResult* _BestResult, BestResultMeta* _Meta)
+    {
+        CalculateBestResultSingle(CalculateGrindingWheelSizes(_WheelParams), _WheelParams, _WheelProfileParams,
+                                  _ToolParams, _ParamsToFind, _NearestParamsToFind, _LowestDelta, _BestResult, _Meta);
+    }
+
+    float CalculateWheelToPointDistance(const ShapeParams& _ShapeParams, const GrindingWheelParams& _WheelParams,
+                                        const glm::mat4& _Matrix, const glm::vec2& _Point)
+    {
+        float distance = LineToPointDistance(_Matrix * _ShapeParams.LeftCenterPoint, _Matrix * _ShapeParams.R1Start,
+                                             _Point);
+        distance = glm::min(distance, ArcToPointDistance(_Matrix, _ShapeParams.R1Center, _WheelParams.R1, 180.0f,
+                                                         270.0f + _WheelParams.Angle, _Point));
+        distance = glm::min(
+            distance, LineToPointDistance(_Matrix * _ShapeParams.R1End, _Matrix * _ShapeParams.R2Start, _Point));
+        distance = glm::min(distance, ArcToPointDistance(_Matrix, _ShapeParams.R2Center, _WheelParams.R2,
+                                                         270.0f + _WheelParams.Angle, 360.0f, _Point));
+        distance = glm::min(distance, LineToPointDistance(_Matrix * _ShapeParams.R2End,
+                                                          _Matrix * _ShapeParams.RightCenterPoint, _Point));
+        return distance;
+    }
+
+    bool CalculateParamsSingle(const ShapeParams& _ShapeParams, const GrindingWheelParams& _WheelParams,
+                               const GrindingWheelProfileParams& _WheelProfileParams, const ToolParams& _ToolParams,
+                               ParamsToFind* _Result)
     {
         float toolRadius = _ToolParams.Diametr / 2.0f;
 
-        _Meta->Calculated++;
-        // GrindingWheelParams params = { diametr, width, r1, r2, angle };
-        auto shapeParams = CalculateGrindingWheelSizes(_WheelParams);
+        const ShapeParams& shapeParams = _ShapeParams;
 
         glm::mat4 wheelMatrix0 =
             GetGrindingWheelMatrix(_WheelProfileParams.OffsetToolCenter, _WheelProfileParams.OffsetToolAxis,
@@ -143,8 +171,7 @@ namespace LM
 
         // if (!IsWheelCorrect(shapeParams, _WheelParams, wheelMatrix0, _ToolParams.Diametr))
         //{
-        //     _Meta->BadCalculations++;
-        //     return;
+        //     return false;
         // }
         // LOGW("WHEEL CORRECT!!!");
 
@@ -168,10 +195,8 @@ namespace LM
         float frontAngle = CalcAngle(glm::vec4(-leftOnTool, 0.0f, 1.0f), maxRotationR1Start - maxRotationLeftCenter);
         if (isnan(frontAngle))
         {
-            _Meta->BadCalculations++;
-            return;
+            return false;
         }
-        LOGW("WHEEL CORRECT!!!");
 
         // TODO: fix next time lower code
         glm::mat4 minRotationMatrix =
@@ -187,62 +212,221 @@ namespace LM
         float stepAngle = CalcAngle(glm::vec4(rightOnTool, 0.0f, 1.0f), glm::vec4(leftOnTool, 0.0f, 1.0f));
         if (isnan(stepAngle))
         {
-            _Meta->BadCalculations++;
-            return;
+            return false;
         }
 
-        // std::vector<glm::vec4> vertices;
-        // AddCircleCurve(
-        //     { 180.0f, 270.0f + _WheelParams.Angle, _WheelParams.R1, shapeParams.R1Center.x, shapeParams.R1Center.y },
-        //     kSections, vertices);
-
-        float diametrIn = 2.0f * LineToPointDistance(wheelMatrix0 * shapeParams.R1End,
-                                                     wheelMatrix0 * shapeParams.R2Start, glm::vec2(0.0f));
-        // for (const glm::vec4& vert : vertices)
-        //{
-        //     diametrIn = glm::min(diametrIn, 2.0f * Vec2Length(wheelMatrix0 * vert));
-        // }
+        float diametrIn =
+            2.0f * CalculateWheelToPointDistance(shapeParams, _WheelParams, wheelMatrix0, glm::vec2(0.0f));
 
         if (isnan(diametrIn))
         {
-            _Meta->BadCalculations++;
-            return;
+            return false;
+        }
+
+        _Result->FrontAngle = frontAngle;
+        _Result->StepAngle = stepAngle;
+        _Result->DiametrIn = diametrIn;
+
+        return true;
+    }
+
+    typedef DualVec2<kParamsJacobianInputsCount> ParamsDualVec2;
+    typedef DualVec4<kParamsJacobianInputsCount> ParamsDualVec4;
+
+    struct ParamsDualShape
+    {
+        ParamsDualVec4 LeftCenterPoint;
+        ParamsDualVec4 RightCenterPoint;
+        ParamsDualVec4 R1Center;
+        ParamsDualVec4 R1Start;
+        ParamsDualVec4 R1End;
+        ParamsDualVec4 R2Center;
+        ParamsDualVec4 R2Start;
+        ParamsDualVec4 R2End;
+    };
+
+    // Same as CalculateGrindingWheelSizes
+    static ParamsDualShape CalculateGrindingWheelSizes(const ParamsDual& _Diametr, const ParamsDual& _Width,
+                                                       const ParamsDual& _R1, const ParamsDual& _R2,
+                                                       const ParamsDual& _Angle)
+    {
+        ParamsDual angle = Radians(_Angle);
+        ParamsDual sinAngle = Sin(angle);
+        ParamsDual cosAngle = Cos(angle);
+        ParamsDual tanAngle = Tan(angle);
+
+        ParamsDual r1DEndX = _R1 + sinAngle * _R1;
+        ParamsDual r1DEndY = tanAngle * r1DEndX;
+        ParamsDual r1CenterY = r1DEndY + cosAngle * _R1;
+
+        ParamsDual r2DStartX = _R2 - sinAngle * _R2;
+        ParamsDual r1r2DX = _Width - r1DEndX - r2DStartX;
+        ParamsDual r2PointStartX = r1DEndX + r1r2DX;
+        ParamsDual r2PointStartY = r1DEndY + tanAngle * r1r2DX;
+        ParamsDual r2CenterY = r2PointStartY + cosAngle * _R2;
+
+        auto point = [](const ParamsDual& _X, const ParamsDual& _Y) { return ParamsDualVec4 { _X, _Y, 0.0, 1.0 }; };
+
+        ParamsDualShape result;
+        result.LeftCenterPoint = point(0.0, _Diametr / 2.0);
+        result.RightCenterPoint = point(_Width, _Diametr / 2.0);
+        result.R1Center = point(_R1, r1CenterY);
+        result.R1Start = point(0.0, r1CenterY);
+        result.R1End = point(r1DEndX, r1DEndY);
+        result.R2Center = point(_Width - _R2, r2CenterY);
+        result.R2Start = point(r2PointStartX, r2PointStartY);
+        result.R2End = point(_Width, r2CenterY);
+        return result;
+    }
+
+    bool CalculateParamsJacobian(const GrindingWheelCalcParams& _Values, const ToolParams& _ToolParams,
+                                 ParamsJacobian* _Result)
+    {
+        const ParamsDual diametr = ParamsDual::Variable(_Values.Diametr, 0);
+        const ParamsDual width = ParamsDual::Variable(_Values.Width, 1);
+        const ParamsDual r1 = ParamsDual::Variable(_Values.R1, 2);
+        const ParamsDual r2 = ParamsDual::Variable(_Values.R2, 3);
+        const ParamsDual angle = ParamsDual::Variable(_Values.Angle, 4);
+        const ParamsDual offsetToolCenter = ParamsDual::Variable(_Values.OffsetToolCenter, 5);
+        const ParamsDual offsetToolAxis = ParamsDual::Variable(_Values.OffsetToolAxis, 6);
+        const ParamsDual rotationAngle = ParamsDual::Variable(_Values.RotationAngle, 7);
+        const ParamsDual toolAngle = ParamsDual::Variable(_ToolParams.Angle, kParamsJacobianToolAngle);
+        const ParamsDual toolRadius = _ToolParams.Diametr / 2.0;
+
+        const ParamsDualShape shape = CalculateGrindingWheelSizes(diametr, width, r1, r2, angle);
+        const ParamsDualMat4 wheelMatrix0 =
+            GetGrindingWheelMatrix(offsetToolCenter, offsetToolAxis, rotationAngle, ParamsDual(0.0));
+
+        // CalcMoveOverToolAxis, the max rotation and offset are zero, so its matrix is wheelMatrix0
+        ParamsDualVec2 rightOnToolNoAngle = LineCircleIntersection(toolRadius, ToVec2(wheelMatrix0 * shape.R1End),
+                                                                   ToVec2(wheelMatrix0 * shape.R2Start));
+        ParamsDual minOffset = -Tan(Radians(90.0 - rotationAngle)) * (rightOnToolNoAngle.x - offsetToolAxis);
+        ParamsDual minRotationRad = (minOffset / Tan(Radians(toolAngle))) / toolRadius;
+
+        ParamsDualVec4 maxRotationLeftCenter = wheelMatrix0 * shape.LeftCenterPoint;
+        ParamsDualVec4 maxRotationR1Start = wheelMatrix0 * shape.R1Start;
+        ParamsDualVec2 leftOnTool =
+            LineCircleIntersection(toolRadius, ToVec2(maxRotationLeftCenter), ToVec2(maxRotationR1Start));
+        ParamsDual frontAngle = CalcAngle(-leftOnTool, ToVec2(maxRotationR1Start - maxRotationLeftCenter));
+        if (isnan(frontAngle.Value))
+        {
+            return false;
+        }
+
+        ParamsDualMat4 minRotationMatrix = Rotate(minRotationRad, glm::vec3(0.0f, 0.0f, 1.0f)) *
+                                           GetGrindingWheelMatrix(offsetToolCenter, offsetToolAxis, rotationAngle,
+                                                                  minOffset);
+        ParamsDualVec2 rightOnTool = LineCircleIntersection(toolRadius, ToVec2(minRotationMatrix * shape.R1End),
+                                                            ToVec2(minRotationMatrix * shape.R2Start));
+        ParamsDual stepAngle = CalcAngle(rightOnTool, leftOnTool);
+        if (isnan(stepAngle.Value))
+        {
+            return false;
         }
 
-        // float deltaFrontAngle = glm::abs(frontAngle - _ParamsToFind.FrontAngle);
+        // CalculateWheelToPointDistance
+        const ParamsDualVec2 origin = { 0.0, 0.0 };
+        auto lineDistance = [&](const ParamsDualVec4& _Start, const ParamsDualVec4& _End) {
+            return LineToPointDistance(ToVec2(wheelMatrix0 * _Start), ToVec2(wheelMatrix0 * _End), origin);
+        };
+        ParamsDual distance = lineDistance(shape.LeftCenterPoint, shape.R1Start);
+        distance = Min(distance,
+                       ArcToPointDistance(wheelMatrix0, shape.R1Center, r1, ParamsDual(180.0), 270.0 + angle, origin));
+        distance = Min(distance, lineDistance(shape.R1End, shape.R2Start));
+        distance = Min(distance,
+                       ArcToPointDistance(wheelMatrix0, shape.R2Center, r2, 270.0 + angle, ParamsDual(360.0), origin));
+        distance = Min(distance, lineDistance(shape.R2End, shape.RightCenterPoint));
+
+        ParamsDual diametrIn = 2.0 * distance;
+        if (isnan(diametrIn.Value))
+        {
+            return false;
+        }
+
+        _Result->FrontAngle = frontAngle;
+        _Result->StepAngle = stepAngle;
+        _Result->DiametrIn = diametrIn;
+
+        return true;
+    }
+
+    void UpdateNearestParamsToFind(const ParamsToFind& _Params, const ParamsToFind& _ParamsToFind,
+                                   ParamsToFind* _NearestParamsToFind)
+    {
+        // float deltaFrontAngle = glm::abs(_Params.FrontAngle - _ParamsToFind.FrontAngle);
         // if (deltaFrontAngle < glm::abs(_NearestParamsToFind->FrontAngle - _ParamsToFind.FrontAngle))
         //{
-        //     _NearestParamsToFind->FrontAngle = frontAngle;
+        //     _NearestParamsToFind->FrontAngle = _Params.FrontAngle;
         // }
-        float deltaFrontAngle = 0.0f;
-        _NearestParamsToFind->FrontAngle = frontAngle;
-        float deltaStepAngle = glm::abs(stepAngle - _ParamsToFind.StepAngle);
+        _NearestParamsToFind->FrontAngle = _Params.FrontAngle;
+        float deltaStepAngle = glm::abs(_Params.StepAngle - _ParamsToFind.StepAngle);
         if (deltaStepAngle < glm::abs(_NearestParamsToFind->StepAngle - _ParamsToFind.StepAngle))
         {
-            _NearestParamsToFind->StepAngle = stepAngle;
+            _NearestParamsToFind->StepAngle = _Params.StepAngle;
         }
-        float deltaDiametrIn = glm::abs(diametrIn - _ParamsToFind.DiametrIn);
+        float deltaDiametrIn = glm::abs(_Params.DiametrIn - _ParamsToFind.DiametrIn);
         if (deltaDiametrIn < glm::abs(_NearestParamsToFind->DiametrIn - _ParamsToFind.DiametrIn))
         {
-            _NearestParamsToFind->DiametrIn = diametrIn;
+            _NearestParamsToFind->DiametrIn = _Params.DiametrIn;
         }
+    }
+
+    float CalculateParamsDelta(const ParamsToFind& _Params, const ParamsToFind& _ParamsToFind)
+    {
+        float deltaFrontAngle = 0.0f;
+        float deltaStepAngle = glm::abs(_Params.StepAngle - _ParamsToFind.StepAngle);
+        float deltaDiametrIn = glm::abs(_Params.DiametrIn - _ParamsToFind.DiametrIn);
+
+        return deltaFrontAngle + deltaStepAngle + deltaDiametrIn;
+    }
+
+    BestResult MakeBestResult(const GrindingWheelParams& _WheelParams,
+                              const GrindingWheelProfileParams& _WheelProfileParams, const ParamsToFind& _Params)
+    {
+        BestResult result;
+        result.Diametr = _WheelParams.Diametr;
+        result.Width = _WheelParams.Width;
+        result.R1 = _WheelParams.R1;
+        result.R2 = _WheelParams.R2;
+        result.Angle = _WheelParams.Angle;
+        result.OffsetToolCenter = _WheelProfileParams.OffsetToolCenter;
+        result.OffsetToolAxis = _WheelProfileParams.OffsetToolAxis;
+        result.RotationAngle = _WheelProfileParams.RotationAngle;
+
+        result.FrontAngle = _Params.FrontAngle;
+        result.StepAngle = _Params.StepAngle;
+        result.DiametrIn = _Params.DiametrIn;
+
+        return result;
+    }
+
+    GrindingWheelCalcParams GetBestResultValues(const BestResult& _Result)
+    {
+        return { _Result.Diametr, _Result.Width,           _Result.R1,             _Result.R2,
+                 _Result.Angle,   _Result.OffsetToolCenter, _Result.OffsetToolAxis, _Result.RotationAngle };
+    }
+
+    void CalculateBestResultSingle(const ShapeParams& _ShapeParams, const GrindingWheelParams& _WheelParams,
+                                   const GrindingWheelProfileParams& _WheelProfileParams, const ToolParams& _ToolParams,
+                                   const ParamsToFind& _ParamsToFind, ParamsToFind* _NearestParamsToFind,
+                                   float* _LowestDelta, BestResult* _BestResult, BestResultMeta* _Meta)
+    {
+        _Meta->Calculated++;
+
+        ParamsToFind params;
+        if (!CalculateParamsSingle(_ShapeParams, _WheelParams, _WheelProfileParams, _ToolParams, &params))
+        {
+            _Meta->BadCalculations++;
+            return;
+        }
+
+        UpdateNearestParamsToFind(params, _ParamsToFind, _NearestParamsToFind);
 
-        float delta = deltaFrontAngle + deltaStepAngle + deltaDiametrIn;
+        float delta = CalculateParamsDelta(params, _ParamsToFind);
         if (delta < (*_LowestDelta))
         {
             *_LowestDelta = delta;
-            _BestResult->Diametr = _WheelParams.Diametr;
-            _BestResult->Width = _WheelParams.Width;
-            _BestResult->R1 = _WheelParams.R1;
-            _BestResult->R2 = _WheelParams.R2;
-            _BestResult->Angle = _WheelParams.Angle;
-            _BestResult->OffsetToolCenter = _WheelProfileParams.OffsetToolCenter;
-            _BestResult->OffsetToolAxis = _WheelProfileParams.OffsetToolAxis;
-            _BestResult->RotationAngle = _WheelProfileParams.RotationAngle;
-
-            _BestResult->FrontAngle = frontAngle;
-            _BestResult->StepAngle = stepAngle;
-            _BestResult->DiametrIn = diametrIn;
+            *_BestResult = MakeBestResult(_WheelParams, _WheelProfileParams, params);
 
             _Meta->HasBestResult = true;
         }
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
+
 #include <glm/glm.hpp>
 
+#include "Math/Dual.h"
+
 namespace LM
 {
 
@@ -24,6 +28,8 @@ namespace LM
         float R1;
         float R2;
         float Angle;
+
+        bool operator==(const GrindingWheelParams&) const = default;
     };
 
     struct GrindingWheelProfileParams
@@ -31,6 +37,8 @@ namespace LM
         float OffsetToolCenter;
         float OffsetToolAxis;
         float RotationAngle;
+
+        bool operator==(const GrindingWheelProfileParams&) const = default;
     };
 
     struct ToolParams
@@ -38,6 +46,8 @@ namespace LM
         float Diametr;
         float Height;
         float Angle;
+
+        bool operator==(const ToolParams&) const = default;
     };
 
     template <typename T>
@@ -51,6 +61,8 @@ namespace LM
         T OffsetToolCenter;
         T OffsetToolAxis;
         T RotationAngle;
+
+        bool operator==(const GrindingWheelCalcTemplate&) const = default;
     };
 
     typedef GrindingWheelCalcTemplate<float> GrindingWheelCalcParams;
@@ -69,6 +81,8 @@ namespace LM
         float FrontAngle = 0.0f;
         float StepAngle = 0.0f;
         float DiametrIn = 0.0f;
+
+        bool operator==(const ParamsToFind&) const = default;
     };
 
     struct BestResult
@@ -100,17 +114,35 @@ namespace LM
         MoveOverToolAxisSingle Min;
     };
 
+    // Inputs of CalculateParamsJacobian: fields of GrindingWheelCalcParams in declaration order, then the tool angle
+    constexpr uint32_t kParamsJacobianToolAngle = 8;
+    constexpr uint32_t kParamsJacobianInputsCount = 9;
+
+    typedef Dual<kParamsJacobianInputsCount> ParamsDual;
+    typedef DualMat4<kParamsJacobianInputsCount> ParamsDualMat4;
+
+    // Params with their derivatives by the kParamsJacobianInputsCount inputs
+    struct ParamsJacobian
+    {
+        ParamsDual FrontAngle;
+        ParamsDual StepAngle;
+        ParamsDual DiametrIn;
+    };
+
     struct BestResultMeta
     {
-        int Calculated = 0;
-        int BadCalculations = 0;
+        int64_t Calculated = 0;
+        int64_t BadCalculations = 0;
 
-        bool HasBestResult;
+        bool HasBestResult = false;
     };
 
     glm::mat4 GetGrindingWheelMatrix(float _OffsetToolCenter, float _OffsetToolAxis, float _ToolAngle,
                                      float _RotatinOffset);
 
+    ParamsDualMat4 GetGrindingWheelMatrix(const ParamsDual& _OffsetToolCenter, const ParamsDual& _OffsetToolAxis,
+                                          const ParamsDual& _ToolAngle, const ParamsDual& _RotatinOffset);
+
     float MoveOverToolAxisRotationRadToOffset(float _RotationRad, float _ToolDiametr, float _ToolAngle);
     float MoveOverToolAxisOffsetToRotationRad(float _Offset, float _ToolDiametr, float _ToolAngle);
 
@@ -125,9 +157,41 @@ namespace LM
 
     ShapeParams CalculateGrindingWheelSizes(const GrindingWheelParams& _WheelParams);
 
+    // Distance in the xy plane from _Point to the wheel profile transformed by _Matrix: both side lines, both arcs
+    // and the line between them, without tessellation
+    float CalculateWheelToPointDistance(const ShapeParams& _ShapeParams, const GrindingWheelParams& _WheelParams,
+                                        const glm::mat4& _Matrix, const glm::vec2& _Point);
+
+    // Calculates front angle, step angle and inner diametr. Returns false if they can't be calculated
+    bool CalculateParamsSingle(const ShapeParams& _ShapeParams, const GrindingWheelParams& _WheelParams,
+                               const GrindingWheelProfileParams& _WheelProfileParams, const ToolParams& _ToolParams,
+                               ParamsToFind* _Result);
+
+    // Same as CalculateParamsSingle, but also differentiates the params by the wheel params and the tool angle with
+    // forward mode automatic differentiation, so the whole Jacobian takes one evaluation. Returns false if the params
+    // can't be calculated
+    bool CalculateParamsJacobian(const GrindingWheelCalcParams& _Values, const ToolParams& _ToolParams,
+                                 ParamsJacobian* _Result);
+
+    void UpdateNearestParamsToFind(const ParamsToFind& _Params, const ParamsToFind& _ParamsToFind,
+                                   ParamsToFind* _NearestParamsToFind);
+
+    float CalculateParamsDelta(const ParamsToFind& _Params, const ParamsToFind& _ParamsToFind);
+
+    BestResult MakeBestResult(const GrindingWheelParams& _WheelParams,
+                              const GrindingWheelProfileParams& _WheelProfileParams, const ParamsToFind& _Params);
+
+    GrindingWheelCalcParams GetBestResultValues(const BestResult& _Result);
+
     void CalculateBestResultSingle(const GrindingWheelParams& _WheelParams,
                                    const GrindingWheelProfileParams& _WheelProfileParams, const ToolParams& _ToolParams,
                                    const ParamsToFind& _ParamsToFind, ParamsToFind* _NearestParamsToFind,
                                    float* _LowestDelta, BestResult* _BestResult, BestResultMeta* _Meta);
 
+    // Same as above, but takes wheel sizes precalculated by CalculateGrindingWheelSizes(_WheelParams)
+    void CalculateBestResultSingle(const ShapeParams& _ShapeParams, const GrindingWheelParams& _WheelParams,
+                                   const GrindingWheelProfileParams& _WheelProfileParams, const ToolParams& _ToolParams,
+                                   const ParamsToFind& _ParamsToFind, ParamsToFind* _NearestParamsToFind,
+                                   float* _LowestDelta, BestResult* _BestResult, BestResultMeta* _Meta);
+
 }    // namespace LM
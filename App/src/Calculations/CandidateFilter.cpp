@@ -0,0 +1,217 @@
+#include "CandidateFilter.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <execution>
+#include <numeric>
+
+#include "Math/SimdOps.h"
+
+namespace LM
+{
+
+    // 64K candidates per task
+    constexpr size_t kFilterWordsPerChunk = 1024;
+
+    static_assert(64 % SimdOps::kWidth == 0);
+
+    static size_t GetWordsCount(size_t _Count) { return (_Count + 63) / 64; }
+
+    template <typename Function>
+    static void ForEachWordsChunk(size_t _WordsCount, Function _Function)
+    {
+        std::vector<size_t> chunkArr((_WordsCount + kFilterWordsPerChunk - 1) / kFilterWordsPerChunk);
+        std::iota(chunkArr.begin(), chunkArr.end(), 0);
+        std::for_each(std::execution::par, chunkArr.begin(), chunkArr.end(), [&](size_t _Chunk) {
+            size_t begin = _Chunk * kFilterWordsPerChunk;
+            _Function(_Chunk, begin, glm::min(begin + kFilterWordsPerChunk, _WordsCount));
+        });
+    }
+
+    void CandidateFilter::Build(const CandidateStore& _Store)
+    {
+        m_Count = _Store.GetSize();
+
+        std::vector<uint32_t> columnArr(kCandidateColumnsCount);
+        std::iota(columnArr.begin(), columnArr.end(), 0);
+        std::for_each(std::execution::par, columnArr.begin(), columnArr.end(), [&](uint32_t _Column) {
+            const std::vector<float>& values = _Store.Columns[_Column];
+            auto [min, max] = std::minmax_element(values.begin(), values.end());
+            m_Min[_Column] = values.empty() ? 0.0f : *min;
+            m_Max[_Column] = values.empty() ? 0.0f : *max;
+        });
+
+        for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+        {
+            m_Brushes[column] = {};
+            m_Bitmaps[column] = {};
+        }
+        UpdateSelection();
+    }
+
+    bool CandidateFilter::SetBrush(const CandidateStore& _Store, CandidateColumn _Column, const CandidateBrush& _Brush)
+    {
+        const uint32_t column = uint32_t(_Column);
+        if (m_Brushes[column] == _Brush)
+        {
+            return false;
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        m_Brushes[column] = _Brush;
+        if (_Brush.Active)
+        {
+            UpdateColumnBitmap(_Store, column);
+        }
+        else
+        {
+            m_Bitmaps[column] = {};
+        }
+        UpdateSelection();
+
+        m_FilterMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        return true;
+    }
+
+    void CandidateFilter::ClearBrushes()
+    {
+        if (!HasBrushes())
+        {
+            return;
+        }
+
+        for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+        {
+            m_Brushes[column] = {};
+            m_Bitmaps[column] = {};
+        }
+        UpdateSelection();
+    }
+
+    bool CandidateFilter::HasBrushes() const
+    {
+        return std::any_of(m_Brushes.begin(), m_Brushes.end(), [](const CandidateBrush& _Brush) {
+            return _Brush.Active;
+        });
+    }
+
+    void CandidateFilter::UpdateColumnBitmap(const CandidateStore& _Store, uint32_t _Column)
+    {
+        typedef SimdOps::Float Float;
+
+        const float* values = _Store.Columns[_Column].data();
+        const CandidateBrush& brush = m_Brushes[_Column];
+        std::vector<uint64_t>& bitmap = m_Bitmaps[_Column];
+        bitmap.resize(GetWordsCount(m_Count));
+
+        const Float min = SimdOps::Set(brush.Min);
+        const Float max = SimdOps::Set(brush.Max);
+
+        ForEachWordsChunk(bitmap.size(), [&](size_t, size_t _Begin, size_t _End) {
+            for (size_t word = _Begin; word < _End; word++)
+            {
+                const size_t begin = word * 64;
+                const size_t end = glm::min(begin + 64, m_Count);
+
+                uint64_t bits = 0;
+                if (end - begin == 64)
+                {
+                    for (size_t lane = 0; lane < 64; lane += SimdOps::kWidth)
+                    {
+                        Float value = SimdOps::Load(values + begin + lane);
+                        uint64_t mask = SimdOps::MoveMask(
+                            SimdOps::And(SimdOps::LessEqual(min, value), SimdOps::LessEqual(value, max)));
+                        bits |= mask << lane;
+                    }
+                }
+                else
+                {
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        bits |= uint64_t(brush.Min <= values[i] && values[i] <= brush.Max) << (i - begin);
+                    }
+                }
+                bitmap[word] = bits;
+            }
+        });
+    }
+
+    void CandidateFilter::UpdateSelection()
+    {
+        const size_t wordsCount = GetWordsCount(m_Count);
+        m_Selection.resize(wordsCount);
+
+        std::vector<const uint64_t*> bitmaps;
+        for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+        {
+            if (m_Brushes[column].Active)
+            {
+                bitmaps.push_back(m_Bitmaps[column].data());
+            }
+        }
+
+        std::vector<size_t> chunkCounts((wordsCount + kFilterWordsPerChunk - 1) / kFilterWordsPerChunk, 0);
+        ForEachWordsChunk(wordsCount, [&](size_t _Chunk, size_t _Begin, size_t _End) {
+            uint64_t* selection = m_Selection.data();
+            std::fill(selection + _Begin, selection + _End, ~uint64_t(0));
+            // One plain loop per bitmap, so the compiler vectorizes the AND
+            for (const uint64_t* bitmap : bitmaps)
+            {
+                for (size_t word = _Begin; word < _End; word++)
+                {
+                    selection[word] &= bitmap[word];
+                }
+            }
+            if (_End == wordsCount && m_Count % 64 != 0)
+            {
+                selection[wordsCount - 1] &= (uint64_t(1) << (m_Count % 64)) - 1;
+            }
+
+            size_t count = 0;
+            for (size_t word = _Begin; word < _End; word++)
+            {
+                count += std::popcount(selection[word]);
+            }
+            chunkCounts[_Chunk] = count;
+        });
+
+        m_SelectedCount = std::accumulate(chunkCounts.begin(), chunkCounts.end(), size_t(0));
+    }
+
+    void CandidateFilter::GetSelectedSample(size_t _MaxCount, std::vector<uint32_t>* _Indices) const
+    {
+        _Indices->clear();
+        const size_t count = glm::min(_MaxCount, m_SelectedCount);
+        if (count == 0)
+        {
+            return;
+        }
+        _Indices->reserve(count);
+
+        // Sample k is the selected candidate with rank k * m_SelectedCount / count
+        size_t sample = 0;
+        size_t rank = 0;
+        size_t passed = 0;
+        for (size_t word = 0; word < m_Selection.size() && sample < count; word++)
+        {
+            uint64_t bits = m_Selection[word];
+            size_t bitsCount = std::popcount(bits);
+            size_t skipped = 0;
+            while (sample < count && rank < passed + bitsCount)
+            {
+                for (; skipped < rank - passed; skipped++)
+                {
+                    bits &= bits - 1;
+                }
+                _Indices->push_back(uint32_t(word * 64 + std::countr_zero(bits)));
+
+                sample++;
+                rank = sample * m_SelectedCount / count;
+            }
+            passed += bitsCount;
+        }
+    }
+
+}    // namespace LM
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "CandidateStore.h"
+
+namespace LM
+{
+
+    // Range of one column, candidates outside of it are filtered out
+    struct CandidateBrush
+    {
+        bool Active = false;
+        float Min = 0.0f;
+        float Max = 0.0f;
+
+        bool operator==(const CandidateBrush&) const = default;
+    };
+
+    // Bitmap index of brushed candidates. Every brushed column has a bitmap with one bit per candidate, built with
+    // SimdOps compares, and the selection is the AND of all of them. A brush change rebuilds one column bitmap and the
+    // AND, so the cost is one pass over one column and over the bitmaps of the brushed columns
+    class CandidateFilter
+    {
+    public:
+        // Clears the brushes
+        void Build(const CandidateStore& _Store);
+
+        // Returns true if the brush was changed
+        bool SetBrush(const CandidateStore& _Store, CandidateColumn _Column, const CandidateBrush& _Brush);
+        void ClearBrushes();
+
+        const CandidateBrush& GetBrush(CandidateColumn _Column) const { return m_Brushes[uint32_t(_Column)]; }
+        bool HasBrushes() const;
+
+        size_t GetCount() const { return m_Count; }
+        float GetMin(CandidateColumn _Column) const { return m_Min[uint32_t(_Column)]; }
+        float GetMax(CandidateColumn _Column) const { return m_Max[uint32_t(_Column)]; }
+
+        size_t GetSelectedCount() const { return m_SelectedCount; }
+        bool IsSelected(size_t _Index) const { return (m_Selection[_Index / 64] >> (_Index % 64)) & 1; }
+        // Bit i of word i / 64 is candidate i
+        const std::vector<uint64_t>& GetSelection() const { return m_Selection; }
+
+        // Up to _MaxCount selected candidates spread evenly over the selection
+        void GetSelectedSample(size_t _MaxCount, std::vector<uint32_t>* _Indices) const;
+
+        // Time of the last brush change
+        double GetFilterMs() const { return m_FilterMs; }
+
+    protected:
+        void UpdateColumnBitmap(const CandidateStore& _Store, uint32_t _Column);
+        void UpdateSelection();
+
+    protected:
+        size_t m_Count = 0;
+        std::array<float, kCandidateColumnsCount> m_Min = {};
+        std::array<float, kCandidateColumnsCount> m_Max = {};
+
+        std::array<CandidateBrush, kCandidateColumnsCount> m_Brushes;
+        // Only brushed columns have bitmaps
+        std::array<std::vector<uint64_t>, kCandidateColumnsCount> m_Bitmaps;
+
+        std::vector<uint64_t> m_Selection;
+        size_t m_SelectedCount = 0;
+        double m_FilterMs = 0.0;
+    };
+
+}    // namespace LM
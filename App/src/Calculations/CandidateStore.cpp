@@ -0,0 +1,55 @@
+#include "CandidateStore.h"
+
+#include "Sweep.h"
+
+namespace LM
+{
+
+    const char* GetCandidateColumnName(CandidateColumn _Column)
+    {
+        if (uint32_t(_Column) < kSweepAxesCount)
+        {
+            return kSweepAxisNames[uint32_t(_Column)];
+        }
+
+        switch (_Column)
+        {
+            case CandidateColumn::FrontAngle: return "Front Angle";
+            case CandidateColumn::StepAngle: return "Step Angle";
+            case CandidateColumn::DiametrIn: return "Diametr In";
+            case CandidateColumn::Delta: return "Delta";
+            default: return "Unknown";
+        }
+    }
+
+    void CandidateStore::Add(const GrindingWheelCalcParams& _Values, const ParamsToFind& _Params, float _Delta)
+    {
+        if (IsFull())
+        {
+            return;
+        }
+
+        for (uint32_t axis = 0; axis < kSweepAxesCount; axis++)
+        {
+            Columns[axis].push_back(_Values.*kSweepAxes<float>[axis]);
+        }
+        Columns[uint32_t(CandidateColumn::FrontAngle)].push_back(_Params.FrontAngle);
+        Columns[uint32_t(CandidateColumn::StepAngle)].push_back(_Params.StepAngle);
+        Columns[uint32_t(CandidateColumn::DiametrIn)].push_back(_Params.DiametrIn);
+        Columns[uint32_t(CandidateColumn::Delta)].push_back(_Delta);
+    }
+
+    void CandidateStore::Append(const CandidateStore& _Other)
+    {
+        // Merged results start empty with no limit
+        Limit = glm::max(Limit, _Other.Limit);
+
+        size_t count = glm::min(_Other.GetSize(), Limit - glm::min(GetSize(), Limit));
+        for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+        {
+            Columns[column].insert(Columns[column].end(), _Other.Columns[column].begin(),
+                                   _Other.Columns[column].begin() + count);
+        }
+    }
+
+}    // namespace LM
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Calculations.h"
+
+namespace LM
+{
+
+    // Sweep axes in kSweepAxes order, then the calculated params and the delta
+    enum class CandidateColumn
+    {
+        Diametr = 0,
+        Width,
+        R1,
+        R2,
+        Angle,
+        OffsetToolCenter,
+        OffsetToolAxis,
+        RotationAngle,
+        FrontAngle,
+        StepAngle,
+        DiametrIn,
+        Delta,
+
+        Count
+    };
+
+    constexpr uint32_t kCandidateColumnsCount = uint32_t(CandidateColumn::Count);
+
+    const char* GetCandidateColumnName(CandidateColumn _Column);
+
+    // Every good calculation of a sweep in sweep order, one array per column. Keeps at most Limit candidates, so a
+    // sweep of any size takes bounded memory. Saved with shards, checkpoints and merged results
+    struct CandidateStore
+    {
+        size_t Limit = 0;
+        std::array<std::vector<float>, kCandidateColumnsCount> Columns;
+
+        size_t GetSize() const { return Columns[0].size(); }
+        bool IsFull() const { return GetSize() >= Limit; }
+
+        const std::vector<float>& GetColumn(CandidateColumn _Column) const { return Columns[uint32_t(_Column)]; }
+
+        void Add(const GrindingWheelCalcParams& _Values, const ParamsToFind& _Params, float _Delta);
+
+        // Appends candidates of _Other up to the higher limit of both stores
+        void Append(const CandidateStore& _Other);
+    };
+
+}    // namespace LM
@@ -0,0 +1,575 @@
+#include "DexelSimulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <execution>
+#include <limits>
+#include <numeric>
+
+#include "Engine/Utils/ConsoleLog.h"
+
+#include "Graphics/GraphicsUtils.h"
+#include "Math/Angle.h"
+#include "Math/Intersections.h"
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace LM
+{
+
+    constexpr uint32_t kBisectionSteps = 32;
+    // Part of the flute depth between the two points of the front face which give the front angle
+    constexpr float kFrontFaceDepth = 0.05f;
+
+    static void AddRange(double _Begin, double _End, double* _Min, double* _Max)
+    {
+        if (_Begin <= _End)
+        {
+            *_Min = glm::min(*_Min, _Begin);
+            *_Max = glm::max(*_Max, _End);
+        }
+    }
+
+    static glm::vec2 GetDirection(float _Angle) { return { glm::cos(_Angle), glm::sin(_Angle) }; }
+
+    static int64_t FloorMod(int64_t _Value, int64_t _Divisor)
+    {
+        int64_t result = _Value % _Divisor;
+        return result < 0 ? result + _Divisor : result;
+    }
+
+    DexelSimulationParams MakeDexelSimulationParams(const SweepJob& _Job, const BestResult& _Result)
+    {
+        DexelSimulationParams params;
+        params.Wheel = { _Result.Diametr, _Result.Width, _Result.R1, _Result.R2, _Result.Angle };
+        params.Profile = { _Result.OffsetToolCenter, _Result.OffsetToolAxis, _Result.RotationAngle };
+        params.Tool = _Job.Tool;
+        return params;
+    }
+
+    bool DexelSimulation::Run(const DexelSimulationParams& _Params)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        m_Params = _Params;
+        m_Material.clear();
+        m_RayOffsets.clear();
+        m_WheelIntervals.clear();
+        m_PosesCount = 0;
+        m_RemovedVolume = 0.0;
+
+        const uint32_t ringsCount = m_Params.RingsCount;
+        const uint32_t sectorsCount = m_Params.SectorsCount;
+        const ToolParams& tool = m_Params.Tool;
+        const GrindingWheelParams& wheel = m_Params.Wheel;
+
+        if (ringsCount == 0 || sectorsCount < 8 || m_Params.ProfileSections == 0)
+        {
+            LOGE("Dexel simulation needs at least 1 ring, 8 sectors and 1 profile section");
+            return false;
+        }
+        if (tool.Diametr <= 0.0f || tool.Height <= 0.0f || tool.Angle <= 0.0f || tool.Angle >= 90.0f)
+        {
+            LOGE("Dexel simulation needs a tool with positive sizes and angle in (0, 90)");
+            return false;
+        }
+
+        m_ToolRadius = tool.Diametr / 2.0f;
+        m_RingStep = m_ToolRadius / float(ringsCount);
+        m_SectorStep = glm::two_pi<float>() / float(sectorsCount);
+        m_Pitch = MoveOverToolAxisRotationRadToOffset(1.0f, tool.Diametr, tool.Angle);
+
+        // Periphery of the profile from R1Start to R2End, the segment between the arcs is the cone
+        ShapeParams shapeParams = CalculateGrindingWheelSizes(wheel);
+        std::vector<glm::vec4> profile;
+        AddCircleCurve({ 180.0f, 270.0f + wheel.Angle, wheel.R1, shapeParams.R1Center.x, shapeParams.R1Center.y },
+                       m_Params.ProfileSections, profile);
+        AddCircleCurve({ 270.0f + wheel.Angle, 360.0f, wheel.R2, shapeParams.R2Center.x, shapeParams.R2Center.y },
+                       m_Params.ProfileSections, profile);
+
+        m_WheelAxisY = shapeParams.LeftCenterPoint.y;
+        m_WheelMaxRadius = 0.0;
+        m_WheelProfile.clear();
+        for (const glm::vec4& point : profile)
+        {
+            double radius = m_WheelAxisY - double(point.y);
+            if (radius < 0.0 || (!m_WheelProfile.empty() && double(point.x) < m_WheelProfile.back().x))
+            {
+                LOGE("Dexel simulation needs a wheel profile with growing x and positive radius");
+                return false;
+            }
+            m_WheelProfile.emplace_back(point.x, radius);
+            m_WheelMaxRadius = glm::max(m_WheelMaxRadius, radius);
+        }
+
+        glm::mat4 wheelMatrix0 = GetGrindingWheelMatrix(m_Params.Profile.OffsetToolCenter,
+                                                        m_Params.Profile.OffsetToolAxis,
+                                                        m_Params.Profile.RotationAngle, 0.0f);
+        m_ToolToWheel = glm::inverse(wheelMatrix0);
+        m_RayDirection = glm::dvec3(glm::vec3(m_ToolToWheel * glm::vec4(0.0f, 0.0f, 1.0f, 0.0f)));
+
+        std::vector<uint32_t> ringArr(ringsCount);
+        std::iota(ringArr.begin(), ringArr.end(), 0);
+
+        // Wheel in pose 0 on every ray and the sectors where it is for every ring
+        m_WheelIntervals.resize(size_t(ringsCount) * sectorsCount);
+        std::vector<std::vector<uint32_t>> wheelSectors(ringsCount);
+        std::for_each(std::execution::par, ringArr.begin(), ringArr.end(), [&](uint32_t _Ring) {
+            for (uint32_t sector = 0; sector < sectorsCount; sector++)
+            {
+                DexelInterval& interval = m_WheelIntervals[size_t(_Ring) * sectorsCount + sector];
+                if (IntersectWheel(GetRingRadius(_Ring) * GetDirection(GetSectorAngle(sector)), &interval))
+                {
+                    wheelSectors[_Ring].push_back(sector);
+                }
+            }
+        });
+
+        float wheelMinZ = std::numeric_limits<float>::max();
+        float wheelMaxZ = std::numeric_limits<float>::lowest();
+        for (const DexelInterval& interval : m_WheelIntervals)
+        {
+            if (interval.Begin <= interval.End)
+            {
+                wheelMinZ = glm::min(wheelMinZ, interval.Begin);
+                wheelMaxZ = glm::max(wheelMaxZ, interval.End);
+            }
+        }
+        if (wheelMinZ > wheelMaxZ)
+        {
+            LOGW("Dexel simulation: the wheel doesn't touch the tool");
+            return false;
+        }
+
+        // Points between the rays may reach a bit further than the rays
+        float wheelMargin = 0.05f * (wheelMaxZ - wheelMinZ) + m_RingStep;
+        m_WheelMinZ = wheelMinZ - wheelMargin;
+        m_WheelMaxZ = wheelMaxZ + wheelMargin;
+
+        // Poses from the wheel below the blank to the wheel above it
+        const float blankBegin = -tool.Height / 2.0f;
+        const float blankEnd = tool.Height / 2.0f;
+        const float poseOffset = m_Pitch * m_SectorStep;
+        m_FirstPose = int64_t(glm::floor((blankBegin - m_WheelMaxZ) / poseOffset));
+        int64_t lastPose = int64_t(glm::ceil((blankEnd - m_WheelMinZ) / poseOffset));
+        m_PosesCount = uint32_t(lastPose - m_FirstPose + 1);
+
+        std::vector<std::vector<DexelInterval>> ringMaterial(ringsCount);
+        std::vector<std::vector<uint32_t>> ringCounts(ringsCount);
+        std::vector<double> ringRemoved(ringsCount, 0.0);
+
+        std::for_each(std::execution::par, ringArr.begin(), ringArr.end(), [&](uint32_t _Ring) {
+            std::vector<DexelInterval>& material = ringMaterial[_Ring];
+            std::vector<uint32_t>& counts = ringCounts[_Ring];
+            counts.resize(sectorsCount);
+
+            std::vector<DexelInterval> removed;
+            double removedLength = 0.0;
+
+            for (uint32_t sector = 0; sector < sectorsCount; sector++)
+            {
+                // Pose P moves the wheel interval of sector (sector - P) onto this ray
+                removed.clear();
+                for (uint32_t wheelSector : wheelSectors[_Ring])
+                {
+                    const DexelInterval& interval = m_WheelIntervals[size_t(_Ring) * sectorsCount + wheelSector];
+                    int64_t pose = m_FirstPose + FloorMod(int64_t(sector) - int64_t(wheelSector) - m_FirstPose,
+                                                          int64_t(sectorsCount));
+                    for (; pose <= lastPose; pose += sectorsCount)
+                    {
+                        float offset = float(double(pose) * poseOffset);
+                        float begin = glm::max(interval.Begin + offset, blankBegin);
+                        float end = glm::min(interval.End + offset, blankEnd);
+                        if (begin < end)
+                        {
+                            removed.push_back({ begin, end });
+                        }
+                    }
+                }
+
+                std::sort(removed.begin(), removed.end(),
+                          [](const DexelInterval& _Lhs, const DexelInterval& _Rhs) { return _Lhs.Begin < _Rhs.Begin; });
+
+                // Blank minus the union of the removed intervals
+                size_t first = material.size();
+                float begin = blankBegin;
+                for (const DexelInterval& interval : removed)
+                {
+                    if (interval.Begin > begin)
+                    {
+                        material.push_back({ begin, interval.Begin });
+                    }
+                    begin = glm::max(begin, interval.End);
+                }
+                if (begin < blankEnd)
+                {
+                    material.push_back({ begin, blankEnd });
+                }
+
+                counts[sector] = uint32_t(material.size() - first);
+                removedLength += tool.Height;
+                for (size_t i = first; i < material.size(); i++)
+                {
+                    removedLength -= material[i].End - material[i].Begin;
+                }
+            }
+
+            // Every ray stands for a ring sector of the blank
+            ringRemoved[_Ring] = removedLength * double(m_RingStep) * double(GetRingRadius(_Ring)) * m_SectorStep;
+        });
+
+        m_RayOffsets.reserve(size_t(ringsCount) * sectorsCount + 1);
+        m_RayOffsets.push_back(0);
+        for (uint32_t ring = 0; ring < ringsCount; ring++)
+        {
+            m_Material.insert(m_Material.end(), ringMaterial[ring].begin(), ringMaterial[ring].end());
+            for (uint32_t count : ringCounts[ring])
+            {
+                m_RayOffsets.push_back(m_RayOffsets.back() + count);
+            }
+            m_RemovedVolume += ringRemoved[ring];
+        }
+
+        auto endTime = std::chrono::steady_clock::now();
+        m_CalculationMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        return true;
+    }
+
+    bool DexelSimulation::IntersectWheel(glm::vec2 _Point, DexelInterval* _Interval) const
+    {
+        _Interval->Begin = 1.0f;
+        _Interval->End = -1.0f;
+
+        const glm::dvec3 origin = glm::dvec3(glm::vec3(m_ToolToWheel * glm::vec4(_Point, 0.0f, 1.0f)));
+        const glm::dvec3& direction = m_RayDirection;
+        const double originY = origin.y - m_WheelAxisY;
+        const bool isAcross = glm::abs(direction.x) > 1e-12;
+
+        // Squared distance to the wheel axis is a * t^2 + b * t + c
+        const double a = direction.y * direction.y + direction.z * direction.z;
+        const double b = 2.0 * (originY * direction.y + origin.z * direction.z);
+        const double c = originY * originY + origin.z * origin.z;
+
+        // Bounding cylinder of the wheel first, most rays miss it
+        double rangeBegin = -std::numeric_limits<double>::infinity();
+        double rangeEnd = std::numeric_limits<double>::infinity();
+        if (isAcross)
+        {
+            rangeBegin = (m_WheelProfile.front().x - origin.x) / direction.x;
+            rangeEnd = (m_WheelProfile.back().x - origin.x) / direction.x;
+            if (rangeBegin > rangeEnd)
+            {
+                std::swap(rangeBegin, rangeEnd);
+            }
+        }
+        else if (origin.x < m_WheelProfile.front().x || origin.x > m_WheelProfile.back().x)
+        {
+            return false;
+        }
+        double nearest = a > 0.0 ? glm::clamp(-b / (2.0 * a), rangeBegin, rangeEnd) : rangeBegin;
+        if (a * nearest * nearest + b * nearest + c > m_WheelMaxRadius * m_WheelMaxRadius)
+        {
+            return false;
+        }
+
+        // The wheel is convex, so the intervals of all cone segments make one interval
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        for (size_t i = 0; i + 1 < m_WheelProfile.size(); i++)
+        {
+            const glm::dvec2& p0 = m_WheelProfile[i];
+            const glm::dvec2& p1 = m_WheelProfile[i + 1];
+            if (p1.x <= p0.x)
+            {
+                continue;
+            }
+
+            double t0 = rangeBegin;
+            double t1 = rangeEnd;
+            if (isAcross)
+            {
+                t0 = (p0.x - origin.x) / direction.x;
+                t1 = (p1.x - origin.x) / direction.x;
+                if (t0 > t1)
+                {
+                    std::swap(t0, t1);
+                }
+            }
+            else if (origin.x < p0.x || origin.x > p1.x)
+            {
+                continue;
+            }
+
+            // Cone radius on the line is alpha + beta * t, it isn't negative inside of the segment, so the squared
+            // inequality has no extra roots there
+            double slope = (p1.y - p0.y) / (p1.x - p0.x);
+            double alpha = p0.y + slope * (origin.x - p0.x);
+            double beta = slope * direction.x;
+
+            double qa = a - beta * beta;
+            double qb = b - 2.0 * alpha * beta;
+            double qc = c - alpha * alpha;
+
+            if (glm::abs(qa) < 1e-12)
+            {
+                if (glm::abs(qb) < 1e-12)
+                {
+                    if (qc <= 0.0)
+                    {
+                        AddRange(t0, t1, &min, &max);
+                    }
+                }
+                else if (qb > 0.0)
+                {
+                    AddRange(t0, glm::min(t1, -qc / qb), &min, &max);
+                }
+                else
+                {
+                    AddRange(glm::max(t0, -qc / qb), t1, &min, &max);
+                }
+                continue;
+            }
+
+            double discriminant = qb * qb - 4.0 * qa * qc;
+            if (discriminant < 0.0)
+            {
+                if (qa < 0.0)
+                {
+                    AddRange(t0, t1, &min, &max);
+                }
+                continue;
+            }
+
+            double root = glm::sqrt(discriminant);
+            double root0 = (-qb - root) / (2.0 * qa);
+            double root1 = (-qb + root) / (2.0 * qa);
+            if (root0 > root1)
+            {
+                std::swap(root0, root1);
+            }
+
+            if (qa > 0.0)
+            {
+                AddRange(glm::max(t0, root0), glm::min(t1, root1), &min, &max);
+            }
+            else
+            {
+                AddRange(t0, glm::min(t1, root0), &min, &max);
+                AddRange(glm::max(t0, root1), t1, &min, &max);
+            }
+        }
+
+        if (min > max)
+        {
+            return false;
+        }
+
+        // Ray direction is the tool axis, so t is z
+        _Interval->Begin = float(min);
+        _Interval->End = float(max);
+        return true;
+    }
+
+    bool DexelSimulation::IsRemoved(glm::vec2 _Point, float _Z) const
+    {
+        const double poseOffset = double(m_Pitch) * double(m_SectorStep);
+        int64_t firstPose = glm::max(m_FirstPose, int64_t(glm::ceil((_Z - m_WheelMaxZ) / poseOffset)));
+        int64_t lastPose =
+            glm::min(m_FirstPose + int64_t(m_PosesCount) - 1, int64_t(glm::floor((_Z - m_WheelMinZ) / poseOffset)));
+
+        DexelInterval interval;
+        for (int64_t pose = firstPose; pose <= lastPose; pose++)
+        {
+            // Point in the coordinates of pose 0
+            double angle = double(pose) * double(m_SectorStep);
+            float cos = float(glm::cos(angle));
+            float sin = float(glm::sin(angle));
+            glm::vec2 point = { cos * _Point.x + sin * _Point.y, -sin * _Point.x + cos * _Point.y };
+
+            float z = float(double(_Z) - double(pose) * poseOffset);
+            if (IntersectWheel(point, &interval) && z >= interval.Begin && z <= interval.End)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const DexelInterval* DexelSimulation::GetIntervals(uint32_t _Ring, uint32_t _Sector, uint32_t* _Count) const
+    {
+        size_t ray = size_t(_Ring) * m_Params.SectorsCount + _Sector;
+        *_Count = m_RayOffsets[ray + 1] - m_RayOffsets[ray];
+        return m_Material.data() + m_RayOffsets[ray];
+    }
+
+    bool DexelSimulation::IsMaterial(uint32_t _Ring, uint32_t _Sector, float _Z) const
+    {
+        uint32_t count = 0;
+        const DexelInterval* intervals = GetIntervals(_Ring, _Sector, &count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (_Z >= intervals[i].Begin && _Z <= intervals[i].End)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    float DexelSimulation::FindBorderAngle(float _Radius, float _Angle, float _MaterialSide, float _Z) const
+    {
+        auto isRemoved = [&](float _Value) { return IsRemoved(_Radius * GetDirection(_Value), _Z); };
+
+        // Dexels give the border on the ring radius only, so the bracket is searched sector by sector first
+        const uint32_t maxSteps = m_Params.SectorsCount / 4;
+        float removedAngle = _Angle;
+        float materialAngle = _Angle;
+        if (isRemoved(_Angle))
+        {
+            uint32_t step = 0;
+            do
+            {
+                materialAngle += _MaterialSide * m_SectorStep;
+            } while (isRemoved(materialAngle) && ++step < maxSteps);
+            if (step == maxSteps)
+            {
+                return std::numeric_limits<float>::quiet_NaN();
+            }
+            removedAngle = materialAngle - _MaterialSide * m_SectorStep;
+        }
+        else
+        {
+            uint32_t step = 0;
+            do
+            {
+                removedAngle -= _MaterialSide * m_SectorStep;
+            } while (!isRemoved(removedAngle) && ++step < maxSteps);
+            if (step == maxSteps)
+            {
+                return std::numeric_limits<float>::quiet_NaN();
+            }
+            materialAngle = removedAngle + _MaterialSide * m_SectorStep;
+        }
+
+        for (uint32_t i = 0; i < kBisectionSteps; i++)
+        {
+            float middle = (removedAngle + materialAngle) / 2.0f;
+            (isRemoved(middle) ? removedAngle : materialAngle) = middle;
+        }
+        return (removedAngle + materialAngle) / 2.0f;
+    }
+
+    bool DexelSimulation::CalculateParams(float _Z, ParamsToFind* _Result) const
+    {
+        const uint32_t ringsCount = m_Params.RingsCount;
+        const uint32_t sectorsCount = m_Params.SectorsCount;
+        if (m_RayOffsets.empty())
+        {
+            return false;
+        }
+
+        // First removed ring from the center for every sector
+        std::vector<uint32_t> borderRings(sectorsCount, ringsCount);
+        uint32_t minBorderRing = ringsCount;
+        for (uint32_t sector = 0; sector < sectorsCount; sector++)
+        {
+            for (uint32_t ring = 0; ring < ringsCount; ring++)
+            {
+                if (!IsMaterial(ring, sector, _Z))
+                {
+                    borderRings[sector] = ring;
+                    minBorderRing = glm::min(minBorderRing, ring);
+                    break;
+                }
+            }
+        }
+
+        // The flute is the longest run of removed sectors on the outer ring
+        uint32_t runStart = 0;
+        uint32_t runLength = 0;
+        for (uint32_t sector = 0, length = 0; sector < 2 * sectorsCount; sector++)
+        {
+            length = IsMaterial(ringsCount - 1, sector % sectorsCount, _Z) ? 0 : length + 1;
+            if (length > runLength && length <= sectorsCount)
+            {
+                runLength = length;
+                runStart = (sector + 1 - length) % sectorsCount;
+            }
+        }
+        if (runLength == 0 || runLength == sectorsCount)
+        {
+            LOGW("Dexel simulation: no flute in the cross section at z = ", _Z);
+            return false;
+        }
+
+        // Inner diametr from the sectors near the deepest dexel
+        std::vector<uint32_t> coreSectors;
+        for (uint32_t sector = 0; sector < sectorsCount; sector++)
+        {
+            if (borderRings[sector] <= minBorderRing + 1)
+            {
+                coreSectors.push_back(sector);
+            }
+        }
+        std::vector<float> coreRadii(coreSectors.size());
+        std::transform(std::execution::par, coreSectors.begin(), coreSectors.end(), coreRadii.begin(),
+                       [&](uint32_t _Sector) {
+                           uint32_t ring = borderRings[_Sector];
+                           glm::vec2 direction = GetDirection(GetSectorAngle(_Sector));
+                           float materialRadius = ring > 0 ? GetRingRadius(ring - 1) : 0.0f;
+                           float removedRadius = GetRingRadius(ring);
+                           for (uint32_t i = 0; i < kBisectionSteps; i++)
+                           {
+                               float middle = (materialRadius + removedRadius) / 2.0f;
+                               (IsRemoved(middle * direction, _Z) ? removedRadius : materialRadius) = middle;
+                           }
+                           return (materialRadius + removedRadius) / 2.0f;
+                       });
+        float coreRadius = *std::min_element(coreRadii.begin(), coreRadii.end());
+
+        // Flute borders on the tool circle, the front one is where CalculateParamsSingle puts the side of the wheel
+        float startAngle = FindBorderAngle(m_ToolRadius, GetSectorAngle(runStart), -1.0f, _Z);
+        float endAngle =
+            FindBorderAngle(m_ToolRadius, GetSectorAngle((runStart + runLength - 1) % sectorsCount), 1.0f, _Z);
+        if (glm::isnan(startAngle) || glm::isnan(endAngle))
+        {
+            return false;
+        }
+
+        ShapeParams shapeParams = CalculateGrindingWheelSizes(m_Params.Wheel);
+        glm::mat4 wheelMatrix0 = glm::inverse(m_ToolToWheel);
+        glm::vec2 leftOnTool = LineCircleIntersection(m_ToolRadius, wheelMatrix0 * shapeParams.LeftCenterPoint,
+                                                      wheelMatrix0 * shapeParams.R1Start);
+        float leftAngle = glm::atan(leftOnTool.y, leftOnTool.x);
+
+        auto angleDistance = [](float _Lhs, float _Rhs) {
+            float delta = glm::mod(_Lhs - _Rhs, glm::two_pi<float>());
+            return glm::min(delta, glm::two_pi<float>() - delta);
+        };
+        bool isFrontStart = angleDistance(startAngle, leftAngle) <= angleDistance(endAngle, leftAngle);
+        float frontAngle = isFrontStart ? startAngle : endAngle;
+
+        float faceRadius = m_ToolRadius - kFrontFaceDepth * (m_ToolRadius - coreRadius);
+        float faceAngle = FindBorderAngle(faceRadius, frontAngle, isFrontStart ? -1.0f : 1.0f, _Z);
+        if (glm::isnan(faceAngle))
+        {
+            return false;
+        }
+
+        glm::vec2 frontOnTool = m_ToolRadius * GetDirection(frontAngle);
+        glm::vec2 frontOnFace = faceRadius * GetDirection(faceAngle);
+
+        _Result->FrontAngle =
+            CalcAngle(glm::vec4(-frontOnTool, 0.0f, 1.0f), glm::vec4(frontOnFace - frontOnTool, 0.0f, 1.0f));
+        // Angle between the borders as seen from the tool center, in [0, 180] as in CalculateParamsSingle, not the
+        // angular width of the flute
+        _Result->StepAngle = CalcAngle(glm::vec4(GetDirection(endAngle), 0.0f, 1.0f),
+                                       glm::vec4(GetDirection(startAngle), 0.0f, 1.0f));
+        _Result->DiametrIn = 2.0f * coreRadius;
+
+        return !glm::isnan(_Result->FrontAngle);
+    }
+
+}    // namespace LM
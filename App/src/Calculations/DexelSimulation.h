@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Calculations.h"
+#include "SweepRunner.h"
+
+#include <glm/glm.hpp>
+
+namespace LM
+{
+
+    struct DexelSimulationParams
+    {
+        GrindingWheelParams Wheel = {};
+        GrindingWheelProfileParams Profile = {};
+        ToolParams Tool = {};
+
+        // Dexel rays are parallel to the tool axis on a polar grid of RingsCount radii and SectorsCount angles.
+        // Wheel poses are taken every sector angle along the helix
+        uint32_t RingsCount = 128;
+        uint32_t SectorsCount = 2048;
+        // Segments of every rounded corner of the wheel profile
+        uint32_t ProfileSections = 32;
+    };
+
+    // Simulation of _Result with the tool of _Job, the sweep it was calculated by
+    DexelSimulationParams MakeDexelSimulationParams(const SweepJob& _Job, const BestResult& _Result);
+
+    // Material on a dexel ray from Begin to End along the tool axis
+    struct DexelInterval
+    {
+        float Begin = 0.0f;
+        float End = 0.0f;
+    };
+
+    // 3D material removal of one flute. The tool blank (Diametr x Height, z = 0 in the middle) is a set of dexels and
+    // the wheel is swept along the helix of the tool angle over the whole height. The wheel is a solid of revolution,
+    // so its interval on a ray is found analytically for every cone segment of the profile.
+    //
+    // A pose rotated by the sector angle is the same as the ray rotated back by one sector, so the wheel is
+    // intersected with the rays only once (pose 0) and every other pose is a lookup with a z shift. Rays are
+    // processed in parallel
+    class DexelSimulation
+    {
+    public:
+        // Returns false if the params can't be simulated or the wheel doesn't touch the blank
+        bool Run(const DexelSimulationParams& _Params);
+
+        // Front angle, step angle and inner diametr of the cross section at _Z measured on the simulated flute,
+        // same definitions as in CalculateParamsSingle. Borders are refined with IsRemoved between dexels.
+        // Returns false if there is no flute in the cross section
+        bool CalculateParams(float _Z, ParamsToFind* _Result) const;
+
+        // Tests a point of the cross section at _Z against the same wheel poses which were used for the dexels
+        bool IsRemoved(glm::vec2 _Point, float _Z) const;
+        bool IsMaterial(uint32_t _Ring, uint32_t _Sector, float _Z) const;
+
+        const DexelInterval* GetIntervals(uint32_t _Ring, uint32_t _Sector, uint32_t* _Count) const;
+
+        uint32_t GetRingsCount() const { return m_Params.RingsCount; }
+        uint32_t GetSectorsCount() const { return m_Params.SectorsCount; }
+        float GetRingRadius(uint32_t _Ring) const { return (float(_Ring) + 0.5f) * m_RingStep; }
+        float GetSectorAngle(uint32_t _Sector) const { return float(_Sector) * m_SectorStep; }
+
+        uint32_t GetPosesCount() const { return m_PosesCount; }
+        double GetRemovedVolume() const { return m_RemovedVolume; }
+        double GetCalculationMs() const { return m_CalculationMs; }
+
+    protected:
+        // Interval of the wheel in pose 0 on the line parallel to the tool axis through _Point
+        bool IntersectWheel(glm::vec2 _Point, DexelInterval* _Interval) const;
+
+        // Border of the flute on the circle of _Radius near _Angle, _MaterialSide is the sign of the angle direction
+        // where the material is. Returns NaN if the border isn't found
+        float FindBorderAngle(float _Radius, float _Angle, float _MaterialSide, float _Z) const;
+
+    protected:
+        DexelSimulationParams m_Params;
+
+        float m_ToolRadius = 0.0f;
+        float m_RingStep = 0.0f;
+        float m_SectorStep = 0.0f;
+
+        // Offset along the tool axis for one radian of rotation
+        float m_Pitch = 0.0f;
+        int64_t m_FirstPose = 0;
+        uint32_t m_PosesCount = 0;
+
+        // Wheel in its local coordinates: profile points (position along the wheel axis, radius), the axis is the line
+        // y = m_WheelAxisY, z = 0
+        std::vector<glm::dvec2> m_WheelProfile;
+        double m_WheelAxisY = 0.0;
+        double m_WheelMaxRadius = 0.0;
+        glm::mat4 m_ToolToWheel = glm::mat4(1.0f);
+        glm::dvec3 m_RayDirection = glm::dvec3(0.0);
+
+        // Interval of the wheel in pose 0 on every ray, Begin > End if the ray misses it
+        std::vector<DexelInterval> m_WheelIntervals;
+        float m_WheelMinZ = 0.0f;
+        float m_WheelMaxZ = 0.0f;
+
+        // Material intervals of ray (ring * SectorsCount + sector) are from m_RayOffsets[ray] to m_RayOffsets[ray + 1]
+        std::vector<uint32_t> m_RayOffsets;
+        std::vector<DexelInterval> m_Material;
+
+        double m_RemovedVolume = 0.0;
+        double m_CalculationMs = 0.0;
+    };
+
+}    // namespace LM
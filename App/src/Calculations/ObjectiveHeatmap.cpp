@@ -0,0 +1,275 @@
+#include "ObjectiveHeatmap.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <execution>
+#include <limits>
+#include <numeric>
+
+#include "Sweep.h"
+
+namespace LM
+{
+
+    constexpr uint32_t kHeatmapCoarseResolution = 16;
+    // Tile side in cells of the level. The coarse level is one tile, so it is published at once
+    constexpr uint32_t kHeatmapTileSize = 16;
+
+    constexpr float kNaN = std::numeric_limits<float>::quiet_NaN();
+
+    const char* GetHeatmapOutputName(HeatmapOutput _Output)
+    {
+        switch (_Output)
+        {
+            case HeatmapOutput::Delta: return "Delta";
+            case HeatmapOutput::FrontAngle: return "Front Angle";
+            case HeatmapOutput::StepAngle: return "Step Angle";
+            case HeatmapOutput::DiametrIn: return "Diametr In";
+            default: return "Unknown";
+        }
+    }
+
+    float CalculateHeatmapCell(const ObjectiveHeatmapParams& _Params, uint32_t _X, uint32_t _Y)
+    {
+        GrindingWheelCalcParams values = _Params.Center;
+        values.*kSweepAxes<float>[_Params.AxisX] =
+            glm::mix(_Params.MinX, _Params.MaxX, (float(_X) + 0.5f) / float(_Params.Resolution));
+        values.*kSweepAxes<float>[_Params.AxisY] =
+            glm::mix(_Params.MinY, _Params.MaxY, (float(_Y) + 0.5f) / float(_Params.Resolution));
+
+        GrindingWheelParams wheelParams = { values.Diametr, values.Width, values.R1, values.R2, values.Angle };
+        GrindingWheelProfileParams profileParams = { values.OffsetToolCenter, values.OffsetToolAxis,
+                                                     values.RotationAngle };
+
+        ParamsToFind calculated;
+        if (!CalculateParamsSingle(CalculateGrindingWheelSizes(wheelParams), wheelParams, profileParams, _Params.Tool,
+                                   &calculated))
+        {
+            return kNaN;
+        }
+
+        switch (_Params.Output)
+        {
+            case HeatmapOutput::Delta: return CalculateParamsDelta(calculated, _Params.ToFind);
+            case HeatmapOutput::FrontAngle: return calculated.FrontAngle;
+            case HeatmapOutput::StepAngle: return calculated.StepAngle;
+            case HeatmapOutput::DiametrIn: return calculated.DiametrIn;
+            default: return kNaN;
+        }
+    }
+
+    ObjectiveHeatmap::~ObjectiveHeatmap()
+    {
+        if (m_Future.valid())
+        {
+            m_Cancel = true;
+            m_Future.wait();
+        }
+    }
+
+    bool ObjectiveHeatmap::Update(const ObjectiveHeatmapParams& _Params)
+    {
+        ObjectiveHeatmapParams params = _Params;
+        params.Resolution = std::bit_ceil(glm::max(params.Resolution, 1u));
+        bool paramsChanged = !m_HasParams || !(params == m_Params);
+
+        if (m_Future.valid())
+        {
+            if (paramsChanged)
+            {
+                m_Cancel = true;
+            }
+            if (m_Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                m_Future.get();
+                // Cancelled values are incomplete even if the params are changed back
+                paramsChanged = paramsChanged || m_Cancel;
+            }
+        }
+
+        if (!m_Future.valid() && paramsChanged)
+        {
+            Start(params);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_SharedVersion == m_Version)
+            {
+                return false;
+            }
+
+            m_Values = m_SharedValues;
+            m_Version = m_SharedVersion;
+            m_Progress = float(double(m_SharedCalculated) / double(m_Values.size()));
+            m_CalculationMs = m_SharedCalculationMs;
+        }
+
+        m_Min = std::numeric_limits<float>::max();
+        m_Max = std::numeric_limits<float>::lowest();
+        for (float value : m_Values)
+        {
+            if (!std::isnan(value))
+            {
+                m_Min = glm::min(m_Min, value);
+                m_Max = glm::max(m_Max, value);
+            }
+        }
+        if (m_Min > m_Max)
+        {
+            m_Min = 0.0f;
+            m_Max = 0.0f;
+        }
+        m_DisplayDirty = true;
+
+        return true;
+    }
+
+    void ObjectiveHeatmap::Start(const ObjectiveHeatmapParams& _Params)
+    {
+        m_HasParams = true;
+        m_Params = _Params;
+        m_Cancel = false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_SharedValues.assign(size_t(_Params.Resolution) * _Params.Resolution, kNaN);
+            m_SharedVersion++;
+            m_SharedCalculated = 0;
+            m_SharedCalculationMs = 0.0;
+        }
+
+        m_Future = std::async(std::launch::async, [this, _Params]() { Run(_Params); });
+    }
+
+    void ObjectiveHeatmap::Run(const ObjectiveHeatmapParams& _Params)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        const uint32_t resolution = _Params.Resolution;
+        const uint32_t coarseStep = resolution / glm::min(kHeatmapCoarseResolution, resolution);
+
+        for (uint32_t step = coarseStep; step > 0; step /= 2)
+        {
+            const uint32_t cellsCount = resolution / step;
+            const uint32_t tilesPerSide = (cellsCount + kHeatmapTileSize - 1) / kHeatmapTileSize;
+            // Cells with both even indices are cells of the previous level
+            auto isCalculated = [&](uint32_t _X, uint32_t _Y) {
+                return step != coarseStep && _X % 2 == 0 && _Y % 2 == 0;
+            };
+
+            std::vector<uint32_t> tileArr(size_t(tilesPerSide) * tilesPerSide);
+            std::iota(tileArr.begin(), tileArr.end(), 0);
+
+            auto runTile = [&](uint32_t _Tile) {
+                if (m_Cancel)
+                {
+                    return;
+                }
+
+                const uint32_t beginX = (_Tile % tilesPerSide) * kHeatmapTileSize;
+                const uint32_t beginY = (_Tile / tilesPerSide) * kHeatmapTileSize;
+                const uint32_t endX = glm::min(beginX + kHeatmapTileSize, cellsCount);
+                const uint32_t endY = glm::min(beginY + kHeatmapTileSize, cellsCount);
+
+                float tileValues[kHeatmapTileSize * kHeatmapTileSize] = {};
+                uint64_t calculated = 0;
+                for (uint32_t y = beginY; y < endY; y++)
+                {
+                    for (uint32_t x = beginX; x < endX; x++)
+                    {
+                        if (!isCalculated(x, y))
+                        {
+                            tileValues[(y - beginY) * kHeatmapTileSize + (x - beginX)] =
+                                CalculateHeatmapCell(_Params, x * step, y * step);
+                            calculated++;
+                        }
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                for (uint32_t y = beginY; y < endY; y++)
+                {
+                    for (uint32_t x = beginX; x < endX; x++)
+                    {
+                        if (isCalculated(x, y))
+                        {
+                            continue;
+                        }
+
+                        float value = tileValues[(y - beginY) * kHeatmapTileSize + (x - beginX)];
+                        for (uint32_t row = y * step; row < (y + 1) * step; row++)
+                        {
+                            float* rowValues = m_SharedValues.data() + size_t(row) * resolution;
+                            std::fill(rowValues + x * step, rowValues + (x + 1) * step, value);
+                        }
+                    }
+                }
+                m_SharedVersion++;
+                m_SharedCalculated += calculated;
+                m_SharedCalculationMs =
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+                if (m_OnUpdated)
+                {
+                    m_OnUpdated();
+                }
+            };
+
+            std::for_each(std::execution::par, tileArr.begin(), tileArr.end(), runTile);
+
+            if (m_Cancel)
+            {
+                return;
+            }
+        }
+    }
+
+    const std::vector<float>& ObjectiveHeatmap::GetDisplayValues(uint32_t _MaxResolution, uint32_t* _Resolution)
+    {
+        uint32_t resolution = m_Values.empty() ? 0 : m_Params.Resolution;
+        while (resolution > glm::max(_MaxResolution, 1u))
+        {
+            resolution /= 2;
+        }
+
+        if (m_DisplayDirty || resolution != m_DisplayResolution)
+        {
+            m_DisplayDirty = false;
+            m_DisplayResolution = resolution;
+            m_DisplayValues.assign(size_t(resolution) * resolution, m_Max);
+
+            const uint32_t blockSize = resolution > 0 ? m_Params.Resolution / resolution : 0;
+            for (uint32_t y = 0; y < resolution; y++)
+            {
+                for (uint32_t x = 0; x < resolution; x++)
+                {
+                    double sum = 0.0;
+                    uint32_t count = 0;
+                    for (uint32_t row = y * blockSize; row < (y + 1) * blockSize; row++)
+                    {
+                        const float* rowValues = m_Values.data() + size_t(row) * m_Params.Resolution;
+                        for (uint32_t column = x * blockSize; column < (x + 1) * blockSize; column++)
+                        {
+                            if (!std::isnan(rowValues[column]))
+                            {
+                                sum += rowValues[column];
+                                count++;
+                            }
+                        }
+                    }
+                    if (count > 0)
+                    {
+                        m_DisplayValues[size_t(resolution - 1 - y) * resolution + x] = float(sum / count);
+                    }
+                }
+            }
+        }
+
+        *_Resolution = m_DisplayResolution;
+        return m_DisplayValues;
+    }
+
+}    // namespace LM
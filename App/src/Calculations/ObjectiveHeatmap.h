@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include "Calculations.h"
+
+namespace LM
+{
+
+    enum class HeatmapOutput
+    {
+        Delta = 0,
+        FrontAngle,
+        StepAngle,
+        DiametrIn,
+
+        Count
+    };
+
+    const char* GetHeatmapOutputName(HeatmapOutput _Output);
+
+    struct ObjectiveHeatmapParams
+    {
+        // Values of all axes besides AxisX and AxisY
+        GrindingWheelCalcParams Center = {};
+        ToolParams Tool = {};
+        ParamsToFind ToFind;
+
+        // Indices in kSweepAxes
+        uint32_t AxisX = 5;
+        uint32_t AxisY = 7;
+        float MinX = 0.0f;
+        float MaxX = 0.0f;
+        float MinY = 0.0f;
+        float MaxY = 0.0f;
+
+        HeatmapOutput Output = HeatmapOutput::Delta;
+        // Cells per side, rounded up to a power of two
+        uint32_t Resolution = 1024;
+
+        bool operator==(const ObjectiveHeatmapParams&) const = default;
+    };
+
+    // Output at the center of cell (_X, _Y) of the full resolution grid, NaN if it can't be calculated
+    float CalculateHeatmapCell(const ObjectiveHeatmapParams& _Params, uint32_t _X, uint32_t _Y);
+
+    // Calculates the heatmap progressively without blocking the frame. The first level is a coarse grid of
+    // kHeatmapCoarseResolution cells per side, every next level doubles it and calculates only the new cells, so the
+    // whole map is calculated once. Every cell fills the block of the grid it stands for until finer levels replace
+    // it. Levels are split in tiles which run in parallel and are published as soon as they are done.
+    //
+    // Changed params cancel the calculation (it stops after the current tiles) and the latest params are calculated
+    // next
+    class ObjectiveHeatmap
+    {
+    public:
+        ~ObjectiveHeatmap();
+
+        // Returns true when new cells were copied into the values
+        bool Update(const ObjectiveHeatmapParams& _Params);
+
+        // Called on a worker thread when tiles are published
+        void SetOnUpdated(const std::function<void()>& _OnUpdated) { m_OnUpdated = _OnUpdated; }
+
+        bool IsCalculating() const { return m_Future.valid(); }
+        bool HasValues() const { return !m_Values.empty(); }
+
+        // Resolution x Resolution, row 0 is at MinY. Not calculated cells are NaN
+        const std::vector<float>& GetValues() const { return m_Values; }
+        uint32_t GetResolution() const { return m_Params.Resolution; }
+        const ObjectiveHeatmapParams& GetParams() const { return m_Params; }
+
+        // Range of the calculated cells
+        float GetMin() const { return m_Min; }
+        float GetMax() const { return m_Max; }
+        // Share of the calculated cells
+        float GetProgress() const { return m_Progress; }
+        double GetCalculationMs() const { return m_CalculationMs; }
+
+        // Values averaged in blocks to at most _MaxResolution cells per side for ImPlot::PlotHeatmap, row 0 is at
+        // MaxY. Cells without values get the max value. Recalculated only after updates
+        const std::vector<float>& GetDisplayValues(uint32_t _MaxResolution, uint32_t* _Resolution);
+
+    protected:
+        void Start(const ObjectiveHeatmapParams& _Params);
+        void Run(const ObjectiveHeatmapParams& _Params);
+
+    protected:
+        ObjectiveHeatmapParams m_Params;
+        bool m_HasParams = false;
+        std::future<void> m_Future;
+        std::atomic<bool> m_Cancel = false;
+        std::function<void()> m_OnUpdated;
+
+        // Written by the worker under m_Mutex
+        std::mutex m_Mutex;
+        std::vector<float> m_SharedValues;
+        uint64_t m_SharedVersion = 0;
+        uint64_t m_SharedCalculated = 0;
+        double m_SharedCalculationMs = 0.0;
+
+        // Copy of the shared values for the frame
+        std::vector<float> m_Values;
+        uint64_t m_Version = 0;
+        float m_Min = 0.0f;
+        float m_Max = 0.0f;
+        float m_Progress = 0.0f;
+        double m_CalculationMs = 0.0;
+
+        std::vector<float> m_DisplayValues;
+        uint32_t m_DisplayResolution = 0;
+        bool m_DisplayDirty = true;
+    };
+
+}    // namespace LM
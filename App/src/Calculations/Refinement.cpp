@@ -0,0 +1,207 @@
+#include "Refinement.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <execution>
+#include <numeric>
+
+namespace LM
+{
+
+    // Residuals of the params which CalculateParamsDelta counts: step angle and diametr in
+    constexpr uint32_t kRefinementResidualsCount = 2;
+
+    constexpr double kRefinementInitialDamping = 1e-3;
+    constexpr double kRefinementMaxDamping = 1e12;
+
+    typedef std::array<double, kRefinementResidualsCount> RefinementResiduals;
+
+    static RefinementResiduals GetResiduals(const ParamsJacobian& _Jacobian, const ParamsToFind& _ToFind)
+    {
+        return { _Jacobian.StepAngle.Value - double(_ToFind.StepAngle),
+                 _Jacobian.DiametrIn.Value - double(_ToFind.DiametrIn) };
+    }
+
+    static double GetCost(const RefinementResiduals& _Residuals)
+    {
+        return _Residuals[0] * _Residuals[0] + _Residuals[1] * _Residuals[1];
+    }
+
+    RefinementParams MakeRefinementParams(const SweepJob& _Job)
+    {
+        RefinementParams params;
+        params.Params = _Job.Params;
+        params.Tool = _Job.Tool;
+        params.ToFind = _Job.ToFind;
+        return params;
+    }
+
+    bool RefineResult(const RefinementParams& _Params, const SweepCandidate& _Start, SweepCandidate* _Result,
+                      uint32_t* _Evaluations)
+    {
+        *_Result = _Start;
+
+        // Varying axes of the sweep in scaled units: 1 is the whole Min-Max range of the axis
+        uint32_t axes[kSweepAxesCount];
+        double ranges[kSweepAxesCount];
+        uint32_t axesCount = 0;
+        SweepMask mask = GetSweepMask(_Params.Params);
+        for (uint32_t axis = 0; axis < kSweepAxesCount; axis++)
+        {
+            double range = double(_Params.Params.Max.*kSweepAxes<float>[axis]) -
+                           double(_Params.Params.Min.*kSweepAxes<float>[axis]);
+            if ((mask & BIT(axis)) && range > 0.0)
+            {
+                axes[axesCount] = axis;
+                ranges[axesCount] = range;
+                axesCount++;
+            }
+        }
+
+        GrindingWheelCalcParams values = GetBestResultValues(_Start.Result);
+        ParamsJacobian jacobian;
+        uint32_t evaluations = 1;
+        bool calculated = axesCount > 0 && CalculateParamsJacobian(values, _Params.Tool, &jacobian);
+
+        RefinementResiduals residuals = calculated ? GetResiduals(jacobian, _Params.ToFind) : RefinementResiduals {};
+        double cost = GetCost(residuals);
+        double damping = -1.0;
+        while (calculated && evaluations < _Params.MaxEvaluations)
+        {
+            if (glm::abs(residuals[0]) <= _Params.AngleTolerance && glm::abs(residuals[1]) <= _Params.LengthTolerance)
+            {
+                break;
+            }
+
+            // Jacobian of the residuals by the scaled axes
+            double jacobianArr[kRefinementResidualsCount][kSweepAxesCount];
+            for (uint32_t i = 0; i < axesCount; i++)
+            {
+                jacobianArr[0][i] = jacobian.StepAngle.Derivatives[axes[i]] * ranges[i];
+                jacobianArr[1][i] = jacobian.DiametrIn.Derivatives[axes[i]] * ranges[i];
+            }
+
+            // There are less residuals than axes, so the step -J^T (J J^T + damping I)^-1 r, which equals the usual
+            // -(J^T J + damping I)^-1 J^T r, takes a 2x2 solve
+            double a = 0.0;
+            double b = 0.0;
+            double c = 0.0;
+            for (uint32_t i = 0; i < axesCount; i++)
+            {
+                a += jacobianArr[0][i] * jacobianArr[0][i];
+                b += jacobianArr[0][i] * jacobianArr[1][i];
+                c += jacobianArr[1][i] * jacobianArr[1][i];
+            }
+            if (damping < 0.0)
+            {
+                damping = kRefinementInitialDamping * glm::max(glm::max(a, c), 1e-12);
+            }
+
+            GrindingWheelCalcParams nextValues = values;
+            bool accepted = false;
+            for (; damping <= kRefinementMaxDamping && evaluations < _Params.MaxEvaluations; damping *= 10.0)
+            {
+                double determinant = (a + damping) * (c + damping) - b * b;
+                double y0 = ((c + damping) * residuals[0] - b * residuals[1]) / determinant;
+                double y1 = ((a + damping) * residuals[1] - b * residuals[0]) / determinant;
+
+                // Steps out of the bounds are projected back on them
+                for (uint32_t i = 0; i < axesCount; i++)
+                {
+                    const uint32_t axis = axes[i];
+                    double step = -(jacobianArr[0][i] * y0 + jacobianArr[1][i] * y1) * ranges[i];
+                    nextValues.*kSweepAxes<float>[axis] =
+                        float(glm::clamp(double(values.*kSweepAxes<float>[axis]) + step,
+                                         double(_Params.Params.Min.*kSweepAxes<float>[axis]),
+                                         double(_Params.Params.Max.*kSweepAxes<float>[axis])));
+                }
+                if (nextValues == values)
+                {
+                    break;
+                }
+
+                ParamsJacobian nextJacobian;
+                evaluations++;
+                if (CalculateParamsJacobian(nextValues, _Params.Tool, &nextJacobian))
+                {
+                    RefinementResiduals nextResiduals = GetResiduals(nextJacobian, _Params.ToFind);
+                    double nextCost = GetCost(nextResiduals);
+                    if (nextCost < cost)
+                    {
+                        values = nextValues;
+                        jacobian = nextJacobian;
+                        residuals = nextResiduals;
+                        damping /= 10.0;
+                        cost = nextCost;
+                        accepted = true;
+                        break;
+                    }
+                }
+            }
+
+            // Steps are rejected down to float resolution or the damping limit, the values can't get any better
+            if (!accepted)
+            {
+                break;
+            }
+        }
+
+        if (_Evaluations)
+        {
+            *_Evaluations = evaluations;
+        }
+
+        // Refined values are checked by the same float calculation as the sweep, so the deltas are comparable
+        GrindingWheelParams wheelParams = { values.Diametr, values.Width, values.R1, values.R2, values.Angle };
+        GrindingWheelProfileParams profileParams = { values.OffsetToolCenter, values.OffsetToolAxis,
+                                                     values.RotationAngle };
+        ParamsToFind calculatedParams;
+        if (!calculated || !CalculateParamsSingle(CalculateGrindingWheelSizes(wheelParams), wheelParams, profileParams,
+                                                  _Params.Tool, &calculatedParams))
+        {
+            return false;
+        }
+
+        float delta = CalculateParamsDelta(calculatedParams, _Params.ToFind);
+        if (!(delta < _Start.Delta))
+        {
+            return false;
+        }
+
+        _Result->Delta = delta;
+        _Result->Result = MakeBestResult(wheelParams, profileParams, calculatedParams);
+        return true;
+    }
+
+    RefinementResult RefineTopResults(const RefinementParams& _Params, const std::vector<SweepCandidate>& _TopResults,
+                                      size_t _Count)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        RefinementResult result;
+        result.TopResults = _TopResults;
+        result.Refined = glm::min(_Count, _TopResults.size());
+
+        std::vector<uint32_t> evaluationsArr(result.Refined, 0);
+        std::vector<uint8_t> improvedArr(result.Refined, 0);
+        std::vector<size_t> indexArr(result.Refined);
+        std::iota(indexArr.begin(), indexArr.end(), 0);
+        std::for_each(std::execution::par, indexArr.begin(), indexArr.end(), [&](size_t _Index) {
+            improvedArr[_Index] = RefineResult(_Params, _TopResults[_Index], &result.TopResults[_Index],
+                                               &evaluationsArr[_Index]);
+        });
+
+        result.Improved = std::accumulate(improvedArr.begin(), improvedArr.end(), uint64_t(0));
+        result.Evaluations = std::accumulate(evaluationsArr.begin(), evaluationsArr.end(), uint64_t(0));
+
+        // Stable sort keeps results with equal delta in sweep order
+        std::stable_sort(result.TopResults.begin(), result.TopResults.end(),
+                         [](const SweepCandidate& _A, const SweepCandidate& _B) { return _A.Delta < _B.Delta; });
+
+        result.CalculationMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        return result;
+    }
+
+}    // namespace LM
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Calculations.h"
+#include "SweepRunner.h"
+
+namespace LM
+{
+
+    constexpr size_t kRefinementDefaultCount = 10;
+    constexpr uint32_t kRefinementDefaultMaxEvaluations = 50;
+
+    struct RefinementParams
+    {
+        // Varying axes of the sweep are refined inside their Min-Max bounds, constant axes are kept
+        CalcParams Params;
+        ToolParams Tool;
+        ParamsToFind ToFind;
+
+        uint32_t MaxEvaluations = kRefinementDefaultMaxEvaluations;
+        // Refinement stops when every residual is below its tolerance
+        float AngleTolerance = 1e-4f;
+        float LengthTolerance = 1e-4f;
+    };
+
+    // Refinement of the results of _Job in the bounds of its sweep, with its tool and targets
+    RefinementParams MakeRefinementParams(const SweepJob& _Job);
+
+    struct RefinementResult
+    {
+        // Sorted by delta, lowest first, as SweepResult::TopResults
+        std::vector<SweepCandidate> TopResults;
+
+        uint64_t Refined = 0;
+        uint64_t Improved = 0;
+        uint64_t Evaluations = 0;
+        double CalculationMs = 0.0;
+    };
+
+    // Polishes _Start off the sweep grid with projected Levenberg-Marquardt on the residuals of the params which
+    // CalculateParamsDelta counts. Derivatives come from CalculateParamsJacobian, so every iteration takes one
+    // evaluation. Returns false and keeps _Start if the refined result is not better
+    bool RefineResult(const RefinementParams& _Params, const SweepCandidate& _Start, SweepCandidate* _Result,
+                      uint32_t* _Evaluations = nullptr);
+
+    // Refines the first _Count of _TopResults in parallel, the rest are kept as they are
+    RefinementResult RefineTopResults(const RefinementParams& _Params, const std::vector<SweepCandidate>& _TopResults,
+                                      size_t _Count);
+
+}    // namespace LM
@@ -5,6 +5,10 @@ namespace LM
 
     float ValueByStep(float _Min, float _Max, int _Step, int _StepsCount)
     {
+        if (_StepsCount == 0)
+        {
+            return _Min;
+        }
         return _Min + (_Max - _Min) * float(_Step) / float(_StepsCount);
     }
 
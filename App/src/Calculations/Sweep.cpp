@@ -0,0 +1,69 @@
+#include "Sweep.h"
+
+namespace LM
+{
+
+    SweepMask GetSweepMask(const CalcParams& _Params)
+    {
+        SweepMask result = 0;
+        for (uint32_t axis = 0; axis < kSweepAxesCount; axis++)
+        {
+            if (_Params.Steps.*kSweepAxes<int>[axis] > 0)
+            {
+                result |= BIT(axis);
+            }
+        }
+        return result;
+    }
+
+    uint64_t GetSweepAxisValuesCount(const CalcParams& _Params, uint32_t _Axis)
+    {
+        return (GetSweepMask(_Params) & BIT(_Axis)) ? uint64_t(_Params.Steps.*kSweepAxes<int>[_Axis]) + 1 : 1;
+    }
+
+    uint64_t GetSweepBlocksCount(const CalcParams& _Params)
+    {
+        SweepMask outerMask = GetSweepOuterMask(GetSweepMask(_Params));
+
+        uint64_t result = 1;
+        for (uint32_t axis = 0; axis < kSweepAxesCount; axis++)
+        {
+            if (outerMask & BIT(axis))
+            {
+                result *= GetSweepAxisValuesCount(_Params, axis);
+            }
+        }
+        return result;
+    }
+
+    uint64_t GetSweepCalculationsCount(const CalcParams& _Params)
+    {
+        uint64_t result = 1;
+        for (uint32_t axis = 0; axis < kSweepAxesCount; axis++)
+        {
+            result *= GetSweepAxisValuesCount(_Params, axis);
+        }
+        return result;
+    }
+
+    uint64_t GetSweepSamplesBlocksCount(uint64_t _SamplesCount)
+    {
+        return (_SamplesCount + kSweepSamplesPerBlock - 1) / kSweepSamplesPerBlock;
+    }
+
+    double RadicalInverse(uint32_t _Base, uint64_t _Index)
+    {
+        const double invBase = 1.0 / _Base;
+
+        double result = 0.0;
+        double digitWeight = invBase;
+        while (_Index > 0)
+        {
+            result += double(_Index % _Base) * digitWeight;
+            _Index /= _Base;
+            digitWeight *= invBase;
+        }
+        return result;
+    }
+
+}    // namespace LM
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "Engine/Core/Base.h"
+
+#include "Calculations.h"
+#include "Steps.h"
+
+namespace LM
+{
+
+    // Sweep axes in loop nest order: the first axis is the outermost loop, the last one is the innermost.
+    constexpr uint32_t kSweepAxesCount = 8;
+
+    // Count of innermost varying axes that are swept inside one block. All other varying axes form the block index.
+    constexpr uint32_t kSweepInnerAxesCount = 2;
+
+    enum class SweepSampling
+    {
+        // Every ValueByStep point of every varying axis
+        Grid = 0,
+        // Fixed budget of Halton sequence points in the Min-Max box of varying axes, Steps only mark varying axes
+        Halton,
+    };
+
+    // Halton sweep is split in blocks of consecutive sequence indices
+    constexpr uint64_t kSweepSamplesPerBlock = 4096;
+
+    // Bit N is set when axis N varies (has at least one step), otherwise the axis is constant and equals Min.
+    typedef uint32_t SweepMask;
+
+    template <typename T>
+    inline constexpr T GrindingWheelCalcTemplate<T>::*kSweepAxes[kSweepAxesCount] = {
+        &GrindingWheelCalcTemplate<T>::Diametr,          &GrindingWheelCalcTemplate<T>::Width,
+        &GrindingWheelCalcTemplate<T>::R1,               &GrindingWheelCalcTemplate<T>::R2,
+        &GrindingWheelCalcTemplate<T>::Angle,            &GrindingWheelCalcTemplate<T>::OffsetToolCenter,
+        &GrindingWheelCalcTemplate<T>::OffsetToolAxis,   &GrindingWheelCalcTemplate<T>::RotationAngle,
+    };
+
+    inline constexpr const char* kSweepAxisNames[kSweepAxesCount] = {
+        "Diametr", "Width", "R1", "R2", "Angle", "Offset Tool Center", "Offset Tool Axis", "Rotation Angle",
+    };
+
+    constexpr SweepMask GetSweepInnerMask(SweepMask _Mask)
+    {
+        SweepMask result = 0;
+        uint32_t count = 0;
+        for (int axis = kSweepAxesCount - 1; axis >= 0 && count < kSweepInnerAxesCount; axis--)
+        {
+            if (_Mask & BIT(axis))
+            {
+                result |= BIT(axis);
+                count++;
+            }
+        }
+        return result;
+    }
+
+    constexpr SweepMask GetSweepOuterMask(SweepMask _Mask) { return _Mask & ~GetSweepInnerMask(_Mask); }
+
+    SweepMask GetSweepMask(const CalcParams& _Params);
+
+    uint64_t GetSweepAxisValuesCount(const CalcParams& _Params, uint32_t _Axis);
+
+    uint64_t GetSweepBlocksCount(const CalcParams& _Params);
+
+    uint64_t GetSweepCalculationsCount(const CalcParams& _Params);
+
+    uint64_t GetSweepSamplesBlocksCount(uint64_t _SamplesCount);
+
+    // Digits of _Index in base _Base mirrored around the radix point, in [0, 1)
+    double RadicalInverse(uint32_t _Base, uint64_t _Index);
+
+    template <SweepMask Mask, uint32_t Axis, typename Func>
+    inline void SweepAxisLoop(const CalcParams& _Params, GrindingWheelCalcParams& _Values, Func& _Func)
+    {
+        if constexpr (Axis == kSweepAxesCount)
+        {
+            _Func(static_cast<const GrindingWheelCalcParams&>(_Values));
+        }
+        else if constexpr ((Mask & BIT(Axis)) != 0)
+        {
+            constexpr auto kAxis = kSweepAxes<float>[Axis];
+            const float min = _Params.Min.*kAxis;
+            const float max = _Params.Max.*kAxis;
+            const int stepsCount = _Params.Steps.*kSweepAxes<int>[Axis];
+
+            for (int step = 0; step <= stepsCount; step++)
+            {
+                _Values.*kAxis = ValueByStep(min, max, step, stepsCount);
+                SweepAxisLoop<Mask, Axis + 1>(_Params, _Values, _Func);
+            }
+        }
+        else
+        {
+            SweepAxisLoop<Mask, Axis + 1>(_Params, _Values, _Func);
+        }
+    }
+
+    template <SweepMask Mask, typename Func>
+    void SweepBlockSpecialized(const CalcParams& _Params, uint64_t _Block, Func& _Func)
+    {
+        constexpr SweepMask kOuterMask = GetSweepOuterMask(Mask);
+        constexpr SweepMask kInnerMask = GetSweepInnerMask(Mask);
+
+        // Constant axes are set once here and never touched by the loop nest
+        GrindingWheelCalcParams values = _Params.Min;
+
+        for (int axis = kSweepAxesCount - 1; axis >= 0; axis--)
+        {
+            if (kOuterMask & BIT(axis))
+            {
+                const int stepsCount = _Params.Steps.*kSweepAxes<int>[axis];
+                const int step = int(_Block % uint64_t(stepsCount + 1));
+                _Block /= uint64_t(stepsCount + 1);
+
+                values.*kSweepAxes<float>[axis] = ValueByStep(_Params.Min.*kSweepAxes<float>[axis],
+                                                              _Params.Max.*kSweepAxes<float>[axis], step, stepsCount);
+            }
+        }
+
+        SweepAxisLoop<kInnerMask, 0>(_Params, values, _Func);
+    }
+
+    template <typename Func>
+    using SweepBlockFn = void (*)(const CalcParams&, uint64_t, Func&);
+
+    template <typename Func, SweepMask... Masks>
+    constexpr std::array<SweepBlockFn<Func>, sizeof...(Masks)>
+    MakeSweepBlockTable(std::integer_sequence<SweepMask, Masks...>)
+    {
+        return { &SweepBlockSpecialized<Masks, Func>... };
+    }
+
+    // Calls _Func(const GrindingWheelCalcParams&) for every grid point of the block. The loop nest is selected by
+    // the mask of varying axes, so constant axes produce no loops and no ValueByStep calls.
+    template <typename Func>
+    void SweepBlock(const CalcParams& _Params, uint64_t _Block, Func&& _Func)
+    {
+        typedef std::remove_reference_t<Func> FuncType;
+        static constexpr auto kTable =
+            MakeSweepBlockTable<FuncType>(std::make_integer_sequence<SweepMask, (1u << kSweepAxesCount)>());
+
+        kTable[GetSweepMask(_Params)](_Params, _Block, _Func);
+    }
+
+    // Calls _Func(const GrindingWheelCalcParams&) for every Halton point of the block. Varying axes get prime bases in
+    // axis order, so the lowest bases (with the best uniformity) go to the outer axes
+    template <typename Func>
+    void SweepHaltonBlock(const CalcParams& _Params, uint64_t _SamplesCount, uint64_t _Block, Func&& _Func)
+    {
+        constexpr uint32_t kPrimes[kSweepAxesCount] = { 2, 3, 5, 7, 11, 13, 17, 19 };
+
+        SweepMask mask = GetSweepMask(_Params);
+        uint32_t axes[kSweepAxesCount];
+        uint32_t axesCount = 0;
+        for (uint32_t axis = 0; axis < kSweepAxesCount; axis++)
+        {
+            if (mask & BIT(axis))
+            {
+                axes[axesCount++] = axis;
+            }
+        }
+
+        GrindingWheelCalcParams values = _Params.Min;
+
+        uint64_t sampleBegin = _Block * kSweepSamplesPerBlock;
+        uint64_t sampleEnd = sampleBegin + kSweepSamplesPerBlock < _SamplesCount ? sampleBegin + kSweepSamplesPerBlock
+                                                                                  : _SamplesCount;
+        for (uint64_t sample = sampleBegin; sample < sampleEnd; sample++)
+        {
+            for (uint32_t i = 0; i < axesCount; i++)
+            {
+                const float min = _Params.Min.*kSweepAxes<float>[axes[i]];
+                const float max = _Params.Max.*kSweepAxes<float>[axes[i]];
+                // Index 0 is the Min corner for every axis, so the sequence starts from 1
+                values.*kSweepAxes<float>[axes[i]] = min + (max - min) * float(RadicalInverse(kPrimes[i], sample + 1));
+            }
+            _Func(static_cast<const GrindingWheelCalcParams&>(values));
+        }
+    }
+
+}    // namespace LM
@@ -0,0 +1,492 @@
+#include "SweepFiles.h"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "Engine/Utils/ConsoleLog.h"
+#include "Engine/Utils/json.hpp"
+
+namespace LM
+{
+
+    template <typename T>
+    void to_json(nlohmann::json& _Json, const GrindingWheelCalcTemplate<T>& _Value)
+    {
+        _Json = nlohmann::json {
+            {"Diametr",           _Value.Diametr         },
+            { "Width",            _Value.Width           },
+            { "R1",               _Value.R1              },
+            { "R2",               _Value.R2              },
+            { "Angle",            _Value.Angle           },
+            { "OffsetToolCenter", _Value.OffsetToolCenter},
+            { "OffsetToolAxis",   _Value.OffsetToolAxis  },
+            { "RotationAngle",    _Value.RotationAngle   },
+        };
+    }
+
+    template <typename T>
+    void from_json(const nlohmann::json& _Json, GrindingWheelCalcTemplate<T>& _Value)
+    {
+        _Json.at("Diametr").get_to(_Value.Diametr);
+        _Json.at("Width").get_to(_Value.Width);
+        _Json.at("R1").get_to(_Value.R1);
+        _Json.at("R2").get_to(_Value.R2);
+        _Json.at("Angle").get_to(_Value.Angle);
+        _Json.at("OffsetToolCenter").get_to(_Value.OffsetToolCenter);
+        _Json.at("OffsetToolAxis").get_to(_Value.OffsetToolAxis);
+        _Json.at("RotationAngle").get_to(_Value.RotationAngle);
+    }
+
+    constexpr const char* kBase64Chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // Candidate columns have up to millions of values, as base64 of the raw floats they take about 4x less space
+    // than JSON numbers and parse much faster
+    static std::string EncodeFloats(const std::vector<float>& _Values)
+    {
+        std::vector<uint8_t> bytes(_Values.size() * sizeof(float));
+        std::memcpy(bytes.data(), _Values.data(), bytes.size());
+
+        std::string result;
+        result.reserve((bytes.size() + 2) / 3 * 4);
+        for (size_t i = 0; i < bytes.size(); i += 3)
+        {
+            uint32_t triple = uint32_t(bytes[i]) << 16;
+            triple |= i + 1 < bytes.size() ? uint32_t(bytes[i + 1]) << 8 : 0;
+            triple |= i + 2 < bytes.size() ? uint32_t(bytes[i + 2]) : 0;
+
+            result.push_back(kBase64Chars[(triple >> 18) & 63]);
+            result.push_back(kBase64Chars[(triple >> 12) & 63]);
+            result.push_back(i + 1 < bytes.size() ? kBase64Chars[(triple >> 6) & 63] : '=');
+            result.push_back(i + 2 < bytes.size() ? kBase64Chars[triple & 63] : '=');
+        }
+        return result;
+    }
+
+    static bool DecodeFloats(const std::string& _Str, std::vector<float>* _Values)
+    {
+        if (_Str.size() % 4 != 0)
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> bytes;
+        bytes.reserve(_Str.size() / 4 * 3);
+        for (size_t i = 0; i < _Str.size(); i += 4)
+        {
+            uint32_t triple = 0;
+            uint32_t padding = 0;
+            for (size_t j = 0; j < 4; j++)
+            {
+                const char c = _Str[i + j];
+                const char* found = c != '\0' ? std::strchr(kBase64Chars, c) : nullptr;
+                if (c == '=' && i + 4 == _Str.size() && j >= 2)
+                {
+                    padding++;
+                }
+                else if (!found || padding > 0)
+                {
+                    return false;
+                }
+                triple = (triple << 6) | (found ? uint32_t(found - kBase64Chars) : 0);
+            }
+
+            bytes.push_back(uint8_t(triple >> 16));
+            if (padding < 2)
+            {
+                bytes.push_back(uint8_t(triple >> 8));
+            }
+            if (padding < 1)
+            {
+                bytes.push_back(uint8_t(triple));
+            }
+        }
+
+        if (bytes.size() % sizeof(float) != 0)
+        {
+            return false;
+        }
+        _Values->resize(bytes.size() / sizeof(float));
+        std::memcpy(_Values->data(), bytes.data(), bytes.size());
+        return true;
+    }
+
+    void to_json(nlohmann::json& _Json, const CandidateStore& _Value)
+    {
+        nlohmann::json columns = nlohmann::json::object();
+        for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+        {
+            columns[GetCandidateColumnName(CandidateColumn(column))] = EncodeFloats(_Value.Columns[column]);
+        }
+        _Json = nlohmann::json {
+            {"Limit",    _Value.Limit},
+            { "Columns", columns     },
+        };
+    }
+
+    void from_json(const nlohmann::json& _Json, CandidateStore& _Value)
+    {
+        _Json.at("Limit").get_to(_Value.Limit);
+        const nlohmann::json& columns = _Json.at("Columns");
+        for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+        {
+            const char* name = GetCandidateColumnName(CandidateColumn(column));
+            if (!DecodeFloats(columns.at(name).get<std::string>(), &_Value.Columns[column]) ||
+                _Value.Columns[column].size() != _Value.Columns[0].size())
+            {
+                throw nlohmann::json::other_error::create(501, std::string("Bad candidates column: ") + name, &_Json);
+            }
+        }
+    }
+
+    NLOHMANN_JSON_SERIALIZE_ENUM(SweepSampling, {
+                                                    { SweepSampling::Grid, "Grid" },
+                                                    { SweepSampling::Halton, "Halton" },
+                                                })
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(CalcParams, Min, Max, Steps)
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ToolParams, Diametr, Height, Angle)
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(ParamsToFind, FrontAngle, StepAngle, DiametrIn)
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(BestResult, Width, R1, R2, Angle, OffsetToolCenter, OffsetToolAxis,
+                                       RotationAngle, Diametr, FrontAngle, StepAngle, DiametrIn)
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(BestResultMeta, Calculated, BadCalculations, HasBestResult)
+    // Sampling fields are optional, jobs saved before them are grid jobs
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SweepJob, Params, Tool, ToFind, Sampling, SamplesCount)
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(SweepCandidate, Delta, Result)
+    // Candidates are optional, results saved before them have none
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SweepResult, NearestParamsToFind, Meta, TopResults, Candidates)
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(SweepProgress, BlockBegin, BlockEnd, ChunksCount, MergedChunks, Merged, Pending)
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(SweepCheckpoint, Job, TopCount, CandidatesLimit, Progress)
+
+    static bool WriteJsonFile(const std::filesystem::path& _Path, const nlohmann::json& _Json)
+    {
+        std::error_code error;
+        if (_Path.has_parent_path())
+        {
+            std::filesystem::create_directories(_Path.parent_path(), error);
+        }
+
+        std::filesystem::path tmpPath = _Path;
+        tmpPath += ".tmp";
+
+        {
+            std::ofstream outfile(tmpPath);
+            if (!outfile.is_open())
+            {
+                LOGE("Can't open file for write: ", tmpPath.string());
+                return false;
+            }
+            outfile << _Json.dump(4);
+            if (!outfile.good())
+            {
+                LOGE("Can't write file: ", tmpPath.string());
+                return false;
+            }
+        }
+
+        std::filesystem::rename(tmpPath, _Path, error);
+        if (error)
+        {
+            LOGE("Can't rename ", tmpPath.string(), " to ", _Path.string(), ": ", error.message());
+            return false;
+        }
+
+        return true;
+    }
+
+    static bool ReadJsonFile(const std::filesystem::path& _Path, nlohmann::json* _Json)
+    {
+        std::ifstream infile(_Path);
+        if (!infile.is_open())
+        {
+            LOGE("Can't open file: ", _Path.string());
+            return false;
+        }
+
+        *_Json = nlohmann::json::parse(infile, nullptr, false);
+        if (_Json->is_discarded())
+        {
+            LOGE("Can't parse file: ", _Path.string());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool SaveSweepJob(const std::filesystem::path& _Path, const SweepJob& _Job)
+    {
+        if (!WriteJsonFile(_Path, _Job))
+        {
+            return false;
+        }
+
+        LOGI("Sweep job saved: ", _Path.string());
+        return true;
+    }
+
+    bool LoadSweepJob(const std::filesystem::path& _Path, SweepJob* _Job)
+    {
+        nlohmann::json data;
+        if (!ReadJsonFile(_Path, &data))
+        {
+            return false;
+        }
+
+        try
+        {
+            data.get_to(*_Job);
+        }
+        catch (const nlohmann::json::exception& e)
+        {
+            LOGE("Bad sweep job file ", _Path.string(), ": ", e.what());
+            return false;
+        }
+
+        return true;
+    }
+
+    std::filesystem::path GetSweepShardPath(const std::filesystem::path& _Dir, uint32_t _Shard, uint32_t _ShardsCount)
+    {
+        return _Dir / ("shard_" + std::to_string(_Shard) + "_of_" + std::to_string(_ShardsCount) + ".json");
+    }
+
+    bool SaveSweepShard(const std::filesystem::path& _Dir, uint32_t _Shard, uint32_t _ShardsCount, const SweepJob& _Job,
+                        const SweepResult& _Result)
+    {
+        nlohmann::json data = {
+            {"Shard",        _Shard      },
+            { "ShardsCount", _ShardsCount},
+            { "Job",         _Job        },
+            { "Result",      _Result     },
+        };
+
+        return WriteJsonFile(GetSweepShardPath(_Dir, _Shard, _ShardsCount), data);
+    }
+
+    bool LoadSweepShard(const std::filesystem::path& _Dir, uint32_t _Shard, uint32_t _ShardsCount, SweepJob* _Job,
+                        SweepResult* _Result)
+    {
+        std::filesystem::path path = GetSweepShardPath(_Dir, _Shard, _ShardsCount);
+
+        nlohmann::json data;
+        if (!ReadJsonFile(path, &data))
+        {
+            return false;
+        }
+
+        try
+        {
+            if (data.at("Shard").get<uint32_t>() != _Shard || data.at("ShardsCount").get<uint32_t>() != _ShardsCount)
+            {
+                LOGE("Shard file ", path.string(), " has another shard id");
+                return false;
+            }
+            data.at("Job").get_to(*_Job);
+            data.at("Result").get_to(*_Result);
+        }
+        catch (const nlohmann::json::exception& e)
+        {
+            LOGE("Bad shard file ", path.string(), ": ", e.what());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool MergeSweepShards(const std::filesystem::path& _Dir, uint32_t _ShardsCount, size_t _TopCount, SweepJob* _Job,
+                          SweepResult* _Result)
+    {
+        if (_ShardsCount == 0)
+        {
+            LOGE("Shards count must be greater than 0");
+            return false;
+        }
+
+        SweepJob job;
+        nlohmann::json jobJson;
+        SweepResult result;
+
+        for (uint32_t shard = 0; shard < _ShardsCount; shard++)
+        {
+            SweepJob shardJob;
+            SweepResult shardResult;
+            if (!LoadSweepShard(_Dir, shard, _ShardsCount, &shardJob, &shardResult))
+            {
+                LOGE("Shard ", shard, " of ", _ShardsCount, " is missing or broken");
+                return false;
+            }
+
+            if (shard == 0)
+            {
+                job = shardJob;
+                jobJson = shardJob;
+                result = shardResult;
+                continue;
+            }
+
+            if (nlohmann::json(shardJob) != jobJson)
+            {
+                LOGE("Shard ", shard, " was calculated for another sweep job");
+                return false;
+            }
+            result.Merge(shardResult, job.ToFind, _TopCount);
+        }
+
+        if (result.TopResults.size() > _TopCount)
+        {
+            result.TopResults.resize(_TopCount);
+        }
+
+        nlohmann::json data = {
+            {"ShardsCount", _ShardsCount},
+            { "Job",        job         },
+            { "Result",     result      },
+        };
+        if (!WriteJsonFile(_Dir / kSweepResultFileName, data))
+        {
+            return false;
+        }
+
+        LOGI("Merged ", _ShardsCount, " shards, calculated: ", result.Meta.Calculated,
+             ", bad: ", result.Meta.BadCalculations, ", top results: ", result.TopResults.size());
+
+        *_Job = job;
+        *_Result = std::move(result);
+        return true;
+    }
+
+    bool LoadSweepResult(const std::filesystem::path& _Path, SweepJob* _Job, SweepResult* _Result)
+    {
+        nlohmann::json data;
+        if (!ReadJsonFile(_Path, &data))
+        {
+            return false;
+        }
+
+        try
+        {
+            data.at("Job").get_to(*_Job);
+            data.at("Result").get_to(*_Result);
+        }
+        catch (const nlohmann::json::exception& e)
+        {
+            LOGE("Bad result file ", _Path.string(), ": ", e.what());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool SaveSweepCheckpoint(const std::filesystem::path& _Path, const SweepCheckpoint& _Checkpoint)
+    {
+        return WriteJsonFile(_Path, _Checkpoint);
+    }
+
+    bool LoadSweepCheckpoint(const std::filesystem::path& _Path, SweepCheckpoint* _Checkpoint)
+    {
+        nlohmann::json data;
+        if (!ReadJsonFile(_Path, &data))
+        {
+            return false;
+        }
+
+        try
+        {
+            data.get_to(*_Checkpoint);
+        }
+        catch (const nlohmann::json::exception& e)
+        {
+            LOGE("Bad checkpoint file ", _Path.string(), ": ", e.what());
+            return false;
+        }
+
+        const SweepProgress& progress = _Checkpoint->Progress;
+        if (progress.ChunksCount == 0 || progress.MergedChunks > progress.ChunksCount ||
+            (!progress.Pending.empty() && progress.Pending.rbegin()->first >= progress.ChunksCount))
+        {
+            LOGE("Bad checkpoint file ", _Path.string(), ": wrong chunks");
+            return false;
+        }
+
+        LOGI("Checkpoint loaded: ", _Path.string(), ", completed chunks: ", progress.GetCompletedChunksCount(), " of ",
+             progress.ChunksCount);
+        return true;
+    }
+
+    bool LoadSweepCheckpointFor(const std::filesystem::path& _Path, const SweepRunner& _Runner, uint64_t _BlockBegin,
+                                uint64_t _BlockEnd, SweepProgress* _Progress)
+    {
+        SweepCheckpoint checkpoint;
+        if (!LoadSweepCheckpoint(_Path, &checkpoint))
+        {
+            return false;
+        }
+
+        if (nlohmann::json(checkpoint.Job) != nlohmann::json(_Runner.GetJob()) ||
+            checkpoint.Progress.BlockBegin != _BlockBegin || checkpoint.Progress.BlockEnd != _BlockEnd)
+        {
+            LOGW("Checkpoint ", _Path.string(), " was saved for another sweep job");
+            return false;
+        }
+
+        if (checkpoint.TopCount != _Runner.GetTopCount() || checkpoint.CandidatesLimit != _Runner.GetCandidatesLimit())
+        {
+            LOGW("Checkpoint ", _Path.string(), " was saved with top count ", checkpoint.TopCount,
+                 " and candidates limit ", checkpoint.CandidatesLimit);
+            return false;
+        }
+
+        *_Progress = std::move(checkpoint.Progress);
+        return true;
+    }
+
+    SweepCheckpointWriter::SweepCheckpointWriter(const std::filesystem::path& _Path, const SweepRunner& _Runner,
+                                                 std::chrono::seconds _Interval)
+        : m_Path(_Path),
+          m_Job(_Runner.GetJob()),
+          m_TopCount(_Runner.GetTopCount()),
+          m_CandidatesLimit(_Runner.GetCandidatesLimit()),
+          m_Interval(_Interval),
+          m_LastSaveTime(std::chrono::steady_clock::now())
+    { }
+
+    SweepCheckpointWriter::~SweepCheckpointWriter()
+    {
+        if (m_SaveFuture.valid())
+        {
+            m_SaveFuture.wait();
+        }
+    }
+
+    void SweepCheckpointWriter::OnChunkCompleted(const SweepProgress& _Progress)
+    {
+        bool isCompleted = _Progress.IsCompleted();
+        if (std::chrono::steady_clock::now() - m_LastSaveTime < m_Interval && !isCompleted)
+        {
+            return;
+        }
+
+        if (!isCompleted && m_SaveFuture.valid() &&
+            m_SaveFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return;
+        }
+
+        Save(_Progress);
+    }
+
+    void SweepCheckpointWriter::Save(const SweepProgress& _Progress)
+    {
+        if (m_SaveFuture.valid())
+        {
+            m_SaveFuture.get();
+        }
+
+        SweepCheckpoint checkpoint = { m_Job, m_TopCount, m_CandidatesLimit, _Progress };
+        m_SaveFuture = std::async(std::launch::async, [path = m_Path, checkpoint = std::move(checkpoint)]() {
+            return SaveSweepCheckpoint(path, checkpoint);
+        });
+        m_LastSaveTime = std::chrono::steady_clock::now();
+    }
+
+}    // namespace LM
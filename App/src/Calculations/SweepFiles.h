@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <future>
+
+#include "SweepRunner.h"
+
+namespace LM
+{
+
+    constexpr const char* kSweepJobFileName = "job.json";
+    constexpr const char* kSweepResultFileName = "result.json";
+    constexpr const char* kSweepCheckpointFileName = "checkpoint.json";
+
+    constexpr std::chrono::seconds kSweepCheckpointInterval(60);
+
+    bool SaveSweepJob(const std::filesystem::path& _Path, const SweepJob& _Job);
+    bool LoadSweepJob(const std::filesystem::path& _Path, SweepJob* _Job);
+
+    // <_Dir>/shard_<_Shard>_of_<_ShardsCount>.json
+    std::filesystem::path GetSweepShardPath(const std::filesystem::path& _Dir, uint32_t _Shard, uint32_t _ShardsCount);
+
+    // Shard file keeps the job it was calculated for, so shards of different jobs are never merged together.
+    // File is written to a temporary file first and then renamed, so a shared directory never has partial shards
+    bool SaveSweepShard(const std::filesystem::path& _Dir, uint32_t _Shard, uint32_t _ShardsCount, const SweepJob& _Job,
+                        const SweepResult& _Result);
+    bool LoadSweepShard(const std::filesystem::path& _Dir, uint32_t _Shard, uint32_t _ShardsCount, SweepJob* _Job,
+                        SweepResult* _Result);
+
+    // Merges all shards in shard order and writes <_Dir>/result.json, _Job is the job of the shards. Fails if any
+    // shard is missing or belongs to another job
+    bool MergeSweepShards(const std::filesystem::path& _Dir, uint32_t _ShardsCount, size_t _TopCount, SweepJob* _Job,
+                          SweepResult* _Result);
+
+    // Reads the result file written by MergeSweepShards with the job it was calculated for
+    bool LoadSweepResult(const std::filesystem::path& _Path, SweepJob* _Job, SweepResult* _Result);
+
+    // Checkpoint keeps the job and the runner settings with the progress. Merged chunks are already cut to the top
+    // count and sampled with the candidates stride, so a resumed run can't continue with other ones
+    struct SweepCheckpoint
+    {
+        SweepJob Job;
+        size_t TopCount = kSweepDefaultTopCount;
+        size_t CandidatesLimit = 0;
+        SweepProgress Progress;
+    };
+
+    bool SaveSweepCheckpoint(const std::filesystem::path& _Path, const SweepCheckpoint& _Checkpoint);
+    bool LoadSweepCheckpoint(const std::filesystem::path& _Path, SweepCheckpoint* _Checkpoint);
+
+    // Loads the checkpoint only if it was saved for the same job, runner settings and block range
+    bool LoadSweepCheckpointFor(const std::filesystem::path& _Path, const SweepRunner& _Runner, uint64_t _BlockBegin,
+                                uint64_t _BlockEnd, SweepProgress* _Progress);
+
+    // Pass OnChunkCompleted to SweepRunner::Run to save a checkpoint not more often than once per interval. The progress
+    // is copied under the runner lock and written on a thread of the writer, so chunks don't wait for the file. A save
+    // due while the previous one is running is skipped, the completed progress waits for it and is always saved
+    class SweepCheckpointWriter
+    {
+    public:
+        SweepCheckpointWriter(const std::filesystem::path& _Path, const SweepRunner& _Runner,
+                              std::chrono::seconds _Interval = kSweepCheckpointInterval);
+        ~SweepCheckpointWriter();
+
+        void OnChunkCompleted(const SweepProgress& _Progress);
+        // Saves _Progress after the previous save, e.g. of a cancelled run
+        void Save(const SweepProgress& _Progress);
+
+    protected:
+        std::filesystem::path m_Path;
+        SweepJob m_Job;
+        size_t m_TopCount;
+        size_t m_CandidatesLimit;
+        std::chrono::seconds m_Interval;
+        std::chrono::steady_clock::time_point m_LastSaveTime;
+        std::future<bool> m_SaveFuture;
+    };
+
+}    // namespace LM
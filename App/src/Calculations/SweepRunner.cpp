@@ -0,0 +1,235 @@
+#include "SweepRunner.h"
+
+#include <algorithm>
+#include <execution>
+#include <mutex>
+#include <thread>
+
+#include "Steps.h"
+#include "Sweep.h"
+
+namespace LM
+{
+
+    constexpr uint64_t kChunksPerThread = 8;
+    constexpr uint64_t kCheckpointChunksPerThread = 64;
+
+    void SweepResult::AddCandidate(const SweepCandidate& _Candidate, size_t _TopCount)
+    {
+        if (TopResults.size() >= _TopCount && !(_Candidate.Delta < TopResults.back().Delta))
+        {
+            return;
+        }
+
+        auto it = std::upper_bound(
+            TopResults.begin(), TopResults.end(), _Candidate.Delta,
+            [](float _Delta, const SweepCandidate& _Other) { return _Delta < _Other.Delta; });
+        TopResults.insert(it, _Candidate);
+
+        if (TopResults.size() > _TopCount)
+        {
+            TopResults.pop_back();
+        }
+
+        Meta.HasBestResult = true;
+    }
+
+    void SweepResult::Merge(const SweepResult& _Other, const ParamsToFind& _ParamsToFind, size_t _TopCount)
+    {
+        Meta.Calculated += _Other.Meta.Calculated;
+        Meta.BadCalculations += _Other.Meta.BadCalculations;
+
+        // Without any good calculation nearest params are still the initial ones
+        if (!_Other.TopResults.empty())
+        {
+            UpdateNearestParamsToFind(_Other.NearestParamsToFind, _ParamsToFind, &NearestParamsToFind);
+        }
+
+        for (const SweepCandidate& candidate : _Other.TopResults)
+        {
+            AddCandidate(candidate, _TopCount);
+        }
+
+        Candidates.Append(_Other.Candidates);
+    }
+
+    uint64_t SweepProgress::GetChunkBlockBegin(uint32_t _Chunk) const
+    {
+        return BlockBegin + (BlockEnd - BlockBegin) * _Chunk / ChunksCount;
+    }
+
+    void SweepProgress::AddChunk(uint32_t _Chunk, SweepResult&& _Result, const ParamsToFind& _ParamsToFind,
+                                 size_t _TopCount)
+    {
+        Pending.emplace(_Chunk, std::move(_Result));
+
+        for (auto it = Pending.begin(); it != Pending.end() && it->first == MergedChunks; it = Pending.erase(it))
+        {
+            Merged.Merge(it->second, _ParamsToFind, _TopCount);
+            MergedChunks++;
+        }
+    }
+
+    SweepRunner::SweepRunner(const SweepJob& _Job, size_t _TopCount, size_t _CandidatesLimit)
+        : m_Job(_Job),
+          m_TopCount(glm::max<size_t>(_TopCount, 1)),
+          m_CandidatesLimit(_CandidatesLimit)
+    {
+        if (m_Job.Sampling == SweepSampling::Grid)
+        {
+            m_BlocksCount = GetSweepBlocksCount(m_Job.Params);
+            m_CalculationsCount = GetSweepCalculationsCount(m_Job.Params);
+            // Grid blocks are equal
+            m_CalculationsPerBlock = m_BlocksCount > 0 ? m_CalculationsCount / m_BlocksCount : 0;
+        }
+        else
+        {
+            m_BlocksCount = GetSweepSamplesBlocksCount(m_Job.SamplesCount);
+            m_CalculationsCount = m_Job.SamplesCount;
+            m_CalculationsPerBlock = kSweepSamplesPerBlock;
+        }
+
+        if (m_CandidatesLimit > 0)
+        {
+            m_CandidatesStride =
+                glm::max<uint64_t>((m_CalculationsCount + m_CandidatesLimit - 1) / m_CandidatesLimit, 1);
+        }
+    }
+
+    SweepProgress SweepRunner::CreateProgress(uint64_t _BlockBegin, uint64_t _BlockEnd, bool _Parallel,
+                                              bool _SmallChunks) const
+    {
+        uint64_t blocksCount = _BlockEnd > _BlockBegin ? _BlockEnd - _BlockBegin : 0;
+        uint64_t threadsCount = _Parallel ? glm::max(std::thread::hardware_concurrency(), 1u) : 1;
+        uint64_t chunksPerThread = _SmallChunks ? kCheckpointChunksPerThread : kChunksPerThread;
+
+        SweepProgress progress;
+        progress.BlockBegin = _BlockBegin;
+        progress.BlockEnd = _BlockBegin + blocksCount;
+        progress.ChunksCount = uint32_t(glm::min(blocksCount, threadsCount * chunksPerThread));
+
+        return progress;
+    }
+
+    SweepResult SweepRunner::Run(uint64_t _BlockBegin, uint64_t _BlockEnd, bool _Parallel) const
+    {
+        SweepProgress progress = CreateProgress(_BlockBegin, _BlockEnd, _Parallel);
+        return Run(progress, _Parallel);
+    }
+
+    SweepResult SweepRunner::Run(SweepProgress& _Progress, bool _Parallel,
+                                 const std::function<void(const SweepProgress&)>& _OnChunkCompleted,
+                                 const std::atomic<bool>* _Cancel) const
+    {
+        std::vector<uint32_t> chunkArr;
+        for (uint32_t chunk = 0; chunk < _Progress.ChunksCount; chunk++)
+        {
+            if (!_Progress.IsChunkCompleted(chunk))
+            {
+                chunkArr.push_back(chunk);
+            }
+        }
+
+        std::mutex progressMutex;
+
+        auto runChunk = [&](uint32_t chunk) {
+            if (_Cancel && *_Cancel)
+            {
+                return;
+            }
+
+            SweepResult result =
+                RunBlocks(_Progress.GetChunkBlockBegin(chunk), _Progress.GetChunkBlockBegin(chunk + 1));
+
+            std::lock_guard<std::mutex> lock(progressMutex);
+            _Progress.AddChunk(chunk, std::move(result), m_Job.ToFind, m_TopCount);
+            if (_OnChunkCompleted)
+            {
+                _OnChunkCompleted(_Progress);
+            }
+        };
+
+        if (_Parallel)
+        {
+            // Chunks take a lock, so they can't run unsequenced
+            std::for_each(std::execution::par, chunkArr.begin(), chunkArr.end(), runChunk);
+        }
+        else
+        {
+            std::for_each(chunkArr.begin(), chunkArr.end(), runChunk);
+        }
+
+        return _Progress.Merged;
+    }
+
+    SweepResult SweepRunner::RunBlocks(uint64_t _BlockBegin, uint64_t _BlockEnd) const
+    {
+        SweepResult result;
+        result.Candidates.Limit = m_CandidatesLimit;
+
+        GrindingWheelParams params = {};
+        ShapeParams shapeParams = {};
+        bool hasShapeParams = false;
+        // Index of the calculation in the whole sweep
+        uint64_t calculation = 0;
+
+        auto calculateSingle = [&](const GrindingWheelCalcParams& _Values) {
+            bool keepCandidate = m_CandidatesLimit > 0 && calculation++ % m_CandidatesStride == 0;
+
+            GrindingWheelParams valueParams = { _Values.Diametr, _Values.Width, _Values.R1, _Values.R2,
+                                                _Values.Angle };
+            // Wheel axes are outer loops, so the shape changes much less often than the profile
+            if (!hasShapeParams || !(valueParams == params))
+            {
+                params = valueParams;
+                shapeParams = CalculateGrindingWheelSizes(params);
+                hasShapeParams = true;
+            }
+            GrindingWheelProfileParams profileParams = { _Values.OffsetToolCenter, _Values.OffsetToolAxis,
+                                                         _Values.RotationAngle };
+
+            result.Meta.Calculated++;
+
+            ParamsToFind calculated;
+            if (!CalculateParamsSingle(shapeParams, params, profileParams, m_Job.Tool, &calculated))
+            {
+                result.Meta.BadCalculations++;
+                return;
+            }
+
+            UpdateNearestParamsToFind(calculated, m_Job.ToFind, &result.NearestParamsToFind);
+
+            float delta = CalculateParamsDelta(calculated, m_Job.ToFind);
+            if (keepCandidate)
+            {
+                result.Candidates.Add(_Values, calculated, delta);
+            }
+            if (result.TopResults.size() < m_TopCount || delta < result.TopResults.back().Delta)
+            {
+                result.AddCandidate({ delta, MakeBestResult(params, profileParams, calculated) }, m_TopCount);
+            }
+        };
+
+        for (uint64_t block = _BlockBegin; block < _BlockEnd; block++)
+        {
+            calculation = block * m_CalculationsPerBlock;
+            if (m_Job.Sampling == SweepSampling::Grid)
+            {
+                SweepBlock(m_Job.Params, block, calculateSingle);
+            }
+            else
+            {
+                SweepHaltonBlock(m_Job.Params, m_Job.SamplesCount, block, calculateSingle);
+            }
+        }
+
+        return result;
+    }
+
+    uint64_t GetShardBlockBegin(uint64_t _BlocksCount, uint32_t _Shard, uint32_t _ShardsCount)
+    {
+        // 128 bit math is not portable, blocks count is far below 2^32 * 2^32 for any real grid
+        return uint64_t((long double)_BlocksCount * _Shard / _ShardsCount);
+    }
+
+}    // namespace LM
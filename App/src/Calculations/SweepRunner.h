@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <vector>
+
+#include "Calculations.h"
+#include "CandidateStore.h"
+#include "Sweep.h"
+
+namespace LM
+{
+
+    constexpr size_t kSweepDefaultTopCount = 100;
+
+    struct SweepJob
+    {
+        CalcParams Params;
+        ToolParams Tool;
+        ParamsToFind ToFind;
+
+        SweepSampling Sampling = SweepSampling::Grid;
+        // Evaluations budget of quasi-random sampling
+        uint64_t SamplesCount = 0;
+    };
+
+    struct SweepCandidate
+    {
+        float Delta = 0.0f;
+        BestResult Result;
+    };
+
+    struct SweepResult
+    {
+        ParamsToFind NearestParamsToFind = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                                             std::numeric_limits<float>::max() };
+        BestResultMeta Meta;
+
+        // Sorted by delta, lowest first. Candidates with equal delta keep the sweep order
+        std::vector<SweepCandidate> TopResults;
+
+        // Good calculations, filled only by runners with a candidates limit
+        CandidateStore Candidates;
+
+        void AddCandidate(const SweepCandidate& _Candidate, size_t _TopCount);
+
+        // _Other must come after this result in sweep order to keep the merge deterministic
+        void Merge(const SweepResult& _Other, const ParamsToFind& _ParamsToFind, size_t _TopCount);
+    };
+
+    // Chunk results of a block range. Completed chunks are merged in chunk order as soon as all previous chunks are
+    // completed, so only chunks completed out of order are kept separately. Can be saved as a checkpoint and continued
+    struct SweepProgress
+    {
+        uint64_t BlockBegin = 0;
+        uint64_t BlockEnd = 0;
+        uint32_t ChunksCount = 0;
+
+        uint32_t MergedChunks = 0;
+        SweepResult Merged;
+        std::map<uint32_t, SweepResult> Pending;
+
+        uint64_t GetChunkBlockBegin(uint32_t _Chunk) const;
+
+        bool IsChunkCompleted(uint32_t _Chunk) const { return _Chunk < MergedChunks || Pending.contains(_Chunk); }
+        bool IsCompleted() const { return MergedChunks == ChunksCount; }
+        uint32_t GetCompletedChunksCount() const { return MergedChunks + uint32_t(Pending.size()); }
+
+        void AddChunk(uint32_t _Chunk, SweepResult&& _Result, const ParamsToFind& _ParamsToFind, size_t _TopCount);
+    };
+
+    class SweepRunner
+    {
+    public:
+        // Good calculations are kept in SweepResult::Candidates in sweep order. Every N-th calculation of the sweep is
+        // kept, N is chosen so that the whole sweep fits in _CandidatesLimit
+        SweepRunner(const SweepJob& _Job, size_t _TopCount = kSweepDefaultTopCount, size_t _CandidatesLimit = 0);
+
+        uint64_t GetBlocksCount() const { return m_BlocksCount; }
+        uint64_t GetCalculationsCount() const { return m_CalculationsCount; }
+
+        const SweepJob& GetJob() const { return m_Job; }
+        size_t GetTopCount() const { return m_TopCount; }
+        size_t GetCandidatesLimit() const { return m_CandidatesLimit; }
+
+        // Runs blocks [_BlockBegin, _BlockEnd). Blocks are split in chunks that run in parallel, chunk results are
+        // merged in chunk order, so the result doesn't depend on threads count
+        SweepResult Run(uint64_t _BlockBegin, uint64_t _BlockEnd, bool _Parallel = true) const;
+        SweepResult Run(bool _Parallel = true) const { return Run(0, m_BlocksCount, _Parallel); }
+
+        // Splits blocks [_BlockBegin, _BlockEnd) in chunks. Checkpointed runs use smaller chunks, so less work is lost
+        SweepProgress CreateProgress(uint64_t _BlockBegin, uint64_t _BlockEnd, bool _Parallel = true,
+                                     bool _SmallChunks = false) const;
+
+        // Runs chunks of _Progress that are not completed yet. _OnChunkCompleted is called under a lock after every
+        // chunk, e.g. to save a checkpoint, so other chunks wait for it and it must not do any long work. Chunks are not
+        // started after _Cancel is set, _Progress then keeps the completed ones
+        SweepResult Run(SweepProgress& _Progress, bool _Parallel = true,
+                        const std::function<void(const SweepProgress&)>& _OnChunkCompleted = {},
+                        const std::atomic<bool>* _Cancel = nullptr) const;
+
+        SweepResult RunBlocks(uint64_t _BlockBegin, uint64_t _BlockEnd) const;
+
+    protected:
+        SweepJob m_Job;
+        size_t m_TopCount;
+        size_t m_CandidatesLimit;
+        uint64_t m_CandidatesStride = 1;
+
+        uint64_t m_BlocksCount;
+        uint64_t m_CalculationsCount;
+        uint64_t m_CalculationsPerBlock;
+    };
+
+    // Shard _Shard of _ShardsCount runs blocks [GetShardBlockBegin(_Shard), GetShardBlockBegin(_Shard + 1))
+    uint64_t GetShardBlockBegin(uint64_t _BlocksCount, uint32_t _Shard, uint32_t _ShardsCount);
+
+}    // namespace LM
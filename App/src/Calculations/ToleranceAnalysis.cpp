@@ -0,0 +1,253 @@
+#include "ToleranceAnalysis.h"
+
+#include <algorithm>
+#include <chrono>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <random>
+
+namespace LM
+{
+
+    // Chunk size doesn't depend on threads count, so every sample gets the same random values on any machine
+    constexpr uint64_t kToleranceSamplesPerChunk = 16384;
+    constexpr uint64_t kToleranceProgressStep = 256;
+
+    const char* GetToleranceInputName(ToleranceInput _Input)
+    {
+        switch (_Input)
+        {
+            case ToleranceInput::WheelDiametr: return "Wheel Diametr";
+            case ToleranceInput::WheelWidth: return "Wheel Width";
+            case ToleranceInput::WheelR1: return "Wheel R1";
+            case ToleranceInput::WheelR2: return "Wheel R2";
+            case ToleranceInput::WheelAngle: return "Wheel Angle";
+            case ToleranceInput::OffsetToolCenter: return "Offset Tool Center";
+            case ToleranceInput::OffsetToolAxis: return "Offset Tool Axis";
+            case ToleranceInput::RotationAngle: return "Rotation Angle";
+            case ToleranceInput::ToolAngle: return "Tool Angle";
+            default: return "Unknown";
+        }
+    }
+
+    static float SampleDeviation(const ToleranceInputParams& _Input, std::mt19937_64& _Engine)
+    {
+        if (!(_Input.Tolerance > 0.0f))
+        {
+            return 0.0f;
+        }
+
+        if (_Input.Distribution == ToleranceDistribution::Uniform)
+        {
+            return std::uniform_real_distribution<float>(-_Input.Tolerance, _Input.Tolerance)(_Engine);
+        }
+        return std::normal_distribution<float>(0.0f, _Input.Tolerance / 3.0f)(_Engine);
+    }
+
+    static bool CalculateSample(const BestResult& _Nominal, const ToolParams& _Tool, const ParamsToFind& _ToFind,
+                                const std::array<float, kToleranceInputsCount>& _Deviations, ParamsToFind* _Result)
+    {
+        auto deviation = [&](ToleranceInput _Input) { return _Deviations[uint32_t(_Input)]; };
+
+        GrindingWheelParams wheelParams = {
+            _Nominal.Diametr + deviation(ToleranceInput::WheelDiametr),
+            _Nominal.Width + deviation(ToleranceInput::WheelWidth),
+            glm::max(_Nominal.R1 + deviation(ToleranceInput::WheelR1), 0.0f),
+            glm::max(_Nominal.R2 + deviation(ToleranceInput::WheelR2), 0.0f),
+            _Nominal.Angle + deviation(ToleranceInput::WheelAngle),
+        };
+        GrindingWheelProfileParams profileParams = {
+            _Nominal.OffsetToolCenter + deviation(ToleranceInput::OffsetToolCenter),
+            _Nominal.OffsetToolAxis + deviation(ToleranceInput::OffsetToolAxis),
+            _Nominal.RotationAngle + deviation(ToleranceInput::RotationAngle),
+        };
+        ToolParams toolParams = _Tool;
+        toolParams.Angle += deviation(ToleranceInput::ToolAngle);
+
+        float lowestDelta = std::numeric_limits<float>::max();
+        ParamsToFind nearestParamsToFind = { lowestDelta, lowestDelta, lowestDelta };
+        BestResult bestResult;
+        BestResultMeta meta;
+        CalculateBestResultSingle(wheelParams, profileParams, toolParams, _ToFind, &nearestParamsToFind,
+                                  &lowestDelta, &bestResult, &meta);
+        if (!meta.HasBestResult)
+        {
+            return false;
+        }
+
+        *_Result = { bestResult.FrontAngle, bestResult.StepAngle, bestResult.DiametrIn };
+        return true;
+    }
+
+    // Sorts _Values
+    static ToleranceOutputStats CalculateOutputStats(std::vector<float>& _Values, float _Nominal, uint32_t _BinsCount)
+    {
+        ToleranceOutputStats stats;
+        stats.Nominal = _Nominal;
+        if (_Values.empty())
+        {
+            return stats;
+        }
+
+        std::sort(std::execution::par_unseq, _Values.begin(), _Values.end());
+
+        double sum = 0.0;
+        double sumSquared = 0.0;
+        for (float value : _Values)
+        {
+            sum += value;
+            sumSquared += double(value) * value;
+        }
+        double mean = sum / double(_Values.size());
+        stats.Mean = float(mean);
+        stats.StdDev = float(glm::sqrt(glm::max(sumSquared / double(_Values.size()) - mean * mean, 0.0)));
+        stats.Min = _Values.front();
+        stats.Max = _Values.back();
+
+        for (uint32_t i = 0; i < kTolerancePercentilesCount; i++)
+        {
+            size_t index = size_t(glm::round(double(kTolerancePercentiles[i]) / 100.0 * double(_Values.size() - 1)));
+            stats.Percentiles[i] = _Values[index];
+        }
+
+        const uint32_t binsCount = glm::max(_BinsCount, 1u);
+        double min = stats.Min;
+        double width = (double(stats.Max) - min) / binsCount;
+        if (!(width > 0.0))
+        {
+            // All samples are the same, one bin around them
+            width = glm::max(glm::abs(min) * 1e-6, 1e-6);
+            min -= width * binsCount / 2.0;
+        }
+
+        stats.BinWidth = width;
+        stats.Bins.assign(binsCount, 0.0);
+        stats.BinCenters.resize(binsCount);
+        for (uint32_t bin = 0; bin < binsCount; bin++)
+        {
+            stats.BinCenters[bin] = min + (double(bin) + 0.5) * width;
+        }
+        for (float value : _Values)
+        {
+            uint32_t bin = uint32_t(glm::clamp((double(value) - min) / width, 0.0, double(binsCount - 1)));
+            stats.Bins[bin] += 1.0;
+        }
+        for (double& bin : stats.Bins)
+        {
+            bin /= double(_Values.size());
+        }
+
+        return stats;
+    }
+
+    ToleranceAnalysisParams MakeToleranceAnalysisParams(const ToleranceAnalysisParams& _Tolerances, const SweepJob& _Job,
+                                                        const BestResult& _Nominal)
+    {
+        ToleranceAnalysisParams params = _Tolerances;
+        params.Nominal = _Nominal;
+        params.Tool = _Job.Tool;
+        params.ToFind = _Job.ToFind;
+        return params;
+    }
+
+    ToleranceAnalysisResult RunToleranceAnalysis(const ToleranceAnalysisParams& _Params,
+                                                 ToleranceAnalysisProgress* _Progress)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        ToleranceAnalysisResult result;
+
+        ParamsToFind nominal = {};
+        result.ToFind = _Params.ToFind;
+        result.HasNominal = CalculateSample(_Params.Nominal, _Params.Tool, _Params.ToFind, {}, &nominal);
+
+        const uint64_t chunksCount = (_Params.SamplesCount + kToleranceSamplesPerChunk - 1) / kToleranceSamplesPerChunk;
+        std::vector<std::vector<ParamsToFind>> chunkOutputs(chunksCount);
+        std::vector<uint64_t> chunkCalculated(chunksCount, 0);
+        std::vector<uint64_t> chunkArr(chunksCount);
+        std::iota(chunkArr.begin(), chunkArr.end(), 0);
+
+        auto runChunk = [&](uint64_t _Chunk) {
+            std::seed_seq seed = { uint32_t(_Params.Seed), uint32_t(_Params.Seed >> 32), uint32_t(_Chunk),
+                                   uint32_t(_Chunk >> 32) };
+            std::mt19937_64 engine(seed);
+
+            uint64_t sampleBegin = _Chunk * kToleranceSamplesPerChunk;
+            uint64_t sampleEnd = glm::min(sampleBegin + kToleranceSamplesPerChunk, _Params.SamplesCount);
+            std::vector<ParamsToFind>& outputs = chunkOutputs[_Chunk];
+            outputs.reserve(sampleEnd - sampleBegin);
+
+            // Progress is shared by all threads, so it is updated once per kToleranceProgressStep samples
+            uint64_t notReported = 0;
+            for (uint64_t sample = sampleBegin; sample < sampleEnd; sample++)
+            {
+                if (_Progress && notReported == kToleranceProgressStep)
+                {
+                    _Progress->Calculated += notReported;
+                    notReported = 0;
+                    if (_Progress->Cancel)
+                    {
+                        break;
+                    }
+                }
+
+                std::array<float, kToleranceInputsCount> deviations;
+                for (uint32_t input = 0; input < kToleranceInputsCount; input++)
+                {
+                    deviations[input] = SampleDeviation(_Params.Inputs[input], engine);
+                }
+
+                ParamsToFind output;
+                if (CalculateSample(_Params.Nominal, _Params.Tool, _Params.ToFind, deviations, &output))
+                {
+                    outputs.push_back(output);
+                }
+                chunkCalculated[_Chunk]++;
+                notReported++;
+            }
+
+            if (_Progress)
+            {
+                _Progress->Calculated += notReported;
+            }
+        };
+
+        // Chunks update the shared progress atomics, so they can't run unsequenced
+        std::for_each(std::execution::par, chunkArr.begin(), chunkArr.end(), runChunk);
+
+        size_t goodCount = 0;
+        for (uint64_t chunk = 0; chunk < chunksCount; chunk++)
+        {
+            result.Calculated += chunkCalculated[chunk];
+            goodCount += chunkOutputs[chunk].size();
+        }
+        result.BadCalculations = result.Calculated - goodCount;
+
+        std::vector<float> frontAngles;
+        std::vector<float> stepAngles;
+        std::vector<float> diametrsIn;
+        frontAngles.reserve(goodCount);
+        stepAngles.reserve(goodCount);
+        diametrsIn.reserve(goodCount);
+        for (const std::vector<ParamsToFind>& outputs : chunkOutputs)
+        {
+            for (const ParamsToFind& output : outputs)
+            {
+                frontAngles.push_back(output.FrontAngle);
+                stepAngles.push_back(output.StepAngle);
+                diametrsIn.push_back(output.DiametrIn);
+            }
+        }
+
+        result.FrontAngle = CalculateOutputStats(frontAngles, nominal.FrontAngle, _Params.BinsCount);
+        result.StepAngle = CalculateOutputStats(stepAngles, nominal.StepAngle, _Params.BinsCount);
+        result.DiametrIn = CalculateOutputStats(diametrsIn, nominal.DiametrIn, _Params.BinsCount);
+
+        auto endTime = std::chrono::steady_clock::now();
+        result.CalculationMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        return result;
+    }
+
+}    // namespace LM
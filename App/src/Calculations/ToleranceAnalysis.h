@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "Calculations.h"
+#include "SweepRunner.h"
+
+namespace LM
+{
+
+    // Machine setup inputs of a best result which get perturbed
+    enum class ToleranceInput
+    {
+        WheelDiametr = 0,
+        WheelWidth,
+        WheelR1,
+        WheelR2,
+        WheelAngle,
+        OffsetToolCenter,
+        OffsetToolAxis,
+        RotationAngle,
+        ToolAngle,
+
+        Count
+    };
+
+    constexpr uint32_t kToleranceInputsCount = uint32_t(ToleranceInput::Count);
+
+    const char* GetToleranceInputName(ToleranceInput _Input);
+
+    enum class ToleranceDistribution
+    {
+        // Any value in [-Tolerance, Tolerance]
+        Uniform = 0,
+        // Tolerance is 3 sigma, about 0.27% of the samples are outside of it
+        Normal,
+    };
+
+    struct ToleranceInputParams
+    {
+        float Tolerance = 0.0f;
+        ToleranceDistribution Distribution = ToleranceDistribution::Normal;
+    };
+
+    struct ToleranceAnalysisParams
+    {
+        // Nominal result with the tool and targets of the sweep which found it
+        BestResult Nominal;
+        ToolParams Tool = {};
+        ParamsToFind ToFind;
+        std::array<ToleranceInputParams, kToleranceInputsCount> Inputs = {};
+
+        uint64_t SamplesCount = 1000000;
+        uint64_t Seed = 0;
+        uint32_t BinsCount = 64;
+    };
+
+    // Analysis of _Nominal, a result of _Job, with the tool and targets of the job and inputs of _Tolerances
+    ToleranceAnalysisParams MakeToleranceAnalysisParams(const ToleranceAnalysisParams& _Tolerances, const SweepJob& _Job,
+                                                        const BestResult& _Nominal);
+
+    constexpr uint32_t kTolerancePercentilesCount = 5;
+    constexpr float kTolerancePercentiles[kTolerancePercentilesCount] = { 1.0f, 5.0f, 50.0f, 95.0f, 99.0f };
+
+    struct ToleranceOutputStats
+    {
+        float Nominal = 0.0f;
+        float Mean = 0.0f;
+        float StdDev = 0.0f;
+        float Min = 0.0f;
+        float Max = 0.0f;
+        std::array<float, kTolerancePercentilesCount> Percentiles = {};
+
+        // BinsCount bins of equal width from Min to Max, Bins[i] is a share of good samples
+        std::vector<double> BinCenters;
+        std::vector<double> Bins;
+        double BinWidth = 0.0;
+    };
+
+    struct ToleranceAnalysisResult
+    {
+        uint64_t Calculated = 0;
+        uint64_t BadCalculations = 0;
+        bool HasNominal = false;
+        ParamsToFind ToFind;
+
+        ToleranceOutputStats FrontAngle;
+        ToleranceOutputStats StepAngle;
+        ToleranceOutputStats DiametrIn;
+
+        double CalculationMs = 0.0;
+    };
+
+    // Written by the analysis while it runs, can be read and cancelled from another thread
+    struct ToleranceAnalysisProgress
+    {
+        std::atomic<uint64_t> Calculated = 0;
+        std::atomic<bool> Cancel = false;
+    };
+
+    // Evaluates _Params.SamplesCount perturbations of the nominal result with CalculateBestResultSingle. Samples are
+    // split in chunks of a fixed size which run in parallel, every chunk has its own random engine seeded by the seed
+    // and the chunk index, so the result doesn't depend on threads count. A cancelled analysis returns what has been
+    // calculated so far
+    ToleranceAnalysisResult RunToleranceAnalysis(const ToleranceAnalysisParams& _Params,
+                                                 ToleranceAnalysisProgress* _Progress = nullptr);
+
+}    // namespace LM
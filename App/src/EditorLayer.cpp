@@ -2,11 +2,17 @@
 
 #include <algorithm>
 #include <execution>
+#include <optional>
 
+#include "Engine/Core/Application.h"
 #include "Engine/ImGui/Plots/implot.h"
 
 #include "Calculations/Steps.h"
+#include "Calculations/Sweep.h"
+#include "Calculations/SweepFiles.h"
+#include "Calculations/SweepRunner.h"
 #include "Graphics/GraphicsUtils.h"
+#include "Graphics/WheelMesh.h"
 #include "Gui/CustomGui.h"
 #include "Math/Angle.h"
 #include "Math/Intersections.h"
@@ -20,10 +26,12 @@
 namespace LM
 {
 
-    const size_t kSections = 36;
+    // Output framebuffer grows in these steps and shrinks only when it is twice bigger than needed
+    constexpr uint32_t kFrameBufferSizeStep = 128;
     const float PI = glm::pi<float>();
     constexpr float kMaxFloat = std::numeric_limits<float>::max();
     constexpr float kMinFloat = std::numeric_limits<float>::lowest();
+    constexpr float kPlotPickPixels = 6.0f;
 
     static int MetricFormatter(double value, char* buff, int size, void* data)
     {
@@ -44,38 +52,27 @@ namespace LM
         return snprintf(buff, size, "%g %s%s", value / v[6], p[6], unit);
     }
 
-    template <typename T>
-    int BinarySearch(const T* arr, int l, int r, T x)
+    static bool ComboCandidateColumn(const char* _Label, CandidateColumn* _Column)
     {
-        if (r >= l)
+        bool changed = false;
+        if (ImGui::BeginCombo(_Label, GetCandidateColumnName(*_Column)))
         {
-            int mid = l + (r - l) / 2;
-            if (arr[mid] == x)
+            for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
             {
-                return mid;
-            }
-            if (arr[mid] > x)
-            {
-                return BinarySearch(arr, l, mid - 1, x);
-            }
-            return BinarySearch(arr, mid + 1, r, x);
-        }
-        return -1;
-    }
-
-    static int InsideItemId(const std::vector<double>& XArr, double _MousePosX, double _Delta)
-    {
-        for (int i = 0; i < XArr.size(); i++)
-        {
-            if (glm::abs(XArr[i] - _MousePosX) < _Delta)
-            {
-                return i;
+                bool selected = uint32_t(*_Column) == column;
+                if (ImGui::Selectable(GetCandidateColumnName(CandidateColumn(column)), selected) && !selected)
+                {
+                    *_Column = CandidateColumn(column);
+                    changed = true;
+                }
             }
+            ImGui::EndCombo();
         }
-        return -1;
+        return changed;
     }
 
-    static void DrawTooltip(const std::vector<double>& xs, const std::vector<double>& frontAngle,
+    // Returns the index of the hovered point, xs are sorted
+    static int64_t DrawTooltip(const std::vector<double>& xs, const std::vector<double>& frontAngle,
                             const std::vector<double>& stepAngle, const std::vector<double>& diametrIn,
                             float width_percent)
     {
@@ -84,6 +81,7 @@ namespace LM
         // calc real value width
 
         // custom tool
+        int64_t idx = -1;
         if (ImPlot::IsPlotHovered())
         {
             ImPlotPoint mouse = ImPlot::GetPlotMousePos();
@@ -96,7 +94,7 @@ namespace LM
             draw_list->AddRectFilled(ImVec2(tool_l, tool_t), ImVec2(tool_r, tool_b), IM_COL32(128, 128, 128, 64));
             ImPlot::PopPlotClipRect();
             // find mouse location index
-            int idx = InsideItemId(xs, mouse.x, width_percent);
+            idx = FindNearestSorted(xs.data(), xs.size(), mouse.x, width_percent);
             // render tool tip (won't be affected by plot clip rect)
             if (idx != -1)
             {
@@ -108,6 +106,7 @@ namespace LM
                 ImGui::EndTooltip();
             }
         }
+        return idx;
     }
 
     void EditorLayer::OnAttach()
@@ -136,10 +135,10 @@ namespace LM
         m_GrindingWheelCalcParams.Max.OffsetToolAxis = 20.0f;
         m_GrindingWheelCalcParams.Max.RotationAngle = 65.0f;
 
-        m_GrindingWheelCalcParams.Steps.Diametr = 4;
-        m_GrindingWheelCalcParams.Steps.Width = 70;
-        m_GrindingWheelCalcParams.Steps.R1 = 16;
-        m_GrindingWheelCalcParams.Steps.R2 = 4;
+        m_GrindingWheelCalcParams.Steps.Diametr = 0;
+        m_GrindingWheelCalcParams.Steps.Width = 0;
+        m_GrindingWheelCalcParams.Steps.R1 = 0;
+        m_GrindingWheelCalcParams.Steps.R2 = 0;
         m_GrindingWheelCalcParams.Steps.Angle = 15;
         m_GrindingWheelCalcParams.Steps.OffsetToolCenter = 40;
         m_GrindingWheelCalcParams.Steps.OffsetToolAxis = 40;
@@ -171,6 +170,19 @@ namespace LM
         m_GrindingWheelProfileParams.OffsetToolAxis = 0.0f;
         m_GrindingWheelProfileParams.RotationAngle = 65.0f;
 
+        auto setTolerance = [this](ToleranceInput _Input, float _Tolerance) {
+            m_ToleranceParams.Inputs[uint32_t(_Input)].Tolerance = _Tolerance;
+        };
+        setTolerance(ToleranceInput::WheelDiametr, 0.1f);
+        setTolerance(ToleranceInput::WheelWidth, 0.05f);
+        setTolerance(ToleranceInput::WheelR1, 0.05f);
+        setTolerance(ToleranceInput::WheelR2, 0.05f);
+        setTolerance(ToleranceInput::WheelAngle, 0.1f);
+        setTolerance(ToleranceInput::OffsetToolCenter, 0.02f);
+        setTolerance(ToleranceInput::OffsetToolAxis, 0.02f);
+        setTolerance(ToleranceInput::RotationAngle, 0.05f);
+        setTolerance(ToleranceInput::ToolAngle, 0.05f);
+
         SetAutoCameraZoom();
 
         m_Shader = Shader::Create(ShaderLayout(
@@ -180,124 +192,241 @@ namespace LM
             { { ShaderSource::Type::VERTEX, ShaderSource::FromFile("assets/shaders/test.vert") },
               { ShaderSource::Type::FRAGMENT, ShaderSource::FromFile("assets/shaders/test.frag") } }));
 
-        CreateGrindingWheelShape();
-        CreateToolShape();
+        m_OverlayShader = Shader::Create(ShaderLayout(
+            {
+                {ShaderDataType::Float4, "a_Position"},
+                {   ShaderDataType::Int, "a_InstanceId"},
+        },
+            { { ShaderSource::Type::VERTEX, ShaderSource::FromFile("assets/shaders/wheel_overlay.vert") },
+              { ShaderSource::Type::FRAGMENT, ShaderSource::FromFile("assets/shaders/wheel_overlay.frag") } }));
 
-        m_FrameBuffer = FrameBuffer::Create({ 2048, 2048, { FrameBufferColorMASK::NONE }, FrameBufferMASK::DEPTH });
-    }
+        const ShaderLoadStats& shaderStats = Shader::GetLoadStats();
+        LOGI("Shaders startup: ", shaderStats.TotalMs, " ms, from cache: ", shaderStats.CacheHits,
+             ", compiled: ", shaderStats.Compiled);
 
-    void EditorLayer::OnDetach() { }
+        for (const Ref<Shader>& shader : { m_Shader, m_OverlayShader })
+        {
+            for (const ShaderSource& source : shader->GetLayout().GetSources())
+            {
+                if (source.GetLoadType() == ShaderSource::LoadType::FILEPATH)
+                {
+                    m_ShaderWatcher.Watch(source.GetSource());
+                }
+            }
+        }
+        m_ShaderWatcher.SetOnChanged([]() { Application::Get().RequestRedraw(); });
 
-    void EditorLayer::Calculate()
-    {
-        auto startTime = std::chrono::system_clock::now();
+        m_CameraUniformBuffer = UniformBuffer::Create(sizeof(CameraUniforms));
+        m_ModelMatrixUniform = m_Shader->GetUniform("u_ModelMatrix");
+        m_ColorUniform = m_Shader->GetUniform("u_Color");
+
+        m_CurveTolerance = GetCurveTolerance(m_CameraZoom, kFrameBufferSizeStep);
+        CreateGrindingWheelShape();
+        CreateToolShape();
 
-        std::vector<int> diametrStepArr = GenSteps(m_GrindingWheelCalcParams.Steps.Diametr);
-        std::vector<int> widthStepArr = GenSteps(m_GrindingWheelCalcParams.Steps.Width);
-        std::vector<int> r1StepArr = GenSteps(m_GrindingWheelCalcParams.Steps.R1);
-        std::vector<int> r2StepArr = GenSteps(m_GrindingWheelCalcParams.Steps.R2);
-        std::vector<int> angleStepArr = GenSteps(m_GrindingWheelCalcParams.Steps.Angle);
-        std::vector<int> offsetToolCenterStepArr = GenSteps(m_GrindingWheelCalcParams.Steps.OffsetToolCenter);
-        std::vector<int> offsetToolAxisStepArr = GenSteps(m_GrindingWheelCalcParams.Steps.OffsetToolAxis);
-        std::vector<int> rotationAngleStepArr = GenSteps(m_GrindingWheelCalcParams.Steps.RotationAngle);
+        m_WheelEnvelope.SetOnReady([]() { Application::Get().RequestRedraw(); });
+        m_Heatmap.SetOnUpdated([]() { Application::Get().RequestRedraw(); });
 
-        int maxCalculations =
-            (m_GrindingWheelCalcParams.Steps.Diametr + 1) * (m_GrindingWheelCalcParams.Steps.Width + 1) *
-            (m_GrindingWheelCalcParams.Steps.R1 + 1) * (m_GrindingWheelCalcParams.Steps.R2 + 1) *
-            (m_GrindingWheelCalcParams.Steps.Angle + 1) * (m_GrindingWheelCalcParams.Steps.OffsetToolCenter + 1) *
-            (m_GrindingWheelCalcParams.Steps.OffsetToolAxis + 1) * (m_GrindingWheelCalcParams.Steps.RotationAngle + 1);
+        m_FrameBuffer = FrameBuffer::Create(
+            { kFrameBufferSizeStep, kFrameBufferSizeStep, { FrameBufferColorMASK::NONE }, FrameBufferMASK::DEPTH });
+    }
 
-        // m_CalculationResults.clear();
+    void EditorLayer::OnDetach()
+    {
+        if (m_CalculationFuture.valid())
+        {
+            m_CalculationProgress.Cancel = true;
+            m_CalculationFuture.wait();
+        }
+        if (m_ToleranceFuture.valid())
+        {
+            m_ToleranceProgress.Cancel = true;
+            m_ToleranceFuture.wait();
+        }
+    }
 
-        ParamsToFind paramsToFind;
-        paramsToFind.FrontAngle = 5.0f;
-        paramsToFind.StepAngle = 50.0f;
-        paramsToFind.DiametrIn = 75.0f;
+    SweepJob EditorLayer::CreateSweepJob() const
+    {
+        SweepJob job;
+        job.ToFind.FrontAngle = 5.0f;
+        job.ToFind.StepAngle = 50.0f;
+        job.ToFind.DiametrIn = 75.0f;
+        job.Tool = m_ToolParams;
 
-        int theadsCount = m_GrindingWheelCalcParams.Steps.Angle + 1;
+        const float resultAxisOffset = glm::sin(glm::radians(job.ToFind.FrontAngle)) * (m_ToolParams.Diametr / 2.0f);
 
-        std::vector<float> lowestDeltaArr(theadsCount, kMaxFloat);
+        // Axis offset is defined by the front angle to find, so it is a constant axis of the sweep
+        job.Params = m_GrindingWheelCalcParams;
+        job.Params.Min.OffsetToolAxis = resultAxisOffset;
+        job.Params.Max.OffsetToolAxis = resultAxisOffset;
+        job.Params.Steps.OffsetToolAxis = 0;
 
-        std::vector<ParamsToFind> nearestParamsToFindArr(theadsCount, { kMaxFloat, kMaxFloat, kMaxFloat });
+        job.Sampling = m_SweepSampling;
+        job.SamplesCount = uint64_t(m_SamplesCount);
 
-        std::vector<BestResult> bestResultArr(theadsCount, BestResult());
-        std::vector<BestResultMeta> metaArr(theadsCount, BestResultMeta());
+        return job;
+    }
 
-#define SH_FOR(var, Var) std::for_each(var##StepArr.begin(), var##StepArr.end(), [=, &lowestDelta, &nearestParamsToFind, &bestResult, &meta](int var##Step) { \
-            float var = ValueByStep(m_GrindingWheelCalcParams.Min.Var, m_GrindingWheelCalcParams.Max.Var, var##Step, m_GrindingWheelCalcParams.Steps.Var);
-#define SH_FOR_END                                                                                                     \
-    })
+    void EditorLayer::Calculate(bool _Resume)
+    {
+        if (m_CalculationFuture.valid())
+        {
+            return;
+        }
 
-        const float resultAxisOffset = glm::sin(glm::radians(paramsToFind.FrontAngle)) * (m_ToolParams.Diametr / 2.0f);
+        // Resumed calculation continues the job from the checkpoint with its top count and candidates limit, not the
+        // current inputs, so the result is the same as of an uninterrupted run
+        SweepCheckpoint checkpoint;
+        checkpoint.Job = CreateSweepJob();
+        checkpoint.TopCount = size_t(m_TopResultsCount);
+        checkpoint.CandidatesLimit = size_t(m_CandidatesLimit);
+        std::filesystem::path checkpointPath = m_CheckpointPath;
+        bool useCheckpoint = m_UseCheckpoint || _Resume;
+        bool smallChunks = m_UseCheckpoint;
+
+        m_CalculationProgress.CompletedChunks = 0;
+        m_CalculationProgress.ChunksCount = 0;
+        m_CalculationProgress.Cancel = false;
+        m_CalculationFuture = std::async(std::launch::async, [this, _Resume, checkpoint = std::move(checkpoint),
+                                                              checkpointPath, useCheckpoint, smallChunks]() mutable {
+            auto startTime = std::chrono::system_clock::now();
+
+            SweepCalculation calculation;
+            if (_Resume && !LoadSweepCheckpoint(checkpointPath, &checkpoint))
+            {
+                LOGE("Can't resume calculation from: ", checkpointPath.string());
+                Application::Get().RequestRedraw();
+                return calculation;
+            }
 
-        LOGD();
-        std::for_each(
-            std::execution::par_unseq, angleStepArr.begin(), angleStepArr.end(),
-            [=, &lowestDeltaArr, &nearestParamsToFindArr, &bestResultArr, &metaArr](int angleStep) {
-                float angle = ValueByStep(m_GrindingWheelCalcParams.Min.Angle, m_GrindingWheelCalcParams.Max.Angle,
-                                          angleStep, m_GrindingWheelCalcParams.Steps.Angle);
+            calculation.Job = checkpoint.Job;
+            SweepRunner runner(checkpoint.Job, checkpoint.TopCount, checkpoint.CandidatesLimit);
 
-                float& lowestDelta = lowestDeltaArr[angleStep];
-                ParamsToFind& nearestParamsToFind = nearestParamsToFindArr[angleStep];
-                BestResult& bestResult = bestResultArr[angleStep];
-                BestResultMeta& meta = metaArr[angleStep];
+            LOGI("Calculations: ", runner.GetCalculationsCount(), ", blocks: ", runner.GetBlocksCount(),
+                 ", top results: ", runner.GetTopCount(), ", candidates limit: ", runner.GetCandidatesLimit());
 
+            SweepProgress& progress = checkpoint.Progress;
+            if (!_Resume)
+            {
+                progress = runner.CreateProgress(0, runner.GetBlocksCount(), true, smallChunks);
+            }
+            m_CalculationProgress.CompletedChunks = progress.GetCompletedChunksCount();
+            m_CalculationProgress.ChunksCount = progress.ChunksCount;
 
+            std::optional<SweepCheckpointWriter> checkpointWriter;
+            if (useCheckpoint)
+            {
+                checkpointWriter.emplace(checkpointPath, runner);
+            }
 
-                LOGI("Calculating block for angle: ", angle);
-                float diametr = 10000.0f;
-                float width = 10000.0f;
+            calculation.Result = runner.Run(
+                progress, true,
+                [this, &checkpointWriter](const SweepProgress& _Progress) {
+                    m_CalculationProgress.CompletedChunks = _Progress.GetCompletedChunksCount();
+                    if (checkpointWriter)
+                    {
+                        checkpointWriter->OnChunkCompleted(_Progress);
+                    }
+                    Application::Get().RequestRedraw();
+                },
+                &m_CalculationProgress.Cancel);
+            calculation.IsCompleted = progress.IsCompleted();
 
-                // TODO: later add r1 and r2 to calculations
-                float r1 = 0;
-                float r2 = 0;
+            // Cancelled calculation keeps its completed chunks in the checkpoint, so it can be resumed
+            if (checkpointWriter && !calculation.IsCompleted)
+            {
+                checkpointWriter->Save(progress);
+            }
 
-                //SH_FOR(diametr, Diametr)
-                //SH_FOR(r1, R1)
-                //SH_FOR(r2, R2)
-                //SH_FOR(angle, Angle)
-                SH_FOR(offsetToolCenter, OffsetToolCenter)
-                //SH_FOR(offsetToolAxis, OffsetToolAxis)
-                SH_FOR(rotationAngle, RotationAngle)
+            auto endTime = std::chrono::system_clock::now();
 
-                GrindingWheelParams params = { diametr, width, r1, r2, angle };
-                GrindingWheelProfileParams profileParams = { offsetToolCenter, resultAxisOffset, rotationAngle };
+            LOGI(calculation.IsCompleted ? "Calculation Time: " : "Calculation cancelled after: ",
+                 std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() / 1000.0, "s");
 
-                CalculateBestResultSingle(params, profileParams, m_ToolParams, paramsToFind, &nearestParamsToFind,
-                                          &lowestDelta, &bestResult, &meta);
+            Application::Get().RequestRedraw();
+            return calculation;
+        });
+    }
 
-                SH_FOR_END;
-                SH_FOR_END;
-                //SH_FOR_END;
-                //SH_FOR_END;
-                //SH_FOR_END;
-                //SH_FOR_END;
-            });
+    void EditorLayer::UpdateCalculation()
+    {
+        if (!m_CalculationFuture.valid() ||
+            m_CalculationFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return;
+        }
 
-        LOGD();
+        SweepCalculation calculation = m_CalculationFuture.get();
+        if (calculation.IsCompleted)
+        {
+            SetSweepResult(calculation.Job, calculation.Result);
+        }
+    }
 
-        float lowestDelta = lowestDeltaArr[0];
-        m_BestResult = bestResultArr[0];
-        m_HasBestResult = metaArr[0].HasBestResult;
+    void EditorLayer::SetSweepResult(const SweepJob& _Job, const SweepResult& _Result)
+    {
+        m_SweepJob = _Job;
+        m_TopResults = _Result.TopResults;
+        m_HasBestResult = !m_TopResults.empty();
+        if (m_HasBestResult)
+        {
+            m_BestResult = m_TopResults.front().Result;
+        }
+        m_TopResultsOverlay.SetWheels(m_TopResults, size_t(m_TopResultsDrawCount));
+        m_ViewDirty = true;
+
+        m_Candidates = _Result.Candidates;
+        m_ScatterLodDirty = true;
+        m_LineLodDirty = true;
+        m_CandidateFilter.Build(m_Candidates);
+        m_ParallelLinesDirty = true;
+        m_BrushColumn = -1;
+        m_PlotSelection.Clear(PlotSource::Candidates);
+
+        m_HasRefinementResult = false;
+    }
 
-        for (int i = 1; i <= m_GrindingWheelCalcParams.Steps.Angle; i++)
+    void EditorLayer::RefineSweepResult()
+    {
+        if (!m_HasBestResult)
         {
-            if (lowestDeltaArr[i] < lowestDelta)
-            {
-                lowestDelta = lowestDeltaArr[i];
-                m_BestResult = bestResultArr[i];
-                m_HasBestResult = metaArr[i].HasBestResult;
-            }
+            return;
         }
 
-#define SH_VALUE_BY_STEP(var, Var)                                                                                     \
-    ValueByStep(m_GrindingWheelCalcParams.Min.Var, m_GrindingWheelCalcParams.Max.Var, var##Step,                       \
-                m_GrindingWheelCalcParams.Steps.Var)
+        // Top results are refined for the problem they were scored on, not the current inputs
+        m_RefinementResult =
+            RefineTopResults(MakeRefinementParams(m_SweepJob), m_TopResults, size_t(m_RefinedResultsCount));
+        m_HasRefinementResult = true;
+        LOGI("Refinement: ", m_RefinementResult.Improved, " of ", m_RefinementResult.Refined,
+             " results improved, evaluations: ", m_RefinementResult.Evaluations,
+             ", time: ", m_RefinementResult.CalculationMs, "ms");
+
+        // Refined results replace the grid ones, the candidates plots keep the grid values
+        m_TopResults = std::move(m_RefinementResult.TopResults);
+        m_BestResult = m_TopResults.front().Result;
+        m_TopResultsOverlay.SetWheels(m_TopResults, size_t(m_TopResultsDrawCount));
+        m_ViewDirty = true;
+    }
 
-        auto endTime = std::chrono::system_clock::now();
+    void EditorLayer::StartToleranceAnalysis()
+    {
+        if (!m_HasBestResult || m_ToleranceFuture.valid())
+        {
+            return;
+        }
 
-        LOGI("Calculation Time: ",
-             std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() / 1000.0, "s");
+        ToleranceAnalysisParams params = MakeToleranceAnalysisParams(m_ToleranceParams, m_SweepJob, m_BestResult);
+        params.SamplesCount = uint64_t(m_ToleranceSamplesCount);
+        params.Seed = uint64_t(uint32_t(m_ToleranceSeed));
+        params.BinsCount = uint32_t(m_ToleranceBinsCount);
+
+        m_ToleranceProgress.Calculated = 0;
+        m_ToleranceProgress.Cancel = false;
+        m_ToleranceFuture = std::async(std::launch::async, [this, params]() {
+            ToleranceAnalysisResult result = RunToleranceAnalysis(params, &m_ToleranceProgress);
+            Application::Get().RequestRedraw();
+            return result;
+        });
     }
 
     void EditorLayer::SetAutoCameraZoom()
@@ -312,61 +441,20 @@ namespace LM
 
     void EditorLayer::CreateGrindingWheelShape()
     {
-        std::vector<glm::vec4> vertices = {
-            {0.0f, 0.0f, 0.0f, 1.0f}
-        };
+        std::vector<glm::vec4> vertices;
         std::vector<uint32_t> indices;
+        CreateGrindingWheelMesh(m_GrindingWheelParams, m_CurveTolerance, vertices, indices);
 
-        auto wheelParams = CalculateGrindingWheelSizes(m_GrindingWheelParams);
-
-        uint32_t leftCenterVertId = vertices.size();
-        vertices.emplace_back(wheelParams.LeftCenterPoint);
-
-        uint32_t r1StartVertId = vertices.size();
-        AddCircleCurve({ 180.0f, 270.0f + m_GrindingWheelParams.Angle, m_GrindingWheelParams.R1, wheelParams.R1Center.x,
-                         wheelParams.R1Center.y },
-                       kSections, vertices);
-        uint32_t r1EndVertId = vertices.size() - 1;
-
-        for (int i = r1StartVertId + 1; i < vertices.size(); i++)
-        {
-            IndicesAddTriangle(indices, leftCenterVertId, i - 1, i);
-        }
-
-        uint32_t rightCenterVertId = vertices.size();
-        vertices.emplace_back(wheelParams.RightCenterPoint);
-
-        uint32_t r2StartVertId = vertices.size();
-        AddCircleCurve({ 270.0f + m_GrindingWheelParams.Angle, 360.0f, m_GrindingWheelParams.R2, wheelParams.R2Center.x,
-                         wheelParams.R2Center.y },
-                       kSections, vertices);
-        uint32_t r2EndVertId = vertices.size() - 1;
-
-        for (int i = r2StartVertId + 1; i < vertices.size(); i++)
-        {
-            IndicesAddTriangle(indices, rightCenterVertId, i - 1, i);
-        }
-
-        IndicesAddTriangle(indices, leftCenterVertId, r1EndVertId, r2StartVertId);
-        IndicesAddTriangle(indices, leftCenterVertId, r2StartVertId, rightCenterVertId);
-
-        m_WheelShape.Create(vertices, indices);
+        m_WheelShape.SetData(vertices, indices);
     }
 
     void EditorLayer::CreateToolShape()
     {
-        std::vector<glm::vec4> vertices = {
-            {0.0f, 0.0f, 0.0f, 1.0f}
-        };
+        std::vector<glm::vec4> vertices;
         std::vector<uint32_t> indices;
+        CreateToolMesh(m_ToolParams, m_CurveTolerance, vertices, indices);
 
-        AddCircleCurve({ 0.0f, 360.0f, m_ToolParams.Diametr / 2.0f, 0.0f, 0.0f }, kSections * 10, vertices);
-        for (size_t i = 2; i < vertices.size(); i++)
-        {
-            IndicesAddTriangle(indices, 0, i - 1, i);
-        }
-
-        m_ToolShape.Create(vertices, indices);
+        m_ToolShape.SetData(vertices, indices);
     }
 
     void EditorLayer::OnImGuiRender()
@@ -464,8 +552,115 @@ namespace LM
         }
     }
 
+    EditorLayer::ViewState EditorLayer::GetViewState() const
+    {
+        return { m_CameraAngleX,
+                 m_CameraZoom,
+                 m_GrindingWheelParams,
+                 m_GrindingWheelProfileParams,
+                 m_ToolParams,
+                 m_GrindingWheelCalcRatation,
+                 m_UseDepthTest,
+                 m_DrawPolygonsAsLines,
+                 m_NeedDrawGrindingWheelStartShape,
+                 m_NeedDrawTopResults,
+                 m_NeedDrawEnvelope };
+    }
+
+    void EditorLayer::ReloadChangedShaders()
+    {
+        std::vector<std::filesystem::path> changed = m_ShaderWatcher.TakeChanged();
+        if (changed.empty())
+        {
+            return;
+        }
+
+        auto isChanged = [&changed](const ShaderSource& _Source) {
+            return _Source.GetLoadType() == ShaderSource::LoadType::FILEPATH &&
+                   std::find(changed.begin(), changed.end(),
+                             std::filesystem::path(_Source.GetSource()).lexically_normal()) != changed.end();
+        };
+
+        for (const Ref<Shader>& shader : { m_Shader, m_OverlayShader })
+        {
+            const std::vector<ShaderSource>& sources = shader->GetLayout().GetSources();
+            if (std::any_of(sources.begin(), sources.end(), isChanged))
+            {
+                shader->Reload();
+            }
+        }
+
+        m_ModelMatrixUniform = m_Shader->GetUniform("u_ModelMatrix");
+        m_ColorUniform = m_Shader->GetUniform("u_Color");
+        m_ViewDirty = true;
+    }
+
+    void EditorLayer::UpdateFrameBufferSize()
+    {
+        if (m_ViewportSize == 0)
+        {
+            return;
+        }
+
+        uint32_t size = uint32_t(glm::ceil(float(m_ViewportSize) * m_Supersampling));
+        size = (size + kFrameBufferSizeStep - 1) / kFrameBufferSizeStep * kFrameBufferSizeStep;
+
+        uint32_t currentSize = m_FrameBuffer->GetWidth();
+        if (size > currentSize || size * 2 <= currentSize)
+        {
+            m_FrameBuffer->Resize(size, size);
+            m_ViewDirty = true;
+        }
+
+        uint32_t currentSamples = m_FrameBuffer->GetSamples();
+        m_FrameBuffer->SetSamples(uint32_t(m_MsaaSamples));
+        if (m_FrameBuffer->GetSamples() != currentSamples)
+        {
+            m_ViewDirty = true;
+        }
+    }
+
+    void EditorLayer::UpdateCurveTolerance()
+    {
+        // Meshes are rebuilt when the view needs finer curves or when they are 2 times finer than needed, so small
+        // zoom steps don't rebuild them
+        float tolerance = GetCurveTolerance(m_CameraZoom, m_FrameBuffer->GetWidth());
+        if (tolerance < m_CurveTolerance || tolerance >= m_CurveTolerance * 2.0f)
+        {
+            m_CurveTolerance = tolerance;
+            CreateGrindingWheelShape();
+            CreateToolShape();
+            m_ViewDirty = true;
+        }
+    }
+
     void EditorLayer::OnUpdate(Timestep ts)
     {
+        ReloadChangedShaders();
+        UpdateCalculation();
+
+        WheelEnvelopeParams envelopeParams;
+        envelopeParams.Wheel = m_GrindingWheelParams;
+        envelopeParams.Profile = m_GrindingWheelProfileParams;
+        envelopeParams.Tool = m_ToolParams;
+        envelopeParams.SamplesCount = uint32_t(m_EnvelopeSamplesCount);
+        envelopeParams.RaysCount = uint32_t(m_EnvelopeRaysCount);
+        if (m_NeedDrawEnvelope && m_WheelEnvelope.Update(envelopeParams))
+        {
+            m_ViewDirty = true;
+        }
+
+        // The image keeps the last drawn frame while it is hidden or nothing changed
+        UpdateFrameBufferSize();
+        UpdateCurveTolerance();
+        ViewState viewState = GetViewState();
+        if (!m_ViewportVisible || (!m_ViewDirty && viewState == m_LastViewState))
+        {
+            return;
+        }
+        m_ViewDirty = false;
+        m_LastViewState = viewState;
+
         if (m_DrawPolygonsAsLines)
         {
             glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -502,47 +697,142 @@ namespace LM
                              glm::vec4(cameraUpStart, 1.0f);
         glm::mat4 view = glm::lookAt(cameraEye, glm::vec3(0.0f, 0.0f, 0.0f), cameraUp);
 
-        m_Shader->SetUniformMat4("u_ProjectionMatrix", projection);
-        m_Shader->SetUniformMat4("u_ViewMatrix", view);
+        CameraUniforms cameraUniforms = { projection, view };
+        m_CameraUniformBuffer->SetData(&cameraUniforms, sizeof(CameraUniforms));
+        m_CameraUniformBuffer->Bind(kCameraUniformsSlot);
 
-        m_Shader->SetUniform4f("u_Color", { 0.0f, 0.0f, 1.0f, 1.0f });
-        m_Shader->SetUniformMat4("u_ModelMatrix", glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -0.0001f)));
+        m_Shader->SetUniform4f(m_ColorUniform, { 0.0f, 0.0f, 1.0f, 1.0f });
+        m_Shader->SetUniformMat4(m_ModelMatrixUniform,
+                                 glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -0.0001f)));
         m_ToolShape.Draw();
 
         if (m_NeedDrawGrindingWheelStartShape)
         {
-            m_Shader->SetUniform4f("u_Color", { 1.0f, 1.0f, 1.0f, 1.0f });
-            m_Shader->SetUniformMat4("u_ModelMatrix", glm::mat4(1.0f));
+            m_Shader->SetUniform4f(m_ColorUniform, { 1.0f, 1.0f, 1.0f, 1.0f });
+            m_Shader->SetUniformMat4(m_ModelMatrixUniform, glm::mat4(1.0f));
             m_WheelShape.Draw();
         }
 
+        if (m_NeedDrawEnvelope)
+        {
+            m_Shader->SetUniform4f(m_ColorUniform, { 1.0f, 0.5f, 0.0f, 1.0f });
+            m_Shader->SetUniformMat4(m_ModelMatrixUniform, glm::mat4(1.0f));
+            m_WheelEnvelope.Draw();
+        }
+
+        if (m_NeedDrawTopResults && m_TopResultsOverlay.GetWheelsCount())
+        {
+            m_Shader->Disable();
+            m_OverlayShader->Enable();
+            m_TopResultsOverlay.SetRotation(m_ToolParams, m_GrindingWheelCalcRatation);
+            m_TopResultsOverlay.Draw();
+            m_OverlayShader->Disable();
+            m_Shader->Enable();
+        }
+
         float rotationOffset = MoveOverToolAxisRotationRadToOffset(glm::radians(m_GrindingWheelCalcRatation),
                                                                    m_ToolParams.Diametr, m_ToolParams.Angle);
-        m_Shader->SetUniform4f("u_Color", { 1.0f, 0.0f, 0.0f, 1.0f });
+        m_Shader->SetUniform4f(m_ColorUniform, { 1.0f, 0.0f, 0.0f, 1.0f });
         m_Shader->SetUniformMat4(
-            "u_ModelMatrix",
+            m_ModelMatrixUniform,
             glm::rotate(glm::mat4(1.0f), glm::radians(m_GrindingWheelCalcRatation), glm::vec3(0.0f, 0.0f, 1.0f)) *
                 GetGrindingWheelMatrix(m_GrindingWheelProfileParams.OffsetToolCenter,
                                        m_GrindingWheelProfileParams.OffsetToolAxis,
                                        m_GrindingWheelProfileParams.RotationAngle, rotationOffset));
         m_WheelShape.Draw();
 
-        // glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, m_Commands.data(), m_Commands.size(), 0);
-
         m_Shader->Disable();
         m_FrameBuffer->Unbind();
     }
 
     void EditorLayer::DrawAll()
     {
+        if (m_PlotSelection.NewFrame())
+        {
+            Application::Get().RequestRedraw();
+        }
+
         if (ImGui::Begin("Calculation"))
         {
-            if (ImGui::Button("Start Calculation"))
+            const char* samplingNames[] = { "Grid", "Halton" };
+            int sampling = int(m_SweepSampling);
+            if (ImGui::Combo("Sampling", &sampling, samplingNames, IM_ARRAYSIZE(samplingNames)))
             {
-                Calculate();
+                m_SweepSampling = SweepSampling(sampling);
+            }
+            if (m_SweepSampling != SweepSampling::Grid)
+            {
+                // Steps only mark varying axes here
+                ImGui::InputInt("Samples", &m_SamplesCount, 1000, 100000);
+                m_SamplesCount = glm::max(m_SamplesCount, 1);
+            }
+
+            if (m_CalculationFuture.valid())
+            {
+                uint32_t chunksCount = m_CalculationProgress.ChunksCount;
+                float progress =
+                    chunksCount > 0 ? float(m_CalculationProgress.CompletedChunks) / float(chunksCount) : 0.0f;
+                ImGui::ProgressBar(progress, ImVec2(-100.0f, 0.0f));
+                ImGui::SameLine();
+                if (ImGui::Button("Cancel"))
+                {
+                    m_CalculationProgress.Cancel = true;
+                }
+            }
+            else
+            {
+                if (ImGui::Button("Start Calculation"))
+                {
+                    Calculate(false);
+                }
+                ImGui::SameLine();
+                if (ImGui::Button("Resume Calculation"))
+                {
+                    Calculate(true);
+                }
+            }
+            ImGui::InputInt("Top Results", &m_TopResultsCount, 100, 1000);
+            m_TopResultsCount = glm::max(m_TopResultsCount, 1);
+            ImGui::InputInt("Plotted Candidates", &m_CandidatesLimit, 100000, 1000000);
+            m_CandidatesLimit = glm::max(m_CandidatesLimit, 0);
+            ImGui::Checkbox("Save Checkpoints", &m_UseCheckpoint);
+            ImGui::InputText("Checkpoint File", m_CheckpointPath, sizeof(m_CheckpointPath));
+
+            ImGui::SeparatorText("Shards");
+            ImGui::InputText("Shards Dir", m_ShardsDir, sizeof(m_ShardsDir));
+            ImGui::InputInt("Shards Count", &m_ShardsCount);
+            m_ShardsCount = glm::max(m_ShardsCount, 1);
+            if (ImGui::Button("Export Sweep Job"))
+            {
+                SaveSweepJob(std::filesystem::path(m_ShardsDir) / kSweepJobFileName, CreateSweepJob());
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Merge Shards"))
+            {
+                SweepJob job;
+                SweepResult result;
+                if (MergeSweepShards(m_ShardsDir, uint32_t(m_ShardsCount), size_t(m_TopResultsCount), &job, &result))
+                {
+                    SetSweepResult(job, result);
+                }
             }
             if (m_HasBestResult)
             {
+                ImGui::SeparatorText("Refinement");
+                ImGui::InputInt("Refined Results", &m_RefinedResultsCount, 10, 100);
+                m_RefinedResultsCount = glm::max(m_RefinedResultsCount, 1);
+                if (ImGui::Button("Refine Top Results"))
+                {
+                    RefineSweepResult();
+                }
+                if (m_HasRefinementResult)
+                {
+                    ImGui::Text("Improved: %llu of %llu, evaluations: %llu, time: %.2f ms",
+                                (unsigned long long)m_RefinementResult.Improved,
+                                (unsigned long long)m_RefinementResult.Refined,
+                                (unsigned long long)m_RefinementResult.Evaluations, m_RefinementResult.CalculationMs);
+                }
+
                 ImGui::SeparatorText("Best Result");
                 ImGui::Text("Front Angle: %f", m_BestResult.FrontAngle);
                 ImGui::Text("Step Angle: %f", m_BestResult.StepAngle);
@@ -688,9 +978,47 @@ namespace LM
                 Gui::EndPropsTable();
             }
 
+            bool onDemandRedraw = Application::Get().IsOnDemandRedraw();
+            if (ImGui::Checkbox("On-Demand Redraw", &onDemandRedraw))
+            {
+                Application::Get().SetOnDemandRedraw(onDemandRedraw);
+            }
             ImGui::Checkbox("Use DepthTest", &m_UseDepthTest);
             ImGui::Checkbox("Draw Polygons as Lines", &m_DrawPolygonsAsLines);
             ImGui::Checkbox("Draw Grinding Wheel Start Shape", &m_NeedDrawGrindingWheelStartShape);
+            const char* msaaNames[] = { "Off", "2x", "4x", "8x" };
+            const int msaaSamples[] = { 1, 2, 4, 8 };
+            int msaaId = int(std::find(std::begin(msaaSamples), std::end(msaaSamples), m_MsaaSamples) -
+                             std::begin(msaaSamples));
+            if (ImGui::Combo("MSAA", &msaaId, msaaNames, IM_ARRAYSIZE(msaaNames)))
+            {
+                m_MsaaSamples = msaaSamples[msaaId];
+            }
+            ImGui::SliderFloat("Supersampling", &m_Supersampling, 1.0f, 2.0f, "%.2fx");
+            ImGui::Text("Framebuffer: %ux%u, %u samples", m_FrameBuffer->GetWidth(), m_FrameBuffer->GetHeight(),
+                        m_FrameBuffer->GetSamples());
+            ImGui::Text("Curve tolerance: %f, vertices: wheel %u, tool %u", m_CurveTolerance,
+                        m_WheelShape.GetVerticesCount(), m_ToolShape.GetVerticesCount());
+
+            ImGui::Checkbox("Draw Top Results", &m_NeedDrawTopResults);
+            if (ImGui::SliderInt("Top Results Drawn", &m_TopResultsDrawCount, 1, glm::max(m_TopResultsCount, 1)))
+            {
+                m_TopResultsOverlay.SetWheels(m_TopResults, size_t(m_TopResultsDrawCount));
+                m_ViewDirty = true;
+            }
+            ImGui::Text("Overlay: %u wheels, %u meshes", m_TopResultsOverlay.GetWheelsCount(),
+                        m_TopResultsOverlay.GetMeshesCount());
+
+            ImGui::Checkbox("Draw Swept Envelope", &m_NeedDrawEnvelope);
+            if (m_NeedDrawEnvelope)
+            {
+                ImGui::InputInt("Envelope Samples", &m_EnvelopeSamplesCount, 16, 256);
+                ImGui::InputInt("Envelope Rays", &m_EnvelopeRaysCount, 256, 1024);
+                m_EnvelopeSamplesCount = glm::max(m_EnvelopeSamplesCount, 1);
+                m_EnvelopeRaysCount = glm::max(m_EnvelopeRaysCount, 3);
+                ImGui::Text("Envelope: %.2f ms%s", m_WheelEnvelope.GetCalculationMs(),
+                            m_WheelEnvelope.IsCalculating() ? " (updating)" : "");
+            }
 
             ImGui::Separator();
 
@@ -714,22 +1042,36 @@ namespace LM
         }
         ImGui::End();
 
-        if (ImGui::Begin("Output Wheel"))
+        m_ViewportVisible = ImGui::Begin("Output Wheel");
+        if (m_ViewportVisible)
         {
             ImVec2 regionAvail = ImGui::GetContentRegionAvail();
 
             float imgSize = glm::min(regionAvail.x, regionAvail.y);
             Gui::AlignForWidth(imgSize);
             ImGui::Image(m_FrameBuffer->GetTextureId(), { imgSize, imgSize }, { 0, 1 }, { 1, 0 });
+
+            m_ViewportSize = uint32_t(glm::max(imgSize * ImGui::GetIO().DisplayFramebufferScale.x, 0.0f));
+            m_ViewportVisible = m_ViewportSize > 0;
         }
         ImGui::End();
 
         DrawPlots();
+        DrawToleranceAnalysis();
+        DrawSensitivity();
+        DrawObjectiveHeatmap();
+        DrawCandidates();
+        DrawParallelCoordinates();
+
+        if (m_PlotSelection.PopSelectionChanged())
+        {
+            DrawSelectedItem();
+        }
 
         ImPlot::ShowDemoWindow();
     }
 
-    void EditorLayer::DrawPlots() const
+    void EditorLayer::DrawPlots()
     {
         if (ImGui::Begin("Tool Angle Plot"))
         {
@@ -785,7 +1127,20 @@ namespace LM
                     ImPlot::PlotLine("Front Angle", toolAngleArr.data(), frontAngleArr.data(), toolAngleArr.size());
                     ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle);
                     ImPlot::PlotLine("Step Angle", toolAngleArr.data(), stepAngleArr.data(), toolAngleArr.size());
-                    DrawTooltip(toolAngleArr, frontAngleArr, stepAngleArr, diametrInArr, 0.25f);
+                    int64_t hovered = DrawTooltip(toolAngleArr, frontAngleArr, stepAngleArr, diametrInArr, 0.25f);
+                    if (hovered != -1)
+                    {
+                        PlotItem item = { PlotSource::ToolAnglePlot, hovered, GetBestResultValues(m_BestResult),
+                                          m_ToolParams };
+                        item.Tool.Angle = float(toolAngleArr[hovered]);
+                        m_PlotSelection.Hover(item);
+                        if (ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+                        {
+                            m_PlotSelection.Select(item);
+                        }
+                    }
+                    DrawResultPlotMarkers(PlotSource::ToolAnglePlot, toolAngleArr, frontAngleArr, stepAngleArr,
+                                          diametrInArr, m_PlotSelection.GetSelected().Tool.Angle);
                     ImPlot::EndPlot();
                 }
             }
@@ -845,7 +1200,290 @@ namespace LM
                                      wheelDiametrArr.size());
                     ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle);
                     ImPlot::PlotLine("Step Angle", wheelDiametrArr.data(), stepAngleArr.data(), wheelDiametrArr.size());
-                    DrawTooltip(wheelDiametrArr, frontAngleArr, stepAngleArr, diametrInArr, 0.25f);
+                    int64_t hovered = DrawTooltip(wheelDiametrArr, frontAngleArr, stepAngleArr, diametrInArr, 0.25f);
+                    if (hovered != -1)
+                    {
+                        PlotItem item = { PlotSource::WheelDiametrPlot, hovered, GetBestResultValues(m_BestResult),
+                                          m_ToolParams };
+                        item.Values.Diametr = float(wheelDiametrArr[hovered]);
+                        m_PlotSelection.Hover(item);
+                        if (ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+                        {
+                            m_PlotSelection.Select(item);
+                        }
+                    }
+                    DrawResultPlotMarkers(PlotSource::WheelDiametrPlot, wheelDiametrArr, frontAngleArr, stepAngleArr,
+                                          diametrInArr, m_PlotSelection.GetSelected().Values.Diametr);
+                    ImPlot::EndPlot();
+                }
+            }
+        }
+        ImGui::End();
+    }
+
+    void EditorLayer::DrawResultPlotMarkers(PlotSource _Source, const std::vector<double>& _Xs,
+                                            const std::vector<double>& _FrontAngle,
+                                            const std::vector<double>& _StepAngle,
+                                            const std::vector<double>& _DiametrIn, double _SelectedX) const
+    {
+        auto drawMarker = [&](const char* _Label, int64_t _Index, float _Size) {
+            if (_Index < 0 || _Index >= int64_t(_Xs.size()))
+            {
+                return;
+            }
+
+            ImPlot::SetAxes(ImAxis_X1, ImAxis_Y1);
+            ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, _Size);
+            ImPlot::PlotScatter(_Label, &_Xs[_Index], &_DiametrIn[_Index], 1);
+
+            ImPlot::SetAxes(ImAxis_X1, ImAxis_Y2);
+            ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, _Size);
+            ImPlot::PlotScatter(_Label, &_Xs[_Index], &_FrontAngle[_Index], 1);
+            ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, _Size);
+            ImPlot::PlotScatter(_Label, &_Xs[_Index], &_StepAngle[_Index], 1);
+        };
+
+        const PlotItem& hovered = m_PlotSelection.GetHovered();
+        if (hovered.Is(_Source))
+        {
+            drawMarker("Hovered", hovered.Index, 6.0f);
+        }
+        // The plot is recalculated around the current inputs, so the selected point is found by its value
+        if (m_PlotSelection.GetSelected().Is(_Source))
+        {
+            drawMarker("Selected", FindNearestSorted(_Xs.data(), _Xs.size(), _SelectedX, 1e-3), 8.0f);
+        }
+    }
+
+    PlotItem EditorLayer::CreateCandidateItem(int64_t _Index) const
+    {
+        PlotItem item = { PlotSource::Candidates, _Index };
+        for (uint32_t axis = 0; axis < kSweepAxesCount; axis++)
+        {
+            item.Values.*kSweepAxes<float>[axis] = m_Candidates.Columns[axis][_Index];
+        }
+        item.Tool = m_ToolParams;
+        return item;
+    }
+
+    void EditorLayer::DrawCandidatesSelection(const PlotHitGrid& _HitGrid, CandidateColumn _X, CandidateColumn _Y)
+    {
+        if (ImPlot::IsPlotHovered())
+        {
+            ImPlotPoint mouse = ImPlot::GetPlotMousePos();
+            int64_t index = _HitGrid.FindNearest(glm::dvec2(mouse.x, mouse.y), GetPlotPickRadius(kPlotPickPixels));
+            if (index != -1)
+            {
+                PlotItem item = CreateCandidateItem(index);
+                m_PlotSelection.Hover(item);
+                if (ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+                {
+                    m_PlotSelection.Select(item);
+                }
+
+                ImGui::BeginTooltip();
+                for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+                {
+                    ImGui::Text("%s: %.4f", GetCandidateColumnName(CandidateColumn(column)),
+                                m_Candidates.Columns[column][index]);
+                }
+                ImGui::EndTooltip();
+            }
+        }
+
+        auto drawMarker = [&](const char* _Label, const PlotItem& _Item, float _Size) {
+            if (!_Item.Is(PlotSource::Candidates) || _Item.Index >= int64_t(m_Candidates.GetSize()))
+            {
+                return;
+            }
+
+            double x = m_Candidates.GetColumn(_X)[_Item.Index];
+            double y = m_Candidates.GetColumn(_Y)[_Item.Index];
+            ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, _Size);
+            ImPlot::PlotScatter(_Label, &x, &y, 1);
+        };
+        drawMarker("Hovered", m_PlotSelection.GetHovered(), 6.0f);
+        drawMarker("Selected", m_PlotSelection.GetSelected(), 8.0f);
+    }
+
+    void EditorLayer::DrawSelectedItem()
+    {
+        const PlotItem& item = m_PlotSelection.GetSelected();
+        if (item.Is(PlotSource::None))
+        {
+            return;
+        }
+
+        if (!(item.Tool == m_ToolParams))
+        {
+            m_ToolParams = item.Tool;
+            CreateToolShape();
+        }
+        m_GrindingWheelParams.Diametr = item.Values.Diametr;
+        CreateWheelShapeFromCalcParams(item.Values);
+    }
+
+    void EditorLayer::DrawToleranceAnalysis()
+    {
+        if (m_ToleranceFuture.valid() &&
+            m_ToleranceFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            m_ToleranceResult = m_ToleranceFuture.get();
+            m_HasToleranceResult = true;
+            LOGI("Tolerance analysis: ", m_ToleranceResult.Calculated, " samples, bad: ",
+                 m_ToleranceResult.BadCalculations, ", time: ", m_ToleranceResult.CalculationMs / 1000.0, "s");
+        }
+
+        if (ImGui::Begin("Tolerance Analysis"))
+        {
+            if (!m_HasBestResult)
+            {
+                ImGui::Text("Needs the best result");
+            }
+            else
+            {
+                const char* distributionNames[] = { "Uniform", "Normal (3 sigma)" };
+                if (ImGui::BeginTable("Tolerances", 3, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit))
+                {
+                    ImGui::TableSetupColumn("Input", ImGuiTableColumnFlags_WidthFixed);
+                    ImGui::TableSetupColumn("Tolerance", ImGuiTableColumnFlags_WidthStretch);
+                    ImGui::TableSetupColumn("Distribution", ImGuiTableColumnFlags_WidthStretch);
+                    ImGui::TableHeadersRow();
+
+                    for (uint32_t input = 0; input < kToleranceInputsCount; input++)
+                    {
+                        ToleranceInputParams& inputParams = m_ToleranceParams.Inputs[input];
+                        ImGui::PushID(int(input));
+
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%s", GetToleranceInputName(ToleranceInput(input)));
+                        ImGui::TableNextColumn();
+                        ImGui::SetNextItemWidth(-1.0f);
+                        ImGui::DragFloat("##Tolerance", &inputParams.Tolerance, 0.001f, 0.0f, kMaxFloat, "+-%.3f");
+                        ImGui::TableNextColumn();
+                        int distribution = int(inputParams.Distribution);
+                        ImGui::SetNextItemWidth(-1.0f);
+                        if (ImGui::Combo("##Distribution", &distribution, distributionNames,
+                                         IM_ARRAYSIZE(distributionNames)))
+                        {
+                            inputParams.Distribution = ToleranceDistribution(distribution);
+                        }
+
+                        ImGui::PopID();
+                    }
+
+                    ImGui::EndTable();
+                }
+
+                ImGui::InputInt("Samples", &m_ToleranceSamplesCount, 100000, 1000000);
+                ImGui::InputInt("Seed", &m_ToleranceSeed);
+                ImGui::InputInt("Bins", &m_ToleranceBinsCount, 8, 64);
+                m_ToleranceSamplesCount = glm::max(m_ToleranceSamplesCount, 1);
+                m_ToleranceBinsCount = glm::clamp(m_ToleranceBinsCount, 1, 1024);
+
+                if (m_ToleranceFuture.valid())
+                {
+                    float progress = float(m_ToleranceProgress.Calculated) / float(m_ToleranceSamplesCount);
+                    ImGui::ProgressBar(progress, ImVec2(-100.0f, 0.0f));
+                    ImGui::SameLine();
+                    if (ImGui::Button("Cancel"))
+                    {
+                        m_ToleranceProgress.Cancel = true;
+                    }
+                    // Progress bar moves without events too
+                    Application::Get().RequestRedraw();
+                }
+                else if (ImGui::Button("Run Analysis"))
+                {
+                    StartToleranceAnalysis();
+                }
+            }
+
+            if (m_HasToleranceResult)
+            {
+                const ToleranceAnalysisResult& result = m_ToleranceResult;
+
+                ImGui::SeparatorText("Results");
+                ImGui::Text("Samples: %llu, bad: %llu, time: %.2f s", (unsigned long long)result.Calculated,
+                            (unsigned long long)result.BadCalculations, result.CalculationMs / 1000.0);
+
+                struct Output
+                {
+                    const char* Name;
+                    const char* Format;
+                    const ToleranceOutputStats* Stats;
+                    double Target;
+                };
+                const Output outputs[] = {
+                    { "Front Angle", "%g deg", &result.FrontAngle, result.ToFind.FrontAngle },
+                    {  "Step Angle", "%g deg",  &result.StepAngle,  result.ToFind.StepAngle },
+                    {  "Diametr In",  "%g mm",  &result.DiametrIn,  result.ToFind.DiametrIn },
+                };
+
+                if (ImGui::BeginTable("Stats", 5 + kTolerancePercentilesCount,
+                                      ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit))
+                {
+                    ImGui::TableSetupColumn("Output");
+                    ImGui::TableSetupColumn("Target");
+                    ImGui::TableSetupColumn("Nominal");
+                    ImGui::TableSetupColumn("Mean");
+                    ImGui::TableSetupColumn("Std Dev");
+                    char percentileNames[kTolerancePercentilesCount][16];
+                    for (uint32_t i = 0; i < kTolerancePercentilesCount; i++)
+                    {
+                        snprintf(percentileNames[i], sizeof(percentileNames[i]), "P%g", kTolerancePercentiles[i]);
+                        ImGui::TableSetupColumn(percentileNames[i]);
+                    }
+                    ImGui::TableHeadersRow();
+
+                    for (const Output& output : outputs)
+                    {
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%s", output.Name);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.4f", output.Target);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.4f", output.Stats->Nominal);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.4f", output.Stats->Mean);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.4f", output.Stats->StdDev);
+                        for (float percentile : output.Stats->Percentiles)
+                        {
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%.4f", percentile);
+                        }
+                    }
+
+                    ImGui::EndTable();
+                }
+
+                float plotHeight = glm::max(ImGui::GetContentRegionAvail().y / 3.0f - ImGui::GetStyle().ItemSpacing.y,
+                                            100.0f);
+                for (const Output& output : outputs)
+                {
+                    const ToleranceOutputStats& stats = *output.Stats;
+                    if (stats.Bins.empty() || !ImPlot::BeginPlot(output.Name, ImVec2(-1, plotHeight)))
+                    {
+                        continue;
+                    }
+
+                    ImPlot::SetupAxes(nullptr, "Share", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+                    ImPlot::SetupAxisFormat(ImAxis_X1, output.Format);
+                    ImPlot::PlotBars("Samples", stats.BinCenters.data(), stats.Bins.data(), int(stats.Bins.size()),
+                                     stats.BinWidth);
+
+                    double nominal = stats.Nominal;
+                    double percentiles[] = { stats.Percentiles.front(), stats.Percentiles.back() };
+                    if (result.HasNominal)
+                    {
+                        ImPlot::PlotInfLines("Nominal", &nominal, 1);
+                    }
+                    char percentilesName[32];
+                    snprintf(percentilesName, sizeof(percentilesName), "P%g / P%g", kTolerancePercentiles[0],
+                             kTolerancePercentiles[kTolerancePercentilesCount - 1]);
+                    ImPlot::PlotInfLines(percentilesName, percentiles, 2);
+
                     ImPlot::EndPlot();
                 }
             }
@@ -853,6 +1491,445 @@ namespace LM
         ImGui::End();
     }
 
+    void EditorLayer::DrawSensitivity()
+    {
+        if (ImGui::Begin("Sensitivity"))
+        {
+            if (!m_HasBestResult)
+            {
+                ImGui::Text("Needs the best result");
+                ImGui::End();
+                return;
+            }
+
+            // One evaluation gives the whole Jacobian, cheap enough to do every frame
+            auto startTime = std::chrono::steady_clock::now();
+            ParamsJacobian jacobian;
+            bool calculated = CalculateParamsJacobian(GetBestResultValues(m_BestResult), m_ToolParams, &jacobian);
+            double calculationUs =
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+
+            if (!calculated)
+            {
+                ImGui::Text("Params of the best result can't be calculated");
+                ImGui::End();
+                return;
+            }
+
+            ImGui::Text("Derivatives of the params by the inputs, time: %.1f us", calculationUs);
+
+            const ParamsDual* outputs[] = { &jacobian.FrontAngle, &jacobian.StepAngle, &jacobian.DiametrIn };
+            if (ImGui::BeginTable("Jacobian", 4, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit))
+            {
+                ImGui::TableSetupColumn("Input");
+                ImGui::TableSetupColumn("Front Angle");
+                ImGui::TableSetupColumn("Step Angle");
+                ImGui::TableSetupColumn("Diametr In");
+                ImGui::TableHeadersRow();
+
+                ImGui::TableNextColumn();
+                ImGui::Text("Value");
+                for (const ParamsDual* output : outputs)
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.6g", output->Value);
+                }
+
+                for (uint32_t input = 0; input < kParamsJacobianInputsCount; input++)
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", input == kParamsJacobianToolAngle ? "Tool Angle" : kSweepAxisNames[input]);
+                    for (const ParamsDual* output : outputs)
+                    {
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.6g", output->Derivatives[input]);
+                    }
+                }
+
+                ImGui::EndTable();
+            }
+        }
+        ImGui::End();
+    }
+
+    void EditorLayer::DrawObjectiveHeatmap()
+    {
+        if (ImGui::Begin("Objective Heatmap"))
+        {
+            ImGui::Combo("Axis X", &m_HeatmapAxisX, kSweepAxisNames, IM_ARRAYSIZE(kSweepAxisNames));
+            ImGui::Combo("Axis Y", &m_HeatmapAxisY, kSweepAxisNames, IM_ARRAYSIZE(kSweepAxisNames));
+
+            int output = int(m_HeatmapOutput);
+            const char* outputNames[] = { GetHeatmapOutputName(HeatmapOutput::Delta),
+                                          GetHeatmapOutputName(HeatmapOutput::FrontAngle),
+                                          GetHeatmapOutputName(HeatmapOutput::StepAngle),
+                                          GetHeatmapOutputName(HeatmapOutput::DiametrIn) };
+            if (ImGui::Combo("Output", &output, outputNames, IM_ARRAYSIZE(outputNames)))
+            {
+                m_HeatmapOutput = HeatmapOutput(output);
+            }
+
+            const char* resolutionNames[] = { "256", "512", "1024", "2048" };
+            const int resolutions[] = { 256, 512, 1024, 2048 };
+            int resolutionId = int(std::find(std::begin(resolutions), std::end(resolutions), m_HeatmapResolution) -
+                                   std::begin(resolutions));
+            if (ImGui::Combo("Resolution", &resolutionId, resolutionNames, IM_ARRAYSIZE(resolutionNames)))
+            {
+                m_HeatmapResolution = resolutions[resolutionId];
+            }
+
+            ObjectiveHeatmapParams params;
+            if (m_HasBestResult)
+            {
+                params.Center = GetBestResultValues(m_BestResult);
+            }
+            else
+            {
+                params.Center = { m_GrindingWheelParams.Diametr,
+                                  m_GrindingWheelParams.Width,
+                                  m_GrindingWheelParams.R1,
+                                  m_GrindingWheelParams.R2,
+                                  m_GrindingWheelParams.Angle,
+                                  m_GrindingWheelProfileParams.OffsetToolCenter,
+                                  m_GrindingWheelProfileParams.OffsetToolAxis,
+                                  m_GrindingWheelProfileParams.RotationAngle };
+            }
+            params.Tool = m_ToolParams;
+            params.ToFind = CreateSweepJob().ToFind;
+            params.AxisX = uint32_t(m_HeatmapAxisX);
+            params.AxisY = uint32_t(m_HeatmapAxisY);
+            params.MinX = m_GrindingWheelCalcParams.Min.*kSweepAxes<float>[params.AxisX];
+            params.MaxX = m_GrindingWheelCalcParams.Max.*kSweepAxes<float>[params.AxisX];
+            params.MinY = m_GrindingWheelCalcParams.Min.*kSweepAxes<float>[params.AxisY];
+            params.MaxY = m_GrindingWheelCalcParams.Max.*kSweepAxes<float>[params.AxisY];
+            params.Output = m_HeatmapOutput;
+            params.Resolution = uint32_t(m_HeatmapResolution);
+
+            if (params.AxisX == params.AxisY || !(params.MinX < params.MaxX) || !(params.MinY < params.MaxY))
+            {
+                ImGui::Text("Axes must differ and have Min < Max in the calc params");
+            }
+            else
+            {
+                m_Heatmap.Update(params);
+
+                ImGui::Text("%s, %.0f%%, %.2f s, range: %f .. %f", m_HasBestResult ? "Best result" : "Rendered wheel",
+                            m_Heatmap.GetProgress() * 100.0f, m_Heatmap.GetCalculationMs() / 1000.0,
+                            m_Heatmap.GetMin(), m_Heatmap.GetMax());
+
+                const ObjectiveHeatmapParams& shownParams = m_Heatmap.GetParams();
+                const float scaleWidth = 100.0f;
+                ImVec2 plotSize = ImGui::GetContentRegionAvail();
+                plotSize.x -= scaleWidth + ImGui::GetStyle().ItemSpacing.x;
+
+                // More cells than pixels are averaged, ImPlot draws every cell as a quad
+                uint32_t displayResolution = 0;
+                const std::vector<float>& displayValues = m_Heatmap.GetDisplayValues(
+                    uint32_t(glm::max(plotSize.x, plotSize.y) * ImGui::GetIO().DisplayFramebufferScale.x),
+                    &displayResolution);
+
+                ImPlot::PushColormap(ImPlotColormap_Viridis);
+                if (displayResolution > 0 && ImPlot::BeginPlot("##Heatmap", plotSize, ImPlotFlags_NoLegend))
+                {
+                    ImPlot::SetupAxes(kSweepAxisNames[shownParams.AxisX], kSweepAxisNames[shownParams.AxisY],
+                                      ImPlotAxisFlags_NoGridLines, ImPlotAxisFlags_NoGridLines);
+                    ImPlot::SetupAxesLimits(shownParams.MinX, shownParams.MaxX, shownParams.MinY, shownParams.MaxY);
+                    ImPlot::PlotHeatmap("##Values", displayValues.data(), int(displayResolution),
+                                        int(displayResolution), m_Heatmap.GetMin(), m_Heatmap.GetMax(), nullptr,
+                                        ImPlotPoint(shownParams.MinX, shownParams.MinY),
+                                        ImPlotPoint(shownParams.MaxX, shownParams.MaxY));
+
+                    if (ImPlot::IsPlotHovered())
+                    {
+                        ImPlotPoint mouse = ImPlot::GetPlotMousePos();
+                        const uint32_t resolution = m_Heatmap.GetResolution();
+                        double x = (mouse.x - shownParams.MinX) / (shownParams.MaxX - shownParams.MinX);
+                        double y = (mouse.y - shownParams.MinY) / (shownParams.MaxY - shownParams.MinY);
+                        if (x >= 0.0 && x < 1.0 && y >= 0.0 && y < 1.0)
+                        {
+                            size_t cell = size_t(y * resolution) * resolution + size_t(x * resolution);
+                            ImGui::BeginTooltip();
+                            ImGui::Text("%s: %.4f", kSweepAxisNames[shownParams.AxisX], mouse.x);
+                            ImGui::Text("%s: %.4f", kSweepAxisNames[shownParams.AxisY], mouse.y);
+                            ImGui::Text("%s: %.4f", GetHeatmapOutputName(shownParams.Output),
+                                        m_Heatmap.GetValues()[cell]);
+                            ImGui::EndTooltip();
+                        }
+                    }
+
+                    ImPlot::EndPlot();
+                }
+                ImGui::SameLine();
+                ImPlot::ColormapScale("##Scale", m_Heatmap.GetMin(), m_Heatmap.GetMax(),
+                                      ImVec2(scaleWidth, plotSize.y));
+                ImPlot::PopColormap();
+            }
+        }
+        ImGui::End();
+    }
+
+    void EditorLayer::DrawCandidates()
+    {
+        if (ImGui::Begin("Candidates"))
+        {
+            ImGui::Text("Candidates: %zu", m_Candidates.GetSize());
+
+            if (m_Candidates.GetSize() > 0)
+            {
+                const float plotHeight =
+                    glm::max((ImGui::GetContentRegionAvail().y - ImGui::GetFrameHeightWithSpacing() * 5.0f) / 2.0f,
+                             100.0f);
+
+                ImGui::SeparatorText("Scatter");
+                m_ScatterLodDirty |= ComboCandidateColumn("Scatter X", &m_ScatterX);
+                m_ScatterLodDirty |= ComboCandidateColumn("Scatter Y", &m_ScatterY);
+
+                bool fitScatter = m_ScatterLodDirty;
+                if (m_ScatterLodDirty)
+                {
+                    m_ScatterLod.Build(m_Candidates.GetColumn(m_ScatterX).data(),
+                                       m_Candidates.GetColumn(m_ScatterY).data(), m_Candidates.GetSize());
+                    m_ScatterHitGrid.Build(m_Candidates.GetColumn(m_ScatterX).data(),
+                                           m_Candidates.GetColumn(m_ScatterY).data(), m_Candidates.GetSize());
+                    m_ScatterLodDirty = false;
+                }
+
+                ImPlot::PushColormap(ImPlotColormap_Viridis);
+                if (ImPlot::BeginPlot("##Scatter", ImVec2(-1, plotHeight)))
+                {
+                    ImPlot::SetupAxes(GetCandidateColumnName(m_ScatterX), GetCandidateColumnName(m_ScatterY));
+                    if (fitScatter)
+                    {
+                        ImPlot::SetupAxesLimits(m_ScatterLod.GetMin().x, m_ScatterLod.GetMax().x,
+                                                m_ScatterLod.GetMin().y, m_ScatterLod.GetMax().y, ImPlotCond_Always);
+                    }
+
+                    PlotLodView view = GetPlotLodView();
+                    m_ScatterLod.Update(view);
+                    if (m_ScatterLod.IsDensity())
+                    {
+                        ImPlot::PlotHeatmap("Density", m_ScatterLod.GetDensity().data(),
+                                            int(m_ScatterLod.GetDensityHeight()), int(m_ScatterLod.GetDensityWidth()),
+                                            0.0, m_ScatterLod.GetMaxDensity(), nullptr,
+                                            ImPlotPoint(view.MinX, view.MinY), ImPlotPoint(view.MaxX, view.MaxY));
+                    }
+                    else
+                    {
+                        ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 2.0f);
+                        ImPlot::PlotScatter("Candidates", m_ScatterLod.GetXs().data(), m_ScatterLod.GetYs().data(),
+                                            int(m_ScatterLod.GetXs().size()));
+                    }
+                    DrawCandidatesSelection(m_ScatterHitGrid, m_ScatterX, m_ScatterY);
+
+                    ImPlot::EndPlot();
+                }
+                ImPlot::PopColormap();
+
+                ImGui::SeparatorText("Line");
+                m_LineLodDirty |= ComboCandidateColumn("Line X", &m_LineX);
+                m_LineLodDirty |= ComboCandidateColumn("Line Y", &m_LineY);
+                const char* lodModeNames[] = { "Min/Max", "LTTB" };
+                int lodMode = int(m_LineLodMode);
+                if (ImGui::Combo("LOD", &lodMode, lodModeNames, IM_ARRAYSIZE(lodModeNames)))
+                {
+                    m_LineLodMode = LineLodMode(lodMode);
+                }
+
+                bool fitLine = m_LineLodDirty;
+                if (m_LineLodDirty)
+                {
+                    m_LineLod.Build(m_Candidates.GetColumn(m_LineX).data(), m_Candidates.GetColumn(m_LineY).data(),
+                                    m_Candidates.GetSize());
+                    m_LineHitGrid.Build(m_Candidates.GetColumn(m_LineX).data(),
+                                        m_Candidates.GetColumn(m_LineY).data(), m_Candidates.GetSize());
+                    m_LineLodDirty = false;
+                }
+
+                if (ImPlot::BeginPlot("##Line", ImVec2(-1, plotHeight)))
+                {
+                    ImPlot::SetupAxes(GetCandidateColumnName(m_LineX), GetCandidateColumnName(m_LineY));
+                    if (fitLine)
+                    {
+                        ImPlot::SetupAxesLimits(m_LineLod.GetMin().x, m_LineLod.GetMax().x, m_LineLod.GetMin().y,
+                                                m_LineLod.GetMax().y, ImPlotCond_Always);
+                    }
+
+                    m_LineLod.Update(GetPlotLodView(), m_LineLodMode);
+                    ImPlot::PlotLine(GetCandidateColumnName(m_LineY), m_LineLod.GetXs().data(),
+                                     m_LineLod.GetYs().data(), int(m_LineLod.GetXs().size()));
+                    DrawCandidatesSelection(m_LineHitGrid, m_LineX, m_LineY);
+
+                    ImPlot::EndPlot();
+                }
+            }
+        }
+        ImGui::End();
+    }
+
+    void EditorLayer::DrawParallelCoordinates()
+    {
+        if (ImGui::Begin("Parallel Coordinates"))
+        {
+            ImGui::Text("Selected: %zu of %zu (%.2f ms)", m_CandidateFilter.GetSelectedCount(),
+                        m_CandidateFilter.GetCount(), m_CandidateFilter.GetFilterMs());
+            ImGui::SameLine();
+            if (ImGui::Button("Clear Brushes"))
+            {
+                m_CandidateFilter.ClearBrushes();
+                m_ParallelLinesDirty = true;
+            }
+            if (ImGui::InputInt("Lines", &m_ParallelLinesCount, 500, 5000))
+            {
+                m_ParallelLinesCount = glm::max(m_ParallelLinesCount, 0);
+                m_ParallelLinesDirty = true;
+            }
+
+            if (m_ParallelLinesDirty)
+            {
+                m_CandidateFilter.GetSelectedSample(size_t(m_ParallelLinesCount), &m_ParallelLines);
+
+                m_ParallelBackgroundLines.clear();
+                if (m_CandidateFilter.HasBrushes())
+                {
+                    const size_t count = glm::min(size_t(m_ParallelLinesCount), m_CandidateFilter.GetCount());
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        m_ParallelBackgroundLines.push_back(uint32_t(i * m_CandidateFilter.GetCount() / count));
+                    }
+                }
+                m_ParallelLinesDirty = false;
+            }
+
+            const ImPlotFlags plotFlags =
+                ImPlotFlags_NoLegend | ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect | ImPlotFlags_NoMouseText;
+            if (m_CandidateFilter.GetCount() > 0 &&
+                ImPlot::BeginPlot("##ParallelCoordinates", ImVec2(-1, -1), plotFlags))
+            {
+                double axes[kCandidateColumnsCount];
+                const char* axisNames[kCandidateColumnsCount];
+                for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+                {
+                    axes[column] = double(column);
+                    axisNames[column] = GetCandidateColumnName(CandidateColumn(column));
+                }
+
+                ImPlot::SetupAxis(ImAxis_X1, nullptr, ImPlotAxisFlags_Lock | ImPlotAxisFlags_NoGridLines);
+                ImPlot::SetupAxis(ImAxis_Y1, nullptr,
+                                  ImPlotAxisFlags_Lock | ImPlotAxisFlags_NoGridLines | ImPlotAxisFlags_NoTickLabels);
+                ImPlot::SetupAxesLimits(-0.5, kCandidateColumnsCount - 0.5, -0.1, 1.1, ImPlotCond_Always);
+                ImPlot::SetupAxisTicks(ImAxis_X1, axes, kCandidateColumnsCount, axisNames);
+
+                // Every axis is scaled to [0, 1] over the range of its column
+                auto toAxis = [&](uint32_t _Column, float _Value) {
+                    float min = m_CandidateFilter.GetMin(CandidateColumn(_Column));
+                    float max = m_CandidateFilter.GetMax(CandidateColumn(_Column));
+                    return max > min ? double(_Value - min) / double(max - min) : 0.5;
+                };
+                auto fromAxis = [&](uint32_t _Column, double _Y) {
+                    float min = m_CandidateFilter.GetMin(CandidateColumn(_Column));
+                    float max = m_CandidateFilter.GetMax(CandidateColumn(_Column));
+                    return float(min + _Y * (double(max) - min));
+                };
+
+                // Brushing: drag along an axis to set its range, click on it to clear the range
+                if (ImPlot::IsPlotHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+                {
+                    ImPlotPoint mouse = ImPlot::GetPlotMousePos();
+                    int column = int(glm::round(mouse.x));
+                    if (column >= 0 && column < int(kCandidateColumnsCount) && glm::abs(mouse.x - column) < 0.25)
+                    {
+                        m_BrushColumn = column;
+                        m_BrushStart = mouse.y;
+                    }
+                }
+                if (m_BrushColumn >= 0)
+                {
+                    CandidateBrush brush;
+                    if (glm::abs(ImGui::GetMouseDragDelta(ImGuiMouseButton_Left, 0.0f).y) > 3.0f)
+                    {
+                        double mouseY = ImPlot::GetPlotMousePos().y;
+                        brush.Active = true;
+                        brush.Min = fromAxis(m_BrushColumn, glm::min(m_BrushStart, mouseY));
+                        brush.Max = fromAxis(m_BrushColumn, glm::max(m_BrushStart, mouseY));
+                    }
+                    if (m_CandidateFilter.SetBrush(m_Candidates, CandidateColumn(m_BrushColumn), brush))
+                    {
+                        m_ParallelLinesDirty = true;
+                    }
+                    if (!ImGui::IsMouseDown(ImGuiMouseButton_Left))
+                    {
+                        m_BrushColumn = -1;
+                    }
+                }
+
+                ImDrawList* drawList = ImPlot::GetPlotDrawList();
+                ImPlot::PushPlotClipRect();
+
+                ImVec2 points[kCandidateColumnsCount];
+                auto drawLine = [&](uint32_t _Index, ImU32 _Color, float _Thickness) {
+                    for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+                    {
+                        float value = m_Candidates.Columns[column][_Index];
+                        points[column] = ImPlot::PlotToPixels(column, toAxis(column, value));
+                    }
+                    drawList->AddPolyline(points, kCandidateColumnsCount, _Color, ImDrawFlags_None, _Thickness);
+                };
+
+                for (uint32_t index : m_ParallelBackgroundLines)
+                {
+                    drawLine(index, IM_COL32(128, 128, 128, 32), 1.0f);
+                }
+                // Selected lines are colored by the delta
+                const uint32_t deltaColumn = uint32_t(CandidateColumn::Delta);
+                for (uint32_t index : m_ParallelLines)
+                {
+                    float delta = m_Candidates.Columns[deltaColumn][index];
+                    ImVec4 color = ImPlot::SampleColormap(float(toAxis(deltaColumn, delta)), ImPlotColormap_Viridis);
+                    color.w = 0.3f;
+                    drawLine(index, ImGui::ColorConvertFloat4ToU32(color), 1.0f);
+                }
+                if (m_PlotSelection.GetHovered().Is(PlotSource::Candidates))
+                {
+                    drawLine(uint32_t(m_PlotSelection.GetHovered().Index), IM_COL32(255, 255, 255, 255), 2.0f);
+                }
+                if (m_PlotSelection.GetSelected().Is(PlotSource::Candidates))
+                {
+                    drawLine(uint32_t(m_PlotSelection.GetSelected().Index), IM_COL32(255, 128, 0, 255), 3.0f);
+                }
+
+                for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+                {
+                    ImVec2 top = ImPlot::PlotToPixels(column, 1.0);
+                    ImVec2 bottom = ImPlot::PlotToPixels(column, 0.0);
+                    drawList->AddLine(top, bottom, IM_COL32(255, 255, 255, 160), 1.0f);
+
+                    const CandidateBrush& brush = m_CandidateFilter.GetBrush(CandidateColumn(column));
+                    if (brush.Active)
+                    {
+                        ImVec2 brushMin = ImPlot::PlotToPixels(column - 0.08, toAxis(column, brush.Max));
+                        ImVec2 brushMax = ImPlot::PlotToPixels(column + 0.08, toAxis(column, brush.Min));
+                        drawList->AddRectFilled(brushMin, brushMax, IM_COL32(255, 255, 255, 48));
+                        drawList->AddRect(brushMin, brushMax, IM_COL32(255, 255, 255, 200));
+                    }
+                }
+
+                ImPlot::PopPlotClipRect();
+
+                for (uint32_t column = 0; column < kCandidateColumnsCount; column++)
+                {
+                    char text[32];
+                    snprintf(text, sizeof(text), "%.3f", m_CandidateFilter.GetMax(CandidateColumn(column)));
+                    ImPlot::PlotText(text, column, 1.05);
+                    snprintf(text, sizeof(text), "%.3f", m_CandidateFilter.GetMin(CandidateColumn(column)));
+                    ImPlot::PlotText(text, column, -0.05);
+                }
+
+                ImPlot::EndPlot();
+            }
+        }
+        ImGui::End();
+    }
+
     void EditorLayer::DrawTopMenu()
     {
         if (ImGui::BeginMenuBar())
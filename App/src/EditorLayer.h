@@ -1,11 +1,25 @@
 #pragma once
 
+#include <atomic>
+#include <future>
+
 #include "Engine/Buffers/FrameBuffer.h"
+#include "Engine/Buffers/UniformBuffer.h"
 #include "Engine/Layers/Layer.h"
 #include "Engine/Shader/Shader.h"
+#include "Engine/Utils/FileWatcher.h"
 
+#include "Calculations/CandidateFilter.h"
 #include "Calculations/Calculations.h"
+#include "Calculations/ObjectiveHeatmap.h"
+#include "Calculations/Refinement.h"
+#include "Calculations/SweepRunner.h"
+#include "Calculations/ToleranceAnalysis.h"
 #include "Graphics/SimpleRenderable2D.h"
+#include "Graphics/WheelEnvelope.h"
+#include "Graphics/WheelOverlay.h"
+#include "Gui/PlotLod.h"
+#include "Gui/PlotSelection.h"
 
 namespace LM
 {
@@ -20,10 +34,54 @@ namespace LM
         void OnImGuiRender() override;
 
     protected:
-        void Calculate();
+        // Everything the "Output Wheel" image depends on besides meshes and results, which set m_ViewDirty
+        struct ViewState
+        {
+            float CameraAngleX = 0.0f;
+            float CameraZoom = 0.0f;
+            GrindingWheelParams Wheel = {};
+            GrindingWheelProfileParams Profile = {};
+            ToolParams Tool = {};
+            float Rotation = 0.0f;
+            bool UseDepthTest = false;
+            bool DrawPolygonsAsLines = false;
+            bool DrawStartShape = false;
+            bool DrawTopResults = false;
+            bool DrawEnvelope = false;
+
+            bool operator==(const ViewState&) const = default;
+        };
+
+        // Sweep runs in the background, its result is set on the next update after it is done
+        struct SweepCalculation
+        {
+            SweepJob Job;
+            SweepResult Result;
+            bool IsCompleted = false;
+        };
+
+        struct SweepCalculationProgress
+        {
+            std::atomic<uint32_t> CompletedChunks = 0;
+            std::atomic<uint32_t> ChunksCount = 0;
+            std::atomic<bool> Cancel = false;
+        };
+
+    protected:
+        SweepJob CreateSweepJob() const;
+        void Calculate(bool _Resume);
+        void UpdateCalculation();
+        void SetSweepResult(const SweepJob& _Job, const SweepResult& _Result);
+        void RefineSweepResult();
 
         void SetAutoCameraZoom();
 
+        void ReloadChangedShaders();
+
+        ViewState GetViewState() const;
+        void UpdateFrameBufferSize();
+        void UpdateCurveTolerance();
+
         void CreateGrindingWheelShape();
         void CreateToolShape();
 
@@ -31,21 +89,56 @@ namespace LM
 
         void ImGuiDrawWheelCalcParams();
 
-        void DrawPlots() const;
+        void StartToleranceAnalysis();
+
+        void DrawPlots();
+        void DrawResultPlotMarkers(PlotSource _Source, const std::vector<double>& _Xs,
+                                   const std::vector<double>& _FrontAngle, const std::vector<double>& _StepAngle,
+                                   const std::vector<double>& _DiametrIn, double _SelectedX) const;
+        PlotItem CreateCandidateItem(int64_t _Index) const;
+        void DrawCandidatesSelection(const PlotHitGrid& _HitGrid, CandidateColumn _X, CandidateColumn _Y);
+        void DrawSelectedItem();
+        void DrawToleranceAnalysis();
+        void DrawSensitivity();
+        void DrawObjectiveHeatmap();
+        void DrawCandidates();
+        void DrawParallelCoordinates();
         void DrawTopMenu();
         void DrawAll();
 
     protected:
         SimpleRenderable2D m_WheelShape;
         SimpleRenderable2D m_ToolShape;
+        WheelOverlay m_TopResultsOverlay;
+        WheelEnvelope m_WheelEnvelope;
 
         Ref<Shader> m_Shader;
+        Ref<Shader> m_OverlayShader;
+        Ref<UniformBuffer> m_CameraUniformBuffer;
+        UniformHandle m_ModelMatrixUniform;
+        UniformHandle m_ColorUniform;
+        FileWatcher m_ShaderWatcher;
         Ref<FrameBuffer> m_FrameBuffer;
 
+        // Pixel size of the "Output Wheel" image on the last frame
+        uint32_t m_ViewportSize = 0;
+        bool m_ViewportVisible = true;
+        float m_Supersampling = 1.0f;
+        int m_MsaaSamples = 4;
+        bool m_ViewDirty = true;
+        ViewState m_LastViewState;
+        // Chord error of the wheel and tool meshes
+        float m_CurveTolerance = 0.0f;
+
         float m_CameraAngleX = 0.0f;
         float m_CameraZoom = 0.0f;
 
         bool m_NeedDrawGrindingWheelStartShape = false;
+        bool m_NeedDrawTopResults = false;
+        int m_TopResultsDrawCount = int(kSweepDefaultTopCount);
+        bool m_NeedDrawEnvelope = false;
+        int m_EnvelopeSamplesCount = 256;
+        int m_EnvelopeRaysCount = 2048;
 
         bool m_UseDepthTest = false;
         bool m_DrawPolygonsAsLines = false;
@@ -58,8 +151,71 @@ namespace LM
 
         ToolParams m_ToolParams;
 
+        // Job which produced m_TopResults, the inputs may have been changed since
+        SweepJob m_SweepJob;
         bool m_HasBestResult = false;
         BestResult m_BestResult;
+        std::vector<SweepCandidate> m_TopResults;
+        int m_TopResultsCount = int(kSweepDefaultTopCount);
+        int m_RefinedResultsCount = int(kRefinementDefaultCount);
+        bool m_HasRefinementResult = false;
+        RefinementResult m_RefinementResult;
+
+        // Candidates of the last calculation for the plots, LODs are built once after the calculation
+        int m_CandidatesLimit = 1000000;
+        CandidateStore m_Candidates;
+        ScatterPlotLod m_ScatterLod;
+        PlotHitGrid m_ScatterHitGrid;
+        CandidateColumn m_ScatterX = CandidateColumn::StepAngle;
+        CandidateColumn m_ScatterY = CandidateColumn::FrontAngle;
+        bool m_ScatterLodDirty = true;
+        LinePlotLod m_LineLod;
+        PlotHitGrid m_LineHitGrid;
+        CandidateColumn m_LineX = CandidateColumn::RotationAngle;
+        CandidateColumn m_LineY = CandidateColumn::Delta;
+        LineLodMode m_LineLodMode = LineLodMode::MinMax;
+        bool m_LineLodDirty = true;
+
+        // Hovered and selected items of all plots, the selected one is drawn in "Output Wheel"
+        PlotSelection m_PlotSelection;
+
+        // Parallel coordinates draw a sample of the brushed candidates over a sample of all of them
+        CandidateFilter m_CandidateFilter;
+        int m_ParallelLinesCount = 2000;
+        std::vector<uint32_t> m_ParallelLines;
+        std::vector<uint32_t> m_ParallelBackgroundLines;
+        bool m_ParallelLinesDirty = true;
+        int m_BrushColumn = -1;
+        double m_BrushStart = 0.0;
+
+        // Tolerances of the inputs, nominal values are taken from the best result on start
+        ToleranceAnalysisParams m_ToleranceParams;
+        int m_ToleranceSamplesCount = 1000000;
+        int m_ToleranceSeed = 0;
+        int m_ToleranceBinsCount = 64;
+        ToleranceAnalysisProgress m_ToleranceProgress;
+        std::future<ToleranceAnalysisResult> m_ToleranceFuture;
+        bool m_HasToleranceResult = false;
+        ToleranceAnalysisResult m_ToleranceResult;
+
+        // Other axes are taken from the best result, ranges of the axes from the calc params
+        ObjectiveHeatmap m_Heatmap;
+        int m_HeatmapAxisX = 5;
+        int m_HeatmapAxisY = 7;
+        HeatmapOutput m_HeatmapOutput = HeatmapOutput::Delta;
+        int m_HeatmapResolution = 1024;
+
+        SweepSampling m_SweepSampling = SweepSampling::Grid;
+        int m_SamplesCount = 100000;
+
+        SweepCalculationProgress m_CalculationProgress;
+        std::future<SweepCalculation> m_CalculationFuture;
+
+        bool m_UseCheckpoint = false;
+        char m_CheckpointPath[256] = "sweep/checkpoint.json";
+
+        char m_ShardsDir[256] = "sweep";
+        int m_ShardsCount = 4;
     };
 
 }    // namespace LM
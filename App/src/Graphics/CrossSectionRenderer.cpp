@@ -0,0 +1,157 @@
+#include "CrossSectionRenderer.h"
+
+#include "GraphicsUtils.h"
+#include "WheelMesh.h"
+
+#include "GL/glew.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace LM
+{
+
+    const glm::vec4 kBackgroundColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+    const glm::vec4 kToolColor = { 0.0f, 0.0f, 1.0f, 1.0f };
+    const glm::vec4 kEnvelopeColor = { 1.0f, 0.5f, 0.0f, 1.0f };
+    const glm::vec4 kWheelColor = { 1.0f, 0.0f, 0.0f, 1.0f };
+
+    static CameraUniforms GetCameraUniforms(float _CameraZoom)
+    {
+        return {
+            glm::ortho(-_CameraZoom, _CameraZoom, -_CameraZoom, _CameraZoom, -10000.0f, 10000.0f),
+            glm::lookAt(glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)),
+        };
+    }
+
+    // The tool is drawn a bit behind, so the depth test never hides the wheel
+    static glm::mat4 GetToolModelMatrix() { return glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -0.0001f)); }
+
+    static glm::mat4 GetWheelModelMatrix(const BestResult& _Result)
+    {
+        return GetGrindingWheelMatrix(_Result.OffsetToolCenter, _Result.OffsetToolAxis, _Result.RotationAngle, 0.0f);
+    }
+
+    static GrindingWheelParams GetWheelParams(const BestResult& _Result)
+    {
+        return { _Result.Diametr, _Result.Width, _Result.R1, _Result.R2, _Result.Angle };
+    }
+
+    CrossSectionRenderer::CrossSectionRenderer()
+    {
+        m_Shader = Shader::Create(ShaderLayout(
+            {
+                {ShaderDataType::Float4, "a_Position"},
+        },
+            { { ShaderSource::Type::VERTEX, ShaderSource::FromFile(RES_FOLDER "assets/shaders/test.vert") },
+              { ShaderSource::Type::FRAGMENT, ShaderSource::FromFile(RES_FOLDER "assets/shaders/test.frag") } }));
+
+        m_CameraUniformBuffer = UniformBuffer::Create(sizeof(CameraUniforms));
+        m_ModelMatrixUniform = m_Shader->GetUniform("u_ModelMatrix");
+        m_ColorUniform = m_Shader->GetUniform("u_Color");
+    }
+
+    float CrossSectionRenderer::GetCameraZoom(const BestResult& _Result, const ToolParams& _Tool)
+    {
+        return glm::max(glm::max(_Result.Diametr / 2.0f + glm::abs(_Result.OffsetToolCenter),
+                                 _Result.Width + glm::abs(_Result.OffsetToolAxis)),
+                        _Tool.Diametr / 2.0f) *
+               1.1f;
+    }
+
+    void CrossSectionRenderer::SetTool(const ToolParams& _Tool, float _Tolerance)
+    {
+        if (m_HasTool && m_Tool == _Tool && m_ToolTolerance == _Tolerance)
+        {
+            return;
+        }
+
+        std::vector<glm::vec4> vertices;
+        std::vector<uint32_t> indices;
+        CreateToolMesh(_Tool, _Tolerance, vertices, indices);
+        m_ToolShape.SetData(vertices, indices);
+
+        m_HasTool = true;
+        m_Tool = _Tool;
+        m_ToolTolerance = _Tolerance;
+    }
+
+    void CrossSectionRenderer::Render(const Ref<FrameBuffer>& _FrameBuffer, const ToolParams& _Tool,
+                                      const BestResult& _Result, const WheelEnvelopeMesh* _Envelope)
+    {
+        float tolerance = GetCurveTolerance(m_CameraZoom, _FrameBuffer->GetWidth());
+        SetTool(_Tool, tolerance);
+
+        std::vector<glm::vec4> vertices;
+        std::vector<uint32_t> indices;
+        CreateGrindingWheelMesh(GetWheelParams(_Result), tolerance, vertices, indices);
+        m_WheelShape.SetData(vertices, indices);
+
+        if (_Envelope)
+        {
+            m_EnvelopeShape.SetData(_Envelope->Vertices, _Envelope->Indices);
+        }
+
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LEQUAL);
+
+        _FrameBuffer->Bind();
+        _FrameBuffer->Clear(kBackgroundColor);
+
+        m_Shader->Enable();
+
+        CameraUniforms cameraUniforms = GetCameraUniforms(m_CameraZoom);
+        m_CameraUniformBuffer->SetData(&cameraUniforms, sizeof(CameraUniforms));
+        m_CameraUniformBuffer->Bind(kCameraUniformsSlot);
+
+        m_Shader->SetUniform4f(m_ColorUniform, kToolColor);
+        m_Shader->SetUniformMat4(m_ModelMatrixUniform, GetToolModelMatrix());
+        m_ToolShape.Draw();
+
+        if (_Envelope)
+        {
+            m_Shader->SetUniform4f(m_ColorUniform, kEnvelopeColor);
+            m_Shader->SetUniformMat4(m_ModelMatrixUniform, glm::mat4(1.0f));
+            m_EnvelopeShape.Draw();
+        }
+
+        m_Shader->SetUniform4f(m_ColorUniform, kWheelColor);
+        m_Shader->SetUniformMat4(m_ModelMatrixUniform, GetWheelModelMatrix(_Result));
+        m_WheelShape.Draw();
+
+        m_Shader->Disable();
+        _FrameBuffer->Unbind();
+    }
+
+    CrossSectionRasterizer::CrossSectionRasterizer(uint32_t _Size, uint32_t _Samples)
+        : m_Rasterizer(_Size, _Size, _Samples)
+    {
+    }
+
+    void CrossSectionRasterizer::Render(RasterImage& _Image, const ToolParams& _Tool, const BestResult& _Result,
+                                        const WheelEnvelopeMesh* _Envelope)
+    {
+        float tolerance = GetCurveTolerance(m_CameraZoom, m_Rasterizer.GetWidth());
+        if (!m_HasTool || !(m_Tool == _Tool) || m_ToolTolerance != tolerance)
+        {
+            CreateToolMesh(_Tool, tolerance, m_ToolVertices, m_ToolIndices);
+            m_HasTool = true;
+            m_Tool = _Tool;
+            m_ToolTolerance = tolerance;
+        }
+        CreateGrindingWheelMesh(GetWheelParams(_Result), tolerance, m_WheelVertices, m_WheelIndices);
+
+        CameraUniforms camera = GetCameraUniforms(m_CameraZoom);
+        m_Rasterizer.SetViewProjection(camera.ProjectionMatrix * camera.ViewMatrix);
+        m_Rasterizer.Clear(kBackgroundColor);
+
+        m_Rasterizer.DrawTriangles(m_ToolVertices, m_ToolIndices, GetToolModelMatrix(), kToolColor);
+        if (_Envelope)
+        {
+            m_Rasterizer.DrawTriangles(_Envelope->Vertices, _Envelope->Indices, glm::mat4(1.0f), kEnvelopeColor);
+        }
+        m_Rasterizer.DrawTriangles(m_WheelVertices, m_WheelIndices, GetWheelModelMatrix(_Result), kWheelColor);
+
+        m_Rasterizer.Resolve(_Image);
+    }
+
+}    // namespace LM
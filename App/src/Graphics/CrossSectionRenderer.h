@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Engine/Buffers/FrameBuffer.h"
+#include "Engine/Buffers/UniformBuffer.h"
+#include "Engine/Shader/Shader.h"
+
+#include "Calculations/Calculations.h"
+#include "SimpleRenderable2D.h"
+#include "SoftwareRasterizer.h"
+#include "WheelEnvelope.h"
+
+namespace LM
+{
+
+    // Draws one candidate like the "Output Wheel" view of the editor: the tool cross section, the groove cut by the
+    // wheel (optional) and the wheel at the start of its rotation. Uses the editor shaders, needs a current context
+    class CrossSectionRenderer
+    {
+    public:
+        CrossSectionRenderer();
+
+        // Half size of the view which fits the wheel pose and the tool
+        static float GetCameraZoom(const BestResult& _Result, const ToolParams& _Tool);
+        void SetCameraZoom(float _Zoom) { m_CameraZoom = _Zoom; }
+
+        void Render(const Ref<FrameBuffer>& _FrameBuffer, const ToolParams& _Tool, const BestResult& _Result,
+                    const WheelEnvelopeMesh* _Envelope = nullptr);
+
+    protected:
+        void SetTool(const ToolParams& _Tool, float _Tolerance);
+
+    protected:
+        Ref<Shader> m_Shader;
+        Ref<UniformBuffer> m_CameraUniformBuffer;
+        UniformHandle m_ModelMatrixUniform;
+        UniformHandle m_ColorUniform;
+
+        SimpleRenderable2D m_ToolShape;
+        SimpleRenderable2D m_WheelShape;
+        SimpleRenderable2D m_EnvelopeShape;
+
+        bool m_HasTool = false;
+        ToolParams m_Tool;
+        float m_ToolTolerance = 0.0f;
+        float m_CameraZoom = 100.0f;
+    };
+
+    // Same image as CrossSectionRenderer made by SoftwareRasterizer, no OpenGL is needed. Differs from the OpenGL one
+    // only on antialiased edges
+    class CrossSectionRasterizer
+    {
+    public:
+        CrossSectionRasterizer(uint32_t _Size, uint32_t _Samples);
+
+        void SetCameraZoom(float _Zoom) { m_CameraZoom = _Zoom; }
+
+        // Rows of the image go from the top to the bottom
+        void Render(RasterImage& _Image, const ToolParams& _Tool, const BestResult& _Result,
+                    const WheelEnvelopeMesh* _Envelope = nullptr);
+
+    protected:
+        SoftwareRasterizer m_Rasterizer;
+
+        bool m_HasTool = false;
+        ToolParams m_Tool;
+        float m_ToolTolerance = 0.0f;
+        std::vector<glm::vec4> m_ToolVertices;
+        std::vector<uint32_t> m_ToolIndices;
+        std::vector<glm::vec4> m_WheelVertices;
+        std::vector<uint32_t> m_WheelIndices;
+
+        float m_CameraZoom = 100.0f;
+    };
+
+}    // namespace LM
@@ -18,6 +18,26 @@ namespace LM
         }
     }
 
+    size_t GetCircleCurveSections(const CurcleCurveProps& _Props, float _Tolerance)
+    {
+        float span = glm::abs(_Props.AngleEnd - _Props.AngleStart);
+        size_t minSections = glm::max(size_t(glm::ceil(span / 90.0f)), size_t(1));
+        if (_Props.Radius <= _Tolerance)
+        {
+            return minSections;
+        }
+
+        // Chord of the angle a is R * (1 - cos(a / 2)) away from the arc
+        float sectionAngle = glm::degrees(2.0f * glm::acos(1.0f - _Tolerance / _Props.Radius));
+        size_t sections = sectionAngle > 0.0f ? size_t(glm::ceil(span / sectionAngle)) : kMaxCurveSections;
+        return glm::clamp(sections, minSections, kMaxCurveSections);
+    }
+
+    float GetCurveTolerance(float _CameraZoom, uint32_t _PixelsCount)
+    {
+        return kCurvePixelTolerance * 2.0f * _CameraZoom / float(glm::max(_PixelsCount, 1u));
+    }
+
     void IndicesAddTriangle(std::vector<uint32_t>& _Indices, uint32_t _VertId0, uint32_t _VertId1, uint32_t _VertId2)
     {
         _Indices.emplace_back(_VertId0);
@@ -7,6 +7,14 @@
 namespace LM
 {
 
+    // "Camera" uniform block of the shaders, std140 layout
+    struct CameraUniforms
+    {
+        glm::mat4 ProjectionMatrix;
+        glm::mat4 ViewMatrix;
+    };
+    constexpr uint32_t kCameraUniformsSlot = 0;
+
     struct CurcleCurveProps
     {
         float AngleStart;
@@ -16,8 +24,19 @@ namespace LM
         float CenterY;
     };
 
+    // Chord error of curves drawn on the screen, in pixels
+    constexpr float kCurvePixelTolerance = 0.1f;
+    constexpr size_t kMaxCurveSections = 4096;
+
     void AddCircleCurve(CurcleCurveProps _Props, size_t _Sections, std::vector<glm::vec4>& _Vertices);
 
+    // Sections of the arc which keep the distance between the chords and the arc below _Tolerance. A section is never
+    // longer than 90 degrees, so a circle with a huge tolerance is still a square
+    size_t GetCircleCurveSections(const CurcleCurveProps& _Props, float _Tolerance);
+
+    // Chord tolerance for the orthographic camera from -_CameraZoom to _CameraZoom on _PixelsCount pixels
+    float GetCurveTolerance(float _CameraZoom, uint32_t _PixelsCount);
+
     void IndicesAddTriangle(std::vector<uint32_t>& _Indices, uint32_t _VertId0, uint32_t _VertId1, uint32_t _VertId2);
 
 }    // namespace LM
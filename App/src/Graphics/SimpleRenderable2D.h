@@ -2,7 +2,7 @@
 
 #include <vector>
 
-#include "Engine/Buffers/VertexArray.h"
+#include "Engine/Buffers/DynamicMesh.h"
 
 #include "glm/glm.hpp"
 
@@ -12,12 +12,14 @@ namespace LM
     class SimpleRenderable2D
     {
     public:
-        Ref<VertexBuffer> m_Vertices;
-        Ref<IndexBuffer> m_Indices;
-        Ref<VertexArray> m_VertexArray;
-
-        void Create(const std::vector<glm::vec4>& _Vertices, const std::vector<uint32_t>& _Indices);
+        // Mesh is created on the first call, next calls update it in place
+        void SetData(const std::vector<glm::vec4>& _Vertices, const std::vector<uint32_t>& _Indices);
         void Draw() const;
+
+        uint32_t GetVerticesCount() const { return m_Mesh ? m_Mesh->GetVerticesCount() : 0; }
+
+    protected:
+        Ref<DynamicMesh> m_Mesh;
     };
 
 }    // namespace LM
@@ -0,0 +1,302 @@
+#include "SoftwareRasterizer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <execution>
+#include <numeric>
+
+#include "Math/SimdOps.h"
+
+namespace LM
+{
+
+    constexpr uint32_t kTileSize = 64;
+
+    // Standard multisample positions inside a pixel (Direct3D patterns, OpenGL implementations use the same ones)
+    const glm::vec2 kSamplePositions1[] = {
+        {0.5f, 0.5f}
+    };
+    const glm::vec2 kSamplePositions2[] = {
+        {0.75f, 0.75f},
+        {0.25f, 0.25f},
+    };
+    const glm::vec2 kSamplePositions4[] = {
+        {0.375f, 0.125f},
+        {0.875f, 0.375f},
+        {0.125f, 0.625f},
+        {0.625f, 0.875f},
+    };
+    const glm::vec2 kSamplePositions8[] = {
+        {0.5625f, 0.3125f},
+        {0.4375f, 0.6875f},
+        {0.8125f, 0.5625f},
+        {0.3125f, 0.1875f},
+        {0.1875f, 0.8125f},
+        {0.0625f, 0.4375f},
+        {0.6875f, 0.9375f},
+        {0.9375f, 0.0625f},
+    };
+
+    const float kLaneOffsets[] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+    static_assert(SimdOps::kWidth <= std::size(kLaneOffsets));
+
+    static uint32_t PackColor(const glm::vec4& _Color)
+    {
+        glm::uvec4 color = glm::uvec4(glm::clamp(_Color, 0.0f, 1.0f) * 255.0f + 0.5f);
+        return color.x | (color.y << 8) | (color.z << 16) | (color.w << 24);
+    }
+
+    static glm::vec4 UnpackColor(uint32_t _Color)
+    {
+        return glm::vec4(_Color & 0xff, (_Color >> 8) & 0xff, (_Color >> 16) & 0xff, _Color >> 24) / 255.0f;
+    }
+
+    SoftwareRasterizer::SoftwareRasterizer(uint32_t _Width, uint32_t _Height, uint32_t _Samples)
+        : m_Width(std::max(_Width, 1u)), m_Height(std::max(_Height, 1u))
+    {
+        if (_Samples >= 8)
+        {
+            m_Samples = 8;
+            m_SamplePositions = kSamplePositions8;
+        }
+        else if (_Samples >= 4)
+        {
+            m_Samples = 4;
+            m_SamplePositions = kSamplePositions4;
+        }
+        else if (_Samples >= 2)
+        {
+            m_Samples = 2;
+            m_SamplePositions = kSamplePositions2;
+        }
+        else
+        {
+            m_Samples = 1;
+            m_SamplePositions = kSamplePositions1;
+        }
+
+        m_TilesX = (m_Width + kTileSize - 1) / kTileSize;
+        m_TilesY = (m_Height + kTileSize - 1) / kTileSize;
+        m_TileTriangles.resize(size_t(m_TilesX) * m_TilesY);
+
+        m_SampleColors.resize(size_t(m_Width) * m_Height * m_Samples);
+    }
+
+    void SoftwareRasterizer::Clear(const glm::vec4& _Color)
+    {
+        m_Draws.clear();
+        m_Triangles.clear();
+        std::fill(m_SampleColors.begin(), m_SampleColors.end(), PackColor(_Color));
+    }
+
+    void SoftwareRasterizer::DrawTriangles(const std::vector<glm::vec4>& _Vertices,
+                                           const std::vector<uint32_t>& _Indices, const glm::mat4& _Model,
+                                           const glm::vec4& _Color)
+    {
+        uint32_t drawId = uint32_t(m_Draws.size());
+        m_Draws.push_back({ _Color, PackColor(_Color), _Color.w >= 1.0f });
+
+        const glm::mat4 transform = m_ViewProjection * _Model;
+        const glm::vec2 size = glm::vec2(m_Width, m_Height);
+
+        m_Points.resize(_Vertices.size());
+        for (size_t i = 0; i < _Vertices.size(); i++)
+        {
+            glm::vec4 clip = transform * _Vertices[i];
+            glm::vec2 ndc = glm::vec2(clip) / clip.w;
+            m_Points[i] = glm::vec2(ndc.x * 0.5f + 0.5f, 0.5f - ndc.y * 0.5f) * size;
+        }
+
+        for (size_t i = 0; i + 2 < _Indices.size(); i += 3)
+        {
+            Triangle triangle;
+            triangle.Points[0] = m_Points[_Indices[i]];
+            triangle.Points[1] = m_Points[_Indices[i + 1]];
+            triangle.Points[2] = m_Points[_Indices[i + 2]];
+
+            glm::vec2 edge1 = triangle.Points[1] - triangle.Points[0];
+            glm::vec2 edge2 = triangle.Points[2] - triangle.Points[0];
+            float area = edge1.x * edge2.y - edge1.y * edge2.x;
+            if (!(area != 0.0f))
+            {
+                continue;
+            }
+            // Counter-clockwise in pixel space, so all edge functions are positive inside
+            if (area < 0.0f)
+            {
+                std::swap(triangle.Points[1], triangle.Points[2]);
+            }
+
+            glm::vec2 min = glm::min(glm::min(triangle.Points[0], triangle.Points[1]), triangle.Points[2]);
+            glm::vec2 max = glm::max(glm::max(triangle.Points[0], triangle.Points[1]), triangle.Points[2]);
+            if (max.x < 0.0f || max.y < 0.0f || min.x >= size.x || min.y >= size.y)
+            {
+                continue;
+            }
+            triangle.Min = glm::max(glm::ivec2(glm::floor(min)), glm::ivec2(0));
+            triangle.Max = glm::min(glm::ivec2(glm::floor(max)), glm::ivec2(m_Width - 1, m_Height - 1));
+            triangle.DrawId = drawId;
+
+            m_Triangles.push_back(triangle);
+        }
+    }
+
+    void SoftwareRasterizer::Resolve(RasterImage& _Image)
+    {
+        // Tiles keep the draw order of their triangles, so every tile is independent
+        for (std::vector<uint32_t>& tileTriangles : m_TileTriangles)
+        {
+            tileTriangles.clear();
+        }
+        for (uint32_t i = 0; i < m_Triangles.size(); i++)
+        {
+            const Triangle& triangle = m_Triangles[i];
+            for (int tileY = triangle.Min.y / kTileSize; tileY <= triangle.Max.y / int(kTileSize); tileY++)
+            {
+                for (int tileX = triangle.Min.x / kTileSize; tileX <= triangle.Max.x / int(kTileSize); tileX++)
+                {
+                    m_TileTriangles[size_t(tileY) * m_TilesX + tileX].push_back(i);
+                }
+            }
+        }
+
+        std::vector<uint32_t> tiles(m_TileTriangles.size());
+        std::iota(tiles.begin(), tiles.end(), 0);
+        std::for_each(std::execution::par, tiles.begin(), tiles.end(),
+                      [this](uint32_t _Tile) { RasterizeTile(_Tile % m_TilesX, _Tile / m_TilesX); });
+
+        _Image.Width = m_Width;
+        _Image.Height = m_Height;
+        _Image.Pixels.resize(size_t(m_Width) * m_Height * 4);
+
+        std::vector<uint32_t> rows(m_Height);
+        std::iota(rows.begin(), rows.end(), 0);
+        // Samples count is a power of two, so the average is a shift. Two channels are summed at once in 16 bit
+        // halves of a 32 bit value, 8 samples of 255 fit into them
+        const uint32_t shift = uint32_t(std::countr_zero(m_Samples));
+        const uint32_t rounding = (m_Samples / 2) * 0x00010001u;
+        std::for_each(std::execution::par_unseq, rows.begin(), rows.end(), [=, this, &_Image](uint32_t _Y) {
+            const uint32_t* samples = m_SampleColors.data() + size_t(_Y) * m_Width * m_Samples;
+            uint8_t* pixels = _Image.Pixels.data() + size_t(_Y) * m_Width * 4;
+            for (uint32_t x = 0; x < m_Width; x++, samples += m_Samples, pixels += 4)
+            {
+                uint32_t redBlue = rounding;
+                uint32_t greenAlpha = rounding;
+                for (uint32_t s = 0; s < m_Samples; s++)
+                {
+                    redBlue += samples[s] & 0x00ff00ffu;
+                    greenAlpha += (samples[s] >> 8) & 0x00ff00ffu;
+                }
+                uint32_t color = ((redBlue >> shift) & 0x00ff00ffu) | (((greenAlpha >> shift) & 0x00ff00ffu) << 8);
+                std::memcpy(pixels, &color, sizeof(color));
+            }
+        });
+
+        m_Draws.clear();
+        m_Triangles.clear();
+    }
+
+    void SoftwareRasterizer::RasterizeTile(uint32_t _TileX, uint32_t _TileY)
+    {
+        glm::ivec2 tileMin = glm::ivec2(_TileX, _TileY) * int(kTileSize);
+        glm::ivec2 tileMax = glm::min(tileMin + int(kTileSize - 1), glm::ivec2(m_Width - 1, m_Height - 1));
+
+        for (uint32_t triangleId : m_TileTriangles[size_t(_TileY) * m_TilesX + _TileX])
+        {
+            const Triangle& triangle = m_Triangles[triangleId];
+            RasterizeTriangle(triangle, glm::max(triangle.Min, tileMin), glm::min(triangle.Max, tileMax));
+        }
+    }
+
+    void SoftwareRasterizer::RasterizeTriangle(const Triangle& _Triangle, glm::ivec2 _Min, glm::ivec2 _Max)
+    {
+        typedef SimdOps::Float Float;
+        typedef SimdOps::Mask Mask;
+
+        const Draw& draw = m_Draws[_Triangle.DrawId];
+        const Float laneOffsets = SimdOps::Load(kLaneOffsets);
+        const Float zero = SimdOps::Set(0.0f);
+
+        // Edge function of the edge from A to B: E(p) = StepX * (p.x - A.x) + StepY * (p.y - A.y), E >= 0 inside.
+        // Samples exactly on an edge shared by two triangles are covered by both
+        float stepsX[3];
+        float stepsY[3];
+        for (int edge = 0; edge < 3; edge++)
+        {
+            glm::vec2 a = _Triangle.Points[edge];
+            glm::vec2 b = _Triangle.Points[(edge + 1) % 3];
+            stepsX[edge] = a.y - b.y;
+            stepsY[edge] = b.x - a.x;
+        }
+
+        for (int y = _Min.y; y <= _Max.y; y++)
+        {
+            // Fan triangles are thin, so only the span of the row between the edges is tested. Edges are crossed
+            // somewhere between the top and the bottom of the row, a pixel is in the span if any of its samples can be
+            float spanBegin = float(_Min.x);
+            float spanEnd = float(_Max.x);
+            for (int edge = 0; edge < 3; edge++)
+            {
+                if (stepsX[edge] == 0.0f)
+                {
+                    continue;
+                }
+
+                glm::vec2 a = _Triangle.Points[edge];
+                float topX = a.x - stepsY[edge] * (float(y) - a.y) / stepsX[edge];
+                float bottomX = a.x - stepsY[edge] * (float(y + 1) - a.y) / stepsX[edge];
+                // Samples of pixel x are in [x, x + 1)
+                if (stepsX[edge] > 0.0f)
+                {
+                    spanBegin = std::max(spanBegin, std::min(topX, bottomX) - 1.0f);
+                }
+                else
+                {
+                    spanEnd = std::min(spanEnd, std::max(topX, bottomX));
+                }
+            }
+            if (spanBegin > spanEnd)
+            {
+                continue;
+            }
+
+            const int xEnd = int(spanEnd);
+            for (int x = int(spanBegin); x <= xEnd; x += int(SimdOps::kWidth))
+            {
+                uint32_t lanesCount = std::min(uint32_t(xEnd - x + 1), uint32_t(SimdOps::kWidth));
+                uint32_t lanesMask = lanesCount >= 32 ? ~0u : (1u << lanesCount) - 1;
+                uint32_t* pixelSamples = m_SampleColors.data() + (size_t(y) * m_Width + x) * m_Samples;
+
+                for (uint32_t s = 0; s < m_Samples; s++)
+                {
+                    glm::vec2 sample = glm::vec2(x, y) + m_SamplePositions[s];
+
+                    Mask inside = SimdOps::LessEqual(zero, zero);
+                    for (int edge = 0; edge < 3; edge++)
+                    {
+                        glm::vec2 delta = sample - _Triangle.Points[edge];
+                        float value = stepsX[edge] * delta.x + stepsY[edge] * delta.y;
+                        Float values = SimdOps::MulAdd(SimdOps::Set(stepsX[edge]), laneOffsets, SimdOps::Set(value));
+                        inside = SimdOps::And(inside, SimdOps::LessEqual(zero, values));
+                    }
+
+                    for (uint32_t lanes = SimdOps::MoveMask(inside) & lanesMask; lanes; lanes &= lanes - 1)
+                    {
+                        uint32_t& color = pixelSamples[size_t(std::countr_zero(lanes)) * m_Samples + s];
+                        if (draw.IsOpaque)
+                        {
+                            color = draw.PackedColor;
+                        }
+                        else
+                        {
+                            glm::vec4 destination = UnpackColor(color);
+                            color = PackColor(draw.Color * draw.Color.w + destination * (1.0f - draw.Color.w));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+}    // namespace LM
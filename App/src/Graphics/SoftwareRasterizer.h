@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace LM
+{
+
+    // RGBA8 pixels, rows go from the top to the bottom
+    struct RasterImage
+    {
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        std::vector<uint8_t> Pixels;
+    };
+
+    // CPU replacement of the OpenGL path for flat colored 2D meshes (the data SimpleRenderable2D::SetData gets), for
+    // machines without any OpenGL. Draws are recorded and rasterized together on Resolve(): triangles are binned into
+    // tiles, tiles are processed in parallel and every tile evaluates edge functions for SimdOps::kWidth pixels at
+    // once. Antialiasing uses 1, 2, 4 or 8 samples per pixel with the standard MSAA patterns.
+    // There is no depth test, triangles cover each other in the draw order (later on top) and are blended with
+    // GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA. No face culling, both windings are filled
+    class SoftwareRasterizer
+    {
+    public:
+        SoftwareRasterizer(uint32_t _Width, uint32_t _Height, uint32_t _Samples = 4);
+
+        uint32_t GetWidth() const { return m_Width; }
+        uint32_t GetHeight() const { return m_Height; }
+        uint32_t GetSamples() const { return m_Samples; }
+
+        // Drops recorded draws, all samples get the color
+        void Clear(const glm::vec4& _Color);
+
+        // Projection * view, maps to normalized device coordinates like the Camera uniform block
+        void SetViewProjection(const glm::mat4& _ViewProjection) { m_ViewProjection = _ViewProjection; }
+
+        // Triangles _Indices[3 * i .. 3 * i + 2] of _Vertices moved by _Model
+        void DrawTriangles(const std::vector<glm::vec4>& _Vertices, const std::vector<uint32_t>& _Indices,
+                           const glm::mat4& _Model, const glm::vec4& _Color);
+
+        // Rasterizes the recorded draws and averages the samples of every pixel
+        void Resolve(RasterImage& _Image);
+
+    protected:
+        struct Triangle
+        {
+            // Pixel space, y goes down
+            glm::vec2 Points[3];
+            glm::ivec2 Min;
+            glm::ivec2 Max;
+            uint32_t DrawId;
+        };
+
+        struct Draw
+        {
+            glm::vec4 Color;
+            uint32_t PackedColor;
+            bool IsOpaque;
+        };
+
+        void RasterizeTile(uint32_t _TileX, uint32_t _TileY);
+        void RasterizeTriangle(const Triangle& _Triangle, glm::ivec2 _Min, glm::ivec2 _Max);
+
+    protected:
+        uint32_t m_Width;
+        uint32_t m_Height;
+        uint32_t m_Samples;
+        const glm::vec2* m_SamplePositions;
+
+        uint32_t m_TilesX;
+        uint32_t m_TilesY;
+
+        glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+
+        std::vector<Draw> m_Draws;
+        std::vector<Triangle> m_Triangles;
+        // Triangles of every tile in the draw order
+        std::vector<std::vector<uint32_t>> m_TileTriangles;
+        // Vertices of the current draw in pixel space
+        std::vector<glm::vec2> m_Points;
+
+        // m_Samples packed RGBA8 values for every pixel, samples of one pixel are next to each other
+        std::vector<uint32_t> m_SampleColors;
+    };
+
+}    // namespace LM
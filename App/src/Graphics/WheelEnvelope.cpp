@@ -0,0 +1,352 @@
+#include "WheelEnvelope.h"
+
+#include <algorithm>
+#include <chrono>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#include "WheelMesh.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace LM
+{
+
+    // Chord error of the wheel arcs, the envelope is calculated once for all zooms
+    constexpr float kEnvelopeTolerance = 0.005f;
+
+    // Radial gap, relative to the tool radius, which is closed when two intervals of a ray are merged. Triangles of one
+    // pose share edges, so their intervals touch up to the float error
+    constexpr float kEnvelopeIntervalEpsilon = 1e-5f;
+
+    // Sorted disjoint radius ranges { begin, end } along a ray which are inside the wheel in any pose
+    typedef std::vector<glm::vec2> EnvelopeIntervals;
+
+    static float Cross(glm::vec2 _Lhs, glm::vec2 _Rhs) { return _Lhs.x * _Rhs.y - _Lhs.y * _Rhs.x; }
+
+    static bool IsOriginInsideTriangle(glm::vec2 _P0, glm::vec2 _P1, glm::vec2 _P2)
+    {
+        float d0 = Cross(_P1 - _P0, -_P0);
+        float d1 = Cross(_P2 - _P1, -_P1);
+        float d2 = Cross(_P0 - _P2, -_P2);
+        return (d0 >= 0.0f && d1 >= 0.0f && d2 >= 0.0f) || (d0 <= 0.0f && d1 <= 0.0f && d2 <= 0.0f);
+    }
+
+    // Part of the segment inside the circle, returns false if there is none
+    static bool ClipSegmentByCircle(float _Radius, glm::vec2& _P0, glm::vec2& _P1)
+    {
+        glm::vec2 edge = _P1 - _P0;
+        float a = glm::dot(edge, edge);
+        float b = glm::dot(_P0, edge);
+        float c = glm::dot(_P0, _P0) - _Radius * _Radius;
+        float discriminant = b * b - a * c;
+        if (a == 0.0f || discriminant <= 0.0f)
+        {
+            return false;
+        }
+
+        float sqrtDiscriminant = glm::sqrt(discriminant);
+        float tBegin = glm::max((-b - sqrtDiscriminant) / a, 0.0f);
+        float tEnd = glm::min((-b + sqrtDiscriminant) / a, 1.0f);
+        if (tBegin >= tEnd)
+        {
+            return false;
+        }
+
+        glm::vec2 p0 = _P0;
+        _P0 = p0 + edge * tBegin;
+        _P1 = p0 + edge * tEnd;
+        return true;
+    }
+
+    static float WrapAngle(float _Angle)
+    {
+        if (_Angle > glm::pi<float>())
+        {
+            return _Angle - glm::two_pi<float>();
+        }
+        if (_Angle < -glm::pi<float>())
+        {
+            return _Angle + glm::two_pi<float>();
+        }
+        return _Angle;
+    }
+
+    static void AddInterval(glm::vec2 _Interval, float _Epsilon, EnvelopeIntervals& _Intervals)
+    {
+        auto begin = std::lower_bound(_Intervals.begin(), _Intervals.end(), _Interval.x - _Epsilon,
+                                      [](glm::vec2 _Lhs, float _Value) { return _Lhs.y < _Value; });
+        auto end = begin;
+        for (; end != _Intervals.end() && end->x <= _Interval.y + _Epsilon; end++)
+        {
+            _Interval = { glm::min(_Interval.x, end->x), glm::max(_Interval.y, end->y) };
+        }
+        _Intervals.insert(_Intervals.erase(begin, end), _Interval);
+    }
+
+    // Adds the part of the triangle inside the tool to the intervals of the rays crossing it. The triangle is convex,
+    // so it covers a single interval of every ray, and only rays over the angular span of its clipped part are tested
+    static void AddTriangle(const glm::vec2 (&_Points)[3], float _ToolRadius, float _Epsilon,
+                            const std::vector<glm::vec2>& _Directions, std::vector<EnvelopeIntervals>& _Intervals)
+    {
+        glm::vec2 clippedArr[6];
+        uint32_t clippedCount = 0;
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            glm::vec2 p0 = _Points[i];
+            glm::vec2 p1 = _Points[(i + 1) % 3];
+            if (ClipSegmentByCircle(_ToolRadius, p0, p1))
+            {
+                clippedArr[clippedCount++] = p0;
+                clippedArr[clippedCount++] = p1;
+            }
+        }
+        if (clippedCount == 0)
+        {
+            return;
+        }
+
+        const int raysCount = int(_Intervals.size());
+        const float rayStep = glm::two_pi<float>() / raysCount;
+
+        // The triangle doesn't contain the tool center, so its span is less than pi around any of its points
+        float angle0 = glm::atan(clippedArr[0].y, clippedArr[0].x);
+        float deltaMin = 0.0f;
+        float deltaMax = 0.0f;
+        for (uint32_t i = 1; i < clippedCount; i++)
+        {
+            float delta = WrapAngle(glm::atan(clippedArr[i].y, clippedArr[i].x) - angle0);
+            deltaMin = glm::min(deltaMin, delta);
+            deltaMax = glm::max(deltaMax, delta);
+        }
+
+        for (int ray = int(glm::ceil((angle0 + deltaMin) / rayStep));
+             ray <= int(glm::floor((angle0 + deltaMax) / rayStep)); ray++)
+        {
+            int rayId = ((ray % raysCount) + raysCount) % raysCount;
+            glm::vec2 direction = _Directions[rayId];
+
+            float radiusBegin = std::numeric_limits<float>::max();
+            float radiusEnd = -1.0f;
+            for (uint32_t i = 0; i < 3; i++)
+            {
+                glm::vec2 p0 = _Points[i];
+                glm::vec2 edge = _Points[(i + 1) % 3] - p0;
+                float denominator = Cross(direction, edge);
+                if (denominator == 0.0f)
+                {
+                    continue;
+                }
+
+                float edgeT = Cross(p0, direction) / denominator;
+                float radius = Cross(p0, edge) / denominator;
+                if (edgeT >= 0.0f && edgeT <= 1.0f && radius >= 0.0f)
+                {
+                    radiusBegin = glm::min(radiusBegin, radius);
+                    radiusEnd = glm::max(radiusEnd, radius);
+                }
+            }
+
+            radiusEnd = glm::min(radiusEnd, _ToolRadius);
+            if (radiusBegin < radiusEnd)
+            {
+                AddInterval({ radiusBegin, radiusEnd }, _Epsilon, _Intervals[rayId]);
+            }
+        }
+    }
+
+    WheelEnvelopeMesh CalculateWheelEnvelope(const WheelEnvelopeParams& _Params)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+
+        WheelEnvelopeMesh result;
+
+        const uint32_t raysCount = glm::max(_Params.RaysCount, 3u);
+        const uint32_t samplesCount = glm::max(_Params.SamplesCount, 1u);
+        const float toolRadius = _Params.Tool.Diametr / 2.0f;
+        const float rayStep = glm::two_pi<float>() / raysCount;
+        const float epsilon = kEnvelopeIntervalEpsilon * toolRadius;
+
+        std::vector<glm::vec2> directions(raysCount);
+        for (uint32_t ray = 0; ray < raysCount; ray++)
+        {
+            directions[ray] = { glm::cos(ray * rayStep), glm::sin(ray * rayStep) };
+        }
+
+        std::vector<glm::vec4> wheelVertices;
+        std::vector<uint32_t> wheelIndices;
+        CreateGrindingWheelMesh(_Params.Wheel, kEnvelopeTolerance, wheelVertices, wheelIndices);
+
+        MoveOverToolAxis moveOverToolAxis = CalcMoveOverToolAxis(CalculateGrindingWheelSizes(_Params.Wheel),
+                                                                 _Params.Wheel, _Params.Profile, _Params.Tool);
+
+        // Every chunk of poses has its own intervals, they are merged at the end. A pose over the tool center cuts
+        // the whole cross section
+        const uint32_t chunksCount = glm::min(samplesCount, glm::max(std::thread::hardware_concurrency(), 1u));
+        std::vector<std::vector<EnvelopeIntervals>> chunkIntervals(chunksCount,
+                                                                   std::vector<EnvelopeIntervals>(raysCount));
+        std::vector<uint8_t> chunkFilled(chunksCount, 0);
+        std::vector<uint32_t> chunkArr(chunksCount);
+        std::iota(chunkArr.begin(), chunkArr.end(), 0);
+
+        auto runChunk = [&](uint32_t _Chunk) {
+            std::vector<EnvelopeIntervals>& intervals = chunkIntervals[_Chunk];
+            std::vector<glm::vec2> points(wheelVertices.size());
+
+            for (uint32_t sample = _Chunk; sample < samplesCount; sample += chunksCount)
+            {
+                float t = samplesCount > 1 ? float(sample) / float(samplesCount - 1) : 0.0f;
+                float rotationRad =
+                    glm::mix(moveOverToolAxis.Min.RotationRad, moveOverToolAxis.Max.RotationRad, t);
+                float rotationOffset =
+                    MoveOverToolAxisRotationRadToOffset(rotationRad, _Params.Tool.Diametr, _Params.Tool.Angle);
+
+                glm::mat4 matrix = glm::rotate(glm::mat4(1.0f), rotationRad, glm::vec3(0.0f, 0.0f, 1.0f)) *
+                                   GetGrindingWheelMatrix(_Params.Profile.OffsetToolCenter,
+                                                          _Params.Profile.OffsetToolAxis,
+                                                          _Params.Profile.RotationAngle, rotationOffset);
+
+                for (size_t i = 0; i < wheelVertices.size(); i++)
+                {
+                    points[i] = glm::vec2(matrix * wheelVertices[i]);
+                }
+
+                for (size_t i = 0; i < wheelIndices.size(); i += 3)
+                {
+                    glm::vec2 triangle[3] = { points[wheelIndices[i]], points[wheelIndices[i + 1]],
+                                              points[wheelIndices[i + 2]] };
+                    if (IsOriginInsideTriangle(triangle[0], triangle[1], triangle[2]))
+                    {
+                        chunkFilled[_Chunk] = 1;
+                        return;
+                    }
+
+                    AddTriangle(triangle, toolRadius, epsilon, directions, intervals);
+                }
+            }
+        };
+
+        std::for_each(std::execution::par, chunkArr.begin(), chunkArr.end(), runChunk);
+
+        std::vector<EnvelopeIntervals>& intervals = chunkIntervals[0];
+        if (std::find(chunkFilled.begin(), chunkFilled.end(), 1) != chunkFilled.end())
+        {
+            std::fill(intervals.begin(), intervals.end(), EnvelopeIntervals { { 0.0f, toolRadius } });
+        }
+        else
+        {
+            for (uint32_t chunk = 1; chunk < chunksCount; chunk++)
+            {
+                for (uint32_t ray = 0; ray < raysCount; ray++)
+                {
+                    for (glm::vec2 interval : chunkIntervals[chunk][ray])
+                    {
+                        AddInterval(interval, epsilon, intervals[ray]);
+                    }
+                }
+            }
+        }
+
+        auto addQuad = [&result](glm::vec2 _Begin0, glm::vec2 _End0, glm::vec2 _End1, glm::vec2 _Begin1) {
+            uint32_t begin0 = uint32_t(result.Vertices.size());
+            for (glm::vec2 point : { _Begin0, _End0, _End1, _Begin1 })
+            {
+                result.Vertices.emplace_back(point, 0.0f, 1.0f);
+            }
+            result.Indices.insert(result.Indices.end(),
+                                  { begin0, begin0 + 1, begin0 + 2, begin0, begin0 + 2, begin0 + 3 });
+        };
+
+        // Intervals of neighbouring rays are joined in order when both rays have the same count of them. A ray
+        // without intervals is the side of the groove: it is closed at the tool circle or at the interval middle.
+        // Where the count changes otherwise (an undercut or an overhang starts) every interval is drawn as a sector
+        // up to the half way to the other ray
+        for (uint32_t ray = 0; ray < raysCount; ray++)
+        {
+            uint32_t nextRay = (ray + 1) % raysCount;
+            const EnvelopeIntervals& lhs = intervals[ray];
+            const EnvelopeIntervals& rhs = intervals[nextRay];
+            glm::vec2 lhsDirection = directions[ray];
+            glm::vec2 rhsDirection = directions[nextRay];
+
+            if (lhs.size() == rhs.size())
+            {
+                for (size_t i = 0; i < lhs.size(); i++)
+                {
+                    addQuad(lhsDirection * lhs[i].x, lhsDirection * lhs[i].y, rhsDirection * rhs[i].y,
+                            rhsDirection * rhs[i].x);
+                }
+            }
+            else if (lhs.empty() || rhs.empty())
+            {
+                bool isLhs = !lhs.empty();
+                glm::vec2 direction = isLhs ? lhsDirection : rhsDirection;
+                glm::vec2 emptyDirection = isLhs ? rhsDirection : lhsDirection;
+                for (glm::vec2 interval : isLhs ? lhs : rhs)
+                {
+                    float radius = interval.y >= toolRadius ? toolRadius : (interval.x + interval.y) / 2.0f;
+                    addQuad(direction * interval.x, direction * interval.y, emptyDirection * radius,
+                            emptyDirection * radius);
+                }
+            }
+            else
+            {
+                glm::vec2 middleDirection = glm::normalize(lhsDirection + rhsDirection);
+                for (glm::vec2 interval : lhs)
+                {
+                    addQuad(lhsDirection * interval.x, lhsDirection * interval.y, middleDirection * interval.y,
+                            middleDirection * interval.x);
+                }
+                for (glm::vec2 interval : rhs)
+                {
+                    addQuad(middleDirection * interval.x, middleDirection * interval.y, rhsDirection * interval.y,
+                            rhsDirection * interval.x);
+                }
+            }
+        }
+
+        auto endTime = std::chrono::steady_clock::now();
+        result.CalculationMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        return result;
+    }
+
+    bool WheelEnvelope::Update(const WheelEnvelopeParams& _Params)
+    {
+        bool updated = false;
+        if (m_Future.valid() && m_Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            WheelEnvelopeMesh mesh = m_Future.get();
+            m_Shape.SetData(mesh.Vertices, mesh.Indices);
+            m_CalculationMs = mesh.CalculationMs;
+            updated = true;
+        }
+
+        // Params changed during the calculation are picked up when it is done
+        if (!m_Future.valid() && (!m_HasParams || !(_Params == m_Params)))
+        {
+            Start(_Params);
+        }
+
+        return updated;
+    }
+
+    void WheelEnvelope::Start(const WheelEnvelopeParams& _Params)
+    {
+        m_HasParams = true;
+        m_Params = _Params;
+        m_Future = std::async(std::launch::async, [_Params, onReady = m_OnReady]() {
+            WheelEnvelopeMesh mesh = CalculateWheelEnvelope(_Params);
+            if (onReady)
+            {
+                onReady();
+            }
+            return mesh;
+        });
+    }
+
+    void WheelEnvelope::Draw() const { m_Shape.Draw(); }
+
+}    // namespace LM
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "Calculations/Calculations.h"
+#include "SimpleRenderable2D.h"
+
+#include "glm/glm.hpp"
+
+namespace LM
+{
+
+    struct WheelEnvelopeParams
+    {
+        GrindingWheelParams Wheel = {};
+        GrindingWheelProfileParams Profile = {};
+        ToolParams Tool = {};
+
+        // Wheel poses over the rotation range from CalcMoveOverToolAxis
+        uint32_t SamplesCount = 256;
+        // Rays from the tool center, the envelope is stored as the intervals along every ray inside any pose
+        uint32_t RaysCount = 2048;
+
+        bool operator==(const WheelEnvelopeParams&) const = default;
+    };
+
+    struct WheelEnvelopeMesh
+    {
+        std::vector<glm::vec4> Vertices;
+        std::vector<uint32_t> Indices;
+
+        double CalculationMs = 0.0;
+    };
+
+    // Groove which the wheel cuts into the tool cross section while it moves over the whole rotation range: the union
+    // of all wheel poses inside the tool circle. The union is sampled along rays from the tool center. Every ray
+    // keeps all its intervals inside any pose, so an undercut front face or an overhanging tooth tip leaves the tool
+    // material under it. Rays are joined into quads between neighbouring intervals, the boundary is exact on the rays
+    // and linear between them. Poses are split into chunks in parallel and chunk intervals are merged at the end
+    WheelEnvelopeMesh CalculateWheelEnvelope(const WheelEnvelopeParams& _Params);
+
+    // Keeps the envelope up to date without blocking the frame: changed params start a background calculation, params
+    // changed while it runs are calculated next (only the latest ones) and the result is written into the same mesh.
+    // Every change is a full recalculation: each of the wheel, profile and tool params moves every pose, so there is
+    // no part of the previous envelope which stays valid
+    class WheelEnvelope
+    {
+    public:
+        // Returns true when a new envelope was written into the mesh
+        bool Update(const WheelEnvelopeParams& _Params);
+        void Draw() const;
+
+        // Called on the worker thread when a calculation is done
+        void SetOnReady(const std::function<void()>& _OnReady) { m_OnReady = _OnReady; }
+
+        bool IsCalculating() const { return m_Future.valid(); }
+        double GetCalculationMs() const { return m_CalculationMs; }
+
+    protected:
+        void Start(const WheelEnvelopeParams& _Params);
+
+    protected:
+        SimpleRenderable2D m_Shape;
+
+        bool m_HasParams = false;
+        WheelEnvelopeParams m_Params;
+        std::future<WheelEnvelopeMesh> m_Future;
+        std::function<void()> m_OnReady;
+
+        double m_CalculationMs = 0.0;
+    };
+
+}    // namespace LM
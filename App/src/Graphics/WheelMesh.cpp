@@ -0,0 +1,65 @@
+#include "WheelMesh.h"
+
+#include "GraphicsUtils.h"
+
+namespace LM
+{
+
+    void CreateGrindingWheelMesh(const GrindingWheelParams& _Params, float _Tolerance,
+                                 std::vector<glm::vec4>& _Vertices, std::vector<uint32_t>& _Indices)
+    {
+        _Vertices = {
+            {0.0f, 0.0f, 0.0f, 1.0f}
+        };
+        _Indices.clear();
+
+        auto wheelParams = CalculateGrindingWheelSizes(_Params);
+
+        uint32_t leftCenterVertId = _Vertices.size();
+        _Vertices.emplace_back(wheelParams.LeftCenterPoint);
+
+        uint32_t r1StartVertId = _Vertices.size();
+        CurcleCurveProps r1Props = { 180.0f, 270.0f + _Params.Angle, _Params.R1, wheelParams.R1Center.x,
+                                     wheelParams.R1Center.y };
+        AddCircleCurve(r1Props, GetCircleCurveSections(r1Props, _Tolerance), _Vertices);
+        uint32_t r1EndVertId = _Vertices.size() - 1;
+
+        for (uint32_t i = r1StartVertId + 1; i < _Vertices.size(); i++)
+        {
+            IndicesAddTriangle(_Indices, leftCenterVertId, i - 1, i);
+        }
+
+        uint32_t rightCenterVertId = _Vertices.size();
+        _Vertices.emplace_back(wheelParams.RightCenterPoint);
+
+        uint32_t r2StartVertId = _Vertices.size();
+        CurcleCurveProps r2Props = { 270.0f + _Params.Angle, 360.0f, _Params.R2, wheelParams.R2Center.x,
+                                     wheelParams.R2Center.y };
+        AddCircleCurve(r2Props, GetCircleCurveSections(r2Props, _Tolerance), _Vertices);
+
+        for (uint32_t i = r2StartVertId + 1; i < _Vertices.size(); i++)
+        {
+            IndicesAddTriangle(_Indices, rightCenterVertId, i - 1, i);
+        }
+
+        IndicesAddTriangle(_Indices, leftCenterVertId, r1EndVertId, r2StartVertId);
+        IndicesAddTriangle(_Indices, leftCenterVertId, r2StartVertId, rightCenterVertId);
+    }
+
+    void CreateToolMesh(const ToolParams& _Params, float _Tolerance, std::vector<glm::vec4>& _Vertices,
+                        std::vector<uint32_t>& _Indices)
+    {
+        _Vertices = {
+            {0.0f, 0.0f, 0.0f, 1.0f}
+        };
+        _Indices.clear();
+
+        CurcleCurveProps props = { 0.0f, 360.0f, _Params.Diametr / 2.0f, 0.0f, 0.0f };
+        AddCircleCurve(props, GetCircleCurveSections(props, _Tolerance), _Vertices);
+        for (size_t i = 2; i < _Vertices.size(); i++)
+        {
+            IndicesAddTriangle(_Indices, 0, i - 1, i);
+        }
+    }
+
+}    // namespace LM
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Calculations/Calculations.h"
+
+namespace LM
+{
+
+    // Triangles of the grinding wheel profile in the wheel space, arcs are split so that chords are at most _Tolerance
+    // away from them. _Vertices and _Indices are overwritten, indices start from 0, so meshes can be packed into one
+    // buffer with a base vertex
+    void CreateGrindingWheelMesh(const GrindingWheelParams& _Params, float _Tolerance,
+                                 std::vector<glm::vec4>& _Vertices, std::vector<uint32_t>& _Indices);
+
+    // Filled circle of the tool cross section around the origin with the same chord tolerance, _Vertices and _Indices
+    // are overwritten
+    void CreateToolMesh(const ToolParams& _Params, float _Tolerance, std::vector<glm::vec4>& _Vertices,
+                        std::vector<uint32_t>& _Indices);
+
+}    // namespace LM
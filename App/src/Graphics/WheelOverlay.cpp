@@ -0,0 +1,158 @@
+#include "WheelOverlay.h"
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+#include "WheelMesh.h"
+
+#include "GL/glew.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace LM
+{
+
+    // Overlay wheels are translucent and many, their arcs are coarser than the ones of the main wheel
+    constexpr float kOverlayTolerance = 0.05f;
+    const glm::vec4 kBestColor = { 0.0f, 1.0f, 0.0f, 0.8f };
+    const glm::vec4 kWorstColor = { 1.0f, 1.0f, 0.0f, 0.1f };
+
+    static GrindingWheelParams GetWheelParams(const BestResult& _Result)
+    {
+        return { _Result.Diametr, _Result.Width, _Result.R1, _Result.R2, _Result.Angle };
+    }
+
+    static bool WheelParamsLess(const GrindingWheelParams& _Lhs, const GrindingWheelParams& _Rhs)
+    {
+        return std::tie(_Lhs.Diametr, _Lhs.Width, _Lhs.R1, _Lhs.R2, _Lhs.Angle) <
+               std::tie(_Rhs.Diametr, _Rhs.Width, _Rhs.R1, _Rhs.R2, _Rhs.Angle);
+    }
+
+    void WheelOverlay::SetWheels(const std::vector<SweepCandidate>& _Candidates, size_t _Count)
+    {
+        _Count = std::min(_Count, _Candidates.size());
+
+        // Instances of one mesh must be consecutive for the BaseInstance of its command
+        std::vector<uint32_t> order(_Count);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&_Candidates](uint32_t _Lhs, uint32_t _Rhs) {
+            return WheelParamsLess(GetWheelParams(_Candidates[_Lhs].Result), GetWheelParams(_Candidates[_Rhs].Result));
+        });
+
+        m_Wheels.clear();
+        m_Colors.clear();
+
+        std::vector<glm::vec4> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<DrawElementsIndirectCommand> commands;
+        std::vector<glm::vec4> meshVertices;
+        std::vector<uint32_t> meshIndices;
+
+        for (uint32_t i = 0; i < order.size(); i++)
+        {
+            const BestResult& result = _Candidates[order[i]].Result;
+            GrindingWheelParams params = GetWheelParams(result);
+
+            if (i == 0 || !(params == GetWheelParams(m_Wheels.back())))
+            {
+                CreateGrindingWheelMesh(params, kOverlayTolerance, meshVertices, meshIndices);
+                commands.push_back({ uint32_t(meshIndices.size()), 0, uint32_t(indices.size()),
+                                     int32_t(vertices.size()), i });
+                vertices.insert(vertices.end(), meshVertices.begin(), meshVertices.end());
+                indices.insert(indices.end(), meshIndices.begin(), meshIndices.end());
+            }
+            commands.back().InstanceCount++;
+
+            float rank = _Count > 1 ? float(order[i]) / float(_Count - 1) : 0.0f;
+            m_Wheels.push_back(result);
+            m_Colors.push_back(kBestColor + (kWorstColor - kBestColor) * rank);
+        }
+
+        if (m_Wheels.empty())
+        {
+            m_VertexArray = nullptr;
+            m_InstancesBuffer = nullptr;
+            m_Commands = nullptr;
+            return;
+        }
+
+        // a_InstanceId is an instanced attribute, so it is BaseInstance + gl_InstanceID of the command
+        std::vector<int32_t> instanceIds(m_Wheels.size());
+        std::iota(instanceIds.begin(), instanceIds.end(), 0);
+
+        Ref<VertexBuffer> verticesBuffer = VertexBuffer::Create(vertices.data(), vertices.size() * sizeof(glm::vec4));
+        verticesBuffer->SetLayout({
+            {ShaderDataType::Float4, "a_Position"},
+        });
+        Ref<VertexBuffer> instanceIdsBuffer =
+            VertexBuffer::Create(instanceIds.data(), instanceIds.size() * sizeof(int32_t));
+        instanceIdsBuffer->SetLayout(BufferLayout(
+            {
+                {ShaderDataType::Int, "a_InstanceId"},
+        },
+            1));
+
+        m_VertexArray = VertexArray::Create();
+        m_VertexArray->AddVertexBuffer(verticesBuffer);
+        m_VertexArray->AddVertexBuffer(instanceIdsBuffer);
+        m_VertexArray->SetIndexBuffer(IndexBuffer::Create(indices.data(), indices.size()));
+
+        m_Instances.resize(m_Wheels.size());
+        m_InstancesBuffer = ShaderStorageBuffer::Create(m_Instances.size() * sizeof(WheelInstance));
+        m_Commands = DrawIndirectBuffer::Create(commands.data(), commands.size());
+
+        UpdateInstances();
+    }
+
+    void WheelOverlay::SetRotation(const ToolParams& _Tool, float _RotationDeg)
+    {
+        if (_Tool.Diametr == m_Tool.Diametr && _Tool.Angle == m_Tool.Angle && _RotationDeg == m_RotationDeg)
+        {
+            return;
+        }
+
+        m_Tool = _Tool;
+        m_RotationDeg = _RotationDeg;
+        UpdateInstances();
+    }
+
+    void WheelOverlay::UpdateInstances()
+    {
+        if (!m_InstancesBuffer)
+        {
+            return;
+        }
+
+        float rotationOffset =
+            MoveOverToolAxisRotationRadToOffset(glm::radians(m_RotationDeg), m_Tool.Diametr, m_Tool.Angle);
+        glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), glm::radians(m_RotationDeg), glm::vec3(0.0f, 0.0f, 1.0f));
+
+        for (size_t i = 0; i < m_Wheels.size(); i++)
+        {
+            const BestResult& wheel = m_Wheels[i];
+            m_Instances[i].ModelMatrix = rotation * GetGrindingWheelMatrix(wheel.OffsetToolCenter, wheel.OffsetToolAxis,
+                                                                           wheel.RotationAngle, rotationOffset);
+            m_Instances[i].Color = m_Colors[i];
+        }
+
+        m_InstancesBuffer->SetData(m_Instances.data(), m_Instances.size() * sizeof(WheelInstance));
+    }
+
+    void WheelOverlay::Draw() const
+    {
+        if (!m_Commands)
+        {
+            return;
+        }
+
+        m_VertexArray->Bind();
+        m_InstancesBuffer->Bind(kInstancesSlot);
+        m_Commands->Bind();
+
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, m_Commands->GetCount(), 0);
+
+        m_Commands->Unbind();
+        m_VertexArray->Unbind();
+    }
+
+}    // namespace LM
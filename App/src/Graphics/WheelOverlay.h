@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+
+#include "Engine/Buffers/DrawIndirectBuffer.h"
+#include "Engine/Buffers/ShaderStorageBuffer.h"
+#include "Engine/Buffers/VertexArray.h"
+
+#include "Calculations/SweepRunner.h"
+
+#include "glm/glm.hpp"
+
+namespace LM
+{
+
+    // Instance data of assets/shaders/wheel_overlay.vert (std430 layout)
+    struct WheelInstance
+    {
+        glm::mat4 ModelMatrix;
+        glm::vec4 Color;
+    };
+
+    // Draws many grinding wheels in one glMultiDrawElementsIndirect call. Wheels of equal sizes share one mesh and
+    // one draw command, meshes of all sizes are packed into one vertex and index buffer. Transforms and colors are
+    // per instance data in a shader storage buffer
+    class WheelOverlay
+    {
+    public:
+        static constexpr uint32_t kInstancesSlot = 0;
+
+        // Candidates are sorted from the best one, the color fades from the best to the worst
+        void SetWheels(const std::vector<SweepCandidate>& _Candidates, size_t _Count);
+
+        // All wheels are moved over the tool axis by the same rotation, instances are updated only on change
+        void SetRotation(const ToolParams& _Tool, float _RotationDeg);
+
+        void Draw() const;
+
+        uint32_t GetWheelsCount() const { return m_Wheels.size(); }
+        uint32_t GetMeshesCount() const { return m_Commands ? m_Commands->GetCount() : 0; }
+
+    protected:
+        void UpdateInstances();
+
+    protected:
+        // In instance order: grouped by mesh
+        std::vector<BestResult> m_Wheels;
+        std::vector<glm::vec4> m_Colors;
+        std::vector<WheelInstance> m_Instances;
+
+        ToolParams m_Tool = {};
+        float m_RotationDeg = 0.0f;
+
+        Ref<VertexArray> m_VertexArray;
+        Ref<ShaderStorageBuffer> m_InstancesBuffer;
+        Ref<DrawIndirectBuffer> m_Commands;
+    };
+
+}    // namespace LM
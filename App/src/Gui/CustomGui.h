@@ -8,7 +8,7 @@ namespace LM
     class Gui
     {
     protected:
-        static inline constexpr int kMinStep = 1;
+        static inline constexpr int kMinStep = 0;    // 0 steps keeps the value constant (equal to Min)
         static inline constexpr int kMaxStep = 1000;
         static inline constexpr float kStepSpeed = 0.1f;
 
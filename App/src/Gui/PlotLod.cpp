@@ -0,0 +1,451 @@
+#include "PlotLod.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Engine/ImGui/Plots/implot.h"
+
+namespace LM
+{
+
+    // Min/max levels are used when there are at least this many buckets per pixel column, otherwise raw points
+    constexpr uint64_t kLineBucketsPerColumn = 4;
+    // The coarsest LTTB level has at least this many points
+    constexpr size_t kLttbMinPoints = 1024;
+
+    constexpr uint32_t kScatterDensityResolution = 1024;
+    constexpr uint32_t kScatterDensityCellPixels = 4;
+    // Views with fewer points show the points themselves
+    constexpr uint64_t kScatterMaxPoints = 50000;
+
+    PlotLodView GetPlotLodView()
+    {
+        ImPlotRect limits = ImPlot::GetPlotLimits();
+        ImVec2 size = ImPlot::GetPlotSize();
+
+        PlotLodView view;
+        view.MinX = limits.X.Min;
+        view.MaxX = limits.X.Max;
+        view.MinY = limits.Y.Min;
+        view.MaxY = limits.Y.Max;
+        view.Width = uint32_t(glm::max(size.x, 1.0f));
+        view.Height = uint32_t(glm::max(size.y, 1.0f));
+        return view;
+    }
+
+    static void FillPoints(const float* _Xs, const float* _Ys, size_t _Count, std::vector<glm::vec2>& _Points,
+                           glm::vec2* _Min, glm::vec2* _Max)
+    {
+        _Points.resize(_Count);
+        for (size_t i = 0; i < _Count; i++)
+        {
+            _Points[i] = { _Xs[i], _Ys[i] };
+        }
+        std::sort(_Points.begin(), _Points.end(),
+                  [](const glm::vec2& _Lhs, const glm::vec2& _Rhs) { return _Lhs.x < _Rhs.x; });
+
+        *_Min = _Points.empty() ? glm::vec2(0.0f) : _Points.front();
+        *_Max = *_Min;
+        for (const glm::vec2& point : _Points)
+        {
+            *_Min = glm::min(*_Min, point);
+            *_Max = glm::max(*_Max, point);
+        }
+    }
+
+    // Range of sorted _Points with x in [_MinX, _MaxX] and one more point on both sides, so lines go out of the view
+    static void FindVisibleRange(const std::vector<glm::vec2>& _Points, double _MinX, double _MaxX, size_t* _Begin,
+                                 size_t* _End)
+    {
+        auto begin = std::lower_bound(_Points.begin(), _Points.end(), _MinX,
+                                      [](const glm::vec2& _Point, double _X) { return _Point.x < _X; });
+        auto end = std::upper_bound(begin, _Points.end(), _MaxX,
+                                    [](double _X, const glm::vec2& _Point) { return _X < _Point.x; });
+
+        *_Begin = size_t(begin - _Points.begin());
+        *_End = size_t(end - _Points.begin());
+        *_Begin -= *_Begin > 0 ? 1 : 0;
+        *_End += *_End < _Points.size() ? 1 : 0;
+    }
+
+    static void Lttb(const glm::vec2* _Points, size_t _Count, size_t _Threshold, std::vector<glm::vec2>& _Result)
+    {
+        if (_Threshold >= _Count || _Threshold < 3)
+        {
+            _Result.insert(_Result.end(), _Points, _Points + _Count);
+            return;
+        }
+
+        // First and last points are kept, others are split in _Threshold - 2 buckets
+        const double bucketSize = double(_Count - 2) / double(_Threshold - 2);
+
+        size_t selected = 0;
+        _Result.push_back(_Points[0]);
+        for (size_t bucket = 0; bucket < _Threshold - 2; bucket++)
+        {
+            size_t nextBegin = size_t(double(bucket + 1) * bucketSize) + 1;
+            size_t nextEnd = glm::min(size_t(double(bucket + 2) * bucketSize) + 1, _Count);
+            glm::dvec2 average(0.0);
+            for (size_t i = nextBegin; i < nextEnd; i++)
+            {
+                average += glm::dvec2(_Points[i]);
+            }
+            average /= double(glm::max<size_t>(nextEnd - nextBegin, 1));
+
+            size_t begin = size_t(double(bucket) * bucketSize) + 1;
+            size_t end = size_t(double(bucket + 1) * bucketSize) + 1;
+            glm::dvec2 a = glm::dvec2(_Points[selected]);
+            double maxArea = -1.0;
+            size_t maxAreaPoint = begin;
+            for (size_t i = begin; i < end; i++)
+            {
+                glm::dvec2 b = glm::dvec2(_Points[i]);
+                double area = glm::abs((a.x - average.x) * (b.y - a.y) - (a.x - b.x) * (average.y - a.y));
+                if (area > maxArea)
+                {
+                    maxArea = area;
+                    maxAreaPoint = i;
+                }
+            }
+
+            _Result.push_back(_Points[maxAreaPoint]);
+            selected = maxAreaPoint;
+        }
+        _Result.push_back(_Points[_Count - 1]);
+    }
+
+    void LinePlotLod::Build(const float* _Xs, const float* _Ys, size_t _Count)
+    {
+        FillPoints(_Xs, _Ys, _Count, m_Points, &m_Min, &m_Max);
+
+        m_MinMaxLevels.clear();
+        std::vector<Bucket> level((m_Points.size() + 1) / 2);
+        for (size_t i = 0; i < level.size(); i++)
+        {
+            const glm::vec2& first = m_Points[i * 2];
+            const glm::vec2& second = m_Points[glm::min(i * 2 + 1, m_Points.size() - 1)];
+            level[i] = { glm::min(first.y, second.y), glm::max(first.y, second.y) };
+        }
+        while (level.size() > 1)
+        {
+            std::vector<Bucket> nextLevel((level.size() + 1) / 2);
+            for (size_t i = 0; i < nextLevel.size(); i++)
+            {
+                const Bucket& first = level[i * 2];
+                const Bucket& second = level[glm::min(i * 2 + 1, level.size() - 1)];
+                nextLevel[i] = { glm::min(first.MinY, second.MinY), glm::max(first.MaxY, second.MaxY) };
+            }
+            m_MinMaxLevels.push_back(std::move(level));
+            level = std::move(nextLevel);
+        }
+        m_MinMaxLevels.push_back(std::move(level));
+
+        m_LttbLevels.clear();
+        const std::vector<glm::vec2>* previous = &m_Points;
+        while (previous->size() / 2 >= kLttbMinPoints)
+        {
+            std::vector<glm::vec2> lttbLevel;
+            lttbLevel.reserve(previous->size() / 2);
+            Lttb(previous->data(), previous->size(), previous->size() / 2, lttbLevel);
+            m_LttbLevels.push_back(std::move(lttbLevel));
+            previous = &m_LttbLevels.back();
+        }
+
+        m_HasView = false;
+    }
+
+    bool LinePlotLod::Update(const PlotLodView& _View, LineLodMode _Mode)
+    {
+        if (m_HasView && _View == m_View && _Mode == m_Mode)
+        {
+            return false;
+        }
+
+        m_HasView = true;
+        m_View = _View;
+        m_Mode = _Mode;
+        m_Xs.clear();
+        m_Ys.clear();
+
+        if (_Mode == LineLodMode::MinMax)
+        {
+            UpdateMinMax(_View);
+        }
+        else
+        {
+            UpdateLttb(_View);
+        }
+
+        return true;
+    }
+
+    void LinePlotLod::UpdateMinMax(const PlotLodView& _View)
+    {
+        size_t begin = 0;
+        size_t end = 0;
+        FindVisibleRange(m_Points, _View.MinX, _View.MaxX, &begin, &end);
+
+        const uint64_t width = glm::max(_View.Width, 1u);
+        if (end - begin <= width * kLineBucketsPerColumn)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                m_Xs.push_back(m_Points[i].x);
+                m_Ys.push_back(m_Points[i].y);
+            }
+            return;
+        }
+
+        uint32_t level = 0;
+        while (level + 1 < m_MinMaxLevels.size() && ((end - begin) >> (level + 2)) >= width * kLineBucketsPerColumn)
+        {
+            level++;
+        }
+        const uint32_t shift = level + 1;
+        const std::vector<Bucket>& buckets = m_MinMaxLevels[level];
+
+        std::vector<Bucket> columns(width, { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() });
+        const double columnWidth = (_View.MaxX - _View.MinX) / double(width);
+        for (size_t bucket = begin >> shift; bucket <= (end - 1) >> shift; bucket++)
+        {
+            // Bucket goes to the column of its middle point
+            double x = m_Points[glm::min((bucket << shift) + (size_t(1) << (shift - 1)), m_Points.size() - 1)].x;
+            size_t column = size_t(glm::clamp((x - _View.MinX) / columnWidth, 0.0, double(width - 1)));
+            columns[column].MinY = glm::min(columns[column].MinY, buckets[bucket].MinY);
+            columns[column].MaxY = glm::max(columns[column].MaxY, buckets[bucket].MaxY);
+        }
+
+        for (size_t column = 0; column < columns.size(); column++)
+        {
+            if (columns[column].MinY > columns[column].MaxY)
+            {
+                continue;
+            }
+
+            double x = _View.MinX + (double(column) + 0.5) * columnWidth;
+            m_Xs.insert(m_Xs.end(), { x, x });
+            m_Ys.insert(m_Ys.end(), { columns[column].MinY, columns[column].MaxY });
+        }
+    }
+
+    void LinePlotLod::UpdateLttb(const PlotLodView& _View)
+    {
+        const size_t threshold = glm::max<size_t>(_View.Width, 3);
+
+        // The coarsest level with at least two points per output point
+        const std::vector<glm::vec2>* points = &m_Points;
+        size_t begin = 0;
+        size_t end = 0;
+        FindVisibleRange(m_Points, _View.MinX, _View.MaxX, &begin, &end);
+        for (const std::vector<glm::vec2>& level : m_LttbLevels)
+        {
+            size_t levelBegin = 0;
+            size_t levelEnd = 0;
+            FindVisibleRange(level, _View.MinX, _View.MaxX, &levelBegin, &levelEnd);
+            if (levelEnd - levelBegin < threshold * 2)
+            {
+                break;
+            }
+            points = &level;
+            begin = levelBegin;
+            end = levelEnd;
+        }
+
+        std::vector<glm::vec2> result;
+        result.reserve(glm::min(threshold, end - begin));
+        Lttb(points->data() + begin, end - begin, threshold, result);
+
+        m_Xs.reserve(result.size());
+        m_Ys.reserve(result.size());
+        for (const glm::vec2& point : result)
+        {
+            m_Xs.push_back(point.x);
+            m_Ys.push_back(point.y);
+        }
+    }
+
+    void ScatterPlotLod::Build(const float* _Xs, const float* _Ys, size_t _Count)
+    {
+        FillPoints(_Xs, _Ys, _Count, m_Points, &m_Min, &m_Max);
+        // Bounds are never empty, so every point gets a cell
+        m_Max = glm::max(m_Max, m_Min + glm::max(glm::abs(m_Min) * 1e-6f, glm::vec2(1e-6f)));
+
+        const uint32_t resolution = kScatterDensityResolution;
+        const glm::vec2 cellsPerUnit = float(resolution) / (m_Max - m_Min);
+
+        std::vector<uint32_t> counts(size_t(resolution) * resolution, 0);
+        for (const glm::vec2& point : m_Points)
+        {
+            glm::uvec2 cell = glm::min(glm::uvec2((point - m_Min) * cellsPerUnit), glm::uvec2(resolution - 1));
+            counts[size_t(cell.y) * resolution + cell.x]++;
+        }
+
+        m_Levels.clear();
+        m_Levels.push_back(counts);
+        for (uint32_t levelResolution = resolution / 2; levelResolution > 0; levelResolution /= 2)
+        {
+            const std::vector<uint32_t>& previous = m_Levels.back();
+            std::vector<uint32_t> level(size_t(levelResolution) * levelResolution);
+            for (uint32_t y = 0; y < levelResolution; y++)
+            {
+                for (uint32_t x = 0; x < levelResolution; x++)
+                {
+                    size_t cell = size_t(y * 2) * (levelResolution * 2) + x * 2;
+                    level[size_t(y) * levelResolution + x] = previous[cell] + previous[cell + 1] +
+                                                             previous[cell + levelResolution * 2] +
+                                                             previous[cell + levelResolution * 2 + 1];
+                }
+            }
+            m_Levels.push_back(std::move(level));
+        }
+
+        const size_t stride = resolution + 1;
+        m_SummedCounts.assign(stride * stride, 0);
+        for (uint32_t y = 0; y < resolution; y++)
+        {
+            for (uint32_t x = 0; x < resolution; x++)
+            {
+                m_SummedCounts[(y + 1) * stride + x + 1] = counts[size_t(y) * resolution + x] +
+                                                           m_SummedCounts[y * stride + x + 1] +
+                                                           m_SummedCounts[(y + 1) * stride + x] -
+                                                           m_SummedCounts[y * stride + x];
+            }
+        }
+
+        m_HasView = false;
+    }
+
+    uint64_t ScatterPlotLod::CountPoints(const PlotLodView& _View) const
+    {
+        const double resolution = kScatterDensityResolution;
+        auto toCell = [&](double _Value, float _Min, float _Max) {
+            return uint32_t(glm::clamp((_Value - _Min) / (double(_Max) - _Min) * resolution, 0.0, resolution));
+        };
+        // Cells partially in the view are counted, so it is an upper bound
+        uint32_t beginX = toCell(_View.MinX, m_Min.x, m_Max.x);
+        uint32_t endX = glm::min(toCell(_View.MaxX, m_Min.x, m_Max.x) + 1, kScatterDensityResolution);
+        uint32_t beginY = toCell(_View.MinY, m_Min.y, m_Max.y);
+        uint32_t endY = glm::min(toCell(_View.MaxY, m_Min.y, m_Max.y) + 1, kScatterDensityResolution);
+        if (beginX >= endX || beginY >= endY)
+        {
+            return 0;
+        }
+
+        const size_t stride = kScatterDensityResolution + 1;
+        return m_SummedCounts[endY * stride + endX] - m_SummedCounts[beginY * stride + endX] -
+               m_SummedCounts[endY * stride + beginX] + m_SummedCounts[beginY * stride + beginX];
+    }
+
+    bool ScatterPlotLod::Update(const PlotLodView& _View)
+    {
+        if (m_HasView && _View == m_View)
+        {
+            return false;
+        }
+
+        m_HasView = true;
+        m_View = _View;
+        m_Xs.clear();
+        m_Ys.clear();
+        m_Density.clear();
+        m_DensityWidth = 0;
+        m_DensityHeight = 0;
+        m_MaxDensity = 0.0f;
+
+        m_IsDensity = !m_Points.empty() && CountPoints(_View) > kScatterMaxPoints;
+        if (m_IsDensity)
+        {
+            UpdateDensity(_View);
+        }
+        else
+        {
+            UpdatePoints(_View);
+        }
+
+        return true;
+    }
+
+    void ScatterPlotLod::UpdatePoints(const PlotLodView& _View)
+    {
+        size_t begin = 0;
+        size_t end = 0;
+        FindVisibleRange(m_Points, _View.MinX, _View.MaxX, &begin, &end);
+        for (size_t i = begin; i < end; i++)
+        {
+            if (m_Points[i].y >= _View.MinY && m_Points[i].y <= _View.MaxY)
+            {
+                m_Xs.push_back(m_Points[i].x);
+                m_Ys.push_back(m_Points[i].y);
+            }
+        }
+    }
+
+    void ScatterPlotLod::UpdateDensity(const PlotLodView& _View)
+    {
+        m_DensityWidth = glm::max(_View.Width / kScatterDensityCellPixels, 1u);
+        m_DensityHeight = glm::max(_View.Height / kScatterDensityCellPixels, 1u);
+        const glm::dvec2 viewMin(_View.MinX, _View.MinY);
+        const glm::dvec2 viewCell = glm::dvec2(_View.MaxX - _View.MinX, _View.MaxY - _View.MinY) /
+                                    glm::dvec2(m_DensityWidth, m_DensityHeight);
+        const glm::dvec2 extent = glm::dvec2(m_Max - m_Min);
+
+        // The coarsest level with cells not bigger than the view cells
+        uint32_t level = 0;
+        while (level + 1 < m_Levels.size() &&
+               extent.x / double(kScatterDensityResolution >> (level + 1)) <= viewCell.x &&
+               extent.y / double(kScatterDensityResolution >> (level + 1)) <= viewCell.y)
+        {
+            level++;
+        }
+        const uint32_t resolution = kScatterDensityResolution >> level;
+        const std::vector<uint32_t>& counts = m_Levels[level];
+        const glm::dvec2 levelCell = extent / double(resolution);
+
+        // Level cells overlapping the view
+        glm::dvec2 beginCell = glm::clamp((viewMin - glm::dvec2(m_Min)) / levelCell, 0.0, double(resolution));
+        glm::dvec2 endCell =
+            glm::clamp((glm::dvec2(_View.MaxX, _View.MaxY) - glm::dvec2(m_Min)) / levelCell, 0.0, double(resolution));
+
+        std::vector<double> density(size_t(m_DensityWidth) * m_DensityHeight, 0.0);
+        for (uint32_t y = uint32_t(beginCell.y); y < uint32_t(glm::ceil(endCell.y)); y++)
+        {
+            for (uint32_t x = uint32_t(beginCell.x); x < uint32_t(glm::ceil(endCell.x)); x++)
+            {
+                uint32_t count = counts[size_t(y) * resolution + x];
+                if (count == 0)
+                {
+                    continue;
+                }
+
+                // Cell is spread evenly over all view cells it overlaps
+                glm::dvec2 cellMin = glm::dvec2(m_Min) + glm::dvec2(x, y) * levelCell;
+                glm::dvec2 first = glm::floor((cellMin - viewMin) / viewCell);
+                glm::dvec2 last = glm::ceil((cellMin + levelCell - viewMin) / viewCell) - 1.0;
+                first = glm::clamp(first, glm::dvec2(0.0), glm::dvec2(m_DensityWidth - 1, m_DensityHeight - 1));
+                last = glm::clamp(last, first, glm::dvec2(m_DensityWidth - 1, m_DensityHeight - 1));
+
+                double share = double(count) / ((last.x - first.x + 1.0) * (last.y - first.y + 1.0));
+                for (uint32_t densityY = uint32_t(first.y); densityY <= uint32_t(last.y); densityY++)
+                {
+                    for (uint32_t densityX = uint32_t(first.x); densityX <= uint32_t(last.x); densityX++)
+                    {
+                        density[size_t(densityY) * m_DensityWidth + densityX] += share;
+                    }
+                }
+            }
+        }
+
+        m_Density.resize(density.size());
+        for (uint32_t y = 0; y < m_DensityHeight; y++)
+        {
+            for (uint32_t x = 0; x < m_DensityWidth; x++)
+            {
+                float value = float(std::log10(1.0 + density[size_t(y) * m_DensityWidth + x]));
+                m_Density[size_t(m_DensityHeight - 1 - y) * m_DensityWidth + x] = value;
+                m_MaxDensity = glm::max(m_MaxDensity, value);
+            }
+        }
+    }
+
+}    // namespace LM
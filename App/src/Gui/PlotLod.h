@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace LM
+{
+
+    // Visible part of a plot and its size in pixels
+    struct PlotLodView
+    {
+        double MinX = 0.0;
+        double MaxX = 0.0;
+        double MinY = 0.0;
+        double MaxY = 0.0;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+
+        bool operator==(const PlotLodView&) const = default;
+    };
+
+    // View of the current plot, call it between ImPlot::BeginPlot and ImPlot::EndPlot after the axes setup
+    PlotLodView GetPlotLodView();
+
+    enum class LineLodMode
+    {
+        // Lowest and highest point of every pixel column, keeps every spike
+        MinMax = 0,
+        // Largest Triangle Three Buckets, keeps the shape with one point per pixel column
+        Lttb,
+    };
+
+    // Millions of points of y(x) reduced to about two points per pixel column. Points are sorted by x and the
+    // pyramids are built once: min/max of 2^k consecutive points on level k and LTTB of the previous level with half
+    // of its points. Update() takes the coarsest level which still has enough points in the view, so its cost depends
+    // on the plot width, not on the points count
+    class LinePlotLod
+    {
+    public:
+        void Build(const float* _Xs, const float* _Ys, size_t _Count);
+
+        // Returns true if the points to draw were recalculated, which happens only when the view or the mode changes
+        bool Update(const PlotLodView& _View, LineLodMode _Mode);
+
+        size_t GetPointsCount() const { return m_Points.size(); }
+        glm::vec2 GetMin() const { return m_Min; }
+        glm::vec2 GetMax() const { return m_Max; }
+
+        const std::vector<double>& GetXs() const { return m_Xs; }
+        const std::vector<double>& GetYs() const { return m_Ys; }
+
+    protected:
+        struct Bucket
+        {
+            float MinY;
+            float MaxY;
+        };
+
+        void UpdateMinMax(const PlotLodView& _View);
+        void UpdateLttb(const PlotLodView& _View);
+
+    protected:
+        std::vector<glm::vec2> m_Points;
+        glm::vec2 m_Min = glm::vec2(0.0f);
+        glm::vec2 m_Max = glm::vec2(0.0f);
+
+        // Level k has buckets of 2^(k + 1) points
+        std::vector<std::vector<Bucket>> m_MinMaxLevels;
+        // Level k has about m_Points.size() / 2^(k + 1) points
+        std::vector<std::vector<glm::vec2>> m_LttbLevels;
+
+        bool m_HasView = false;
+        PlotLodView m_View;
+        LineLodMode m_Mode = LineLodMode::MinMax;
+        std::vector<double> m_Xs;
+        std::vector<double> m_Ys;
+    };
+
+    // Scatter of millions of points. The view shows points themselves when there are few of them, otherwise a density
+    // map with about kScatterDensityCellPixels pixels per cell. Counts are stored in a pyramid of grids over the
+    // points bounds which is built once, the density map of the view is resampled from the level with cells just
+    // smaller than the view cells
+    class ScatterPlotLod
+    {
+    public:
+        void Build(const float* _Xs, const float* _Ys, size_t _Count);
+
+        // Returns true if the view data was recalculated, which happens only when the view changes
+        bool Update(const PlotLodView& _View);
+
+        size_t GetPointsCount() const { return m_Points.size(); }
+        glm::vec2 GetMin() const { return m_Min; }
+        glm::vec2 GetMax() const { return m_Max; }
+
+        bool IsDensity() const { return m_IsDensity; }
+
+        // Points of the view when it isn't a density map
+        const std::vector<double>& GetXs() const { return m_Xs; }
+        const std::vector<double>& GetYs() const { return m_Ys; }
+
+        // log10(1 + count) of every cell of the view, row 0 is at MaxY as ImPlot::PlotHeatmap expects
+        const std::vector<float>& GetDensity() const { return m_Density; }
+        uint32_t GetDensityWidth() const { return m_DensityWidth; }
+        uint32_t GetDensityHeight() const { return m_DensityHeight; }
+        float GetMaxDensity() const { return m_MaxDensity; }
+
+    protected:
+        // Upper bound of the points count in the view
+        uint64_t CountPoints(const PlotLodView& _View) const;
+
+        void UpdatePoints(const PlotLodView& _View);
+        void UpdateDensity(const PlotLodView& _View);
+
+    protected:
+        // Sorted by x
+        std::vector<glm::vec2> m_Points;
+        glm::vec2 m_Min = glm::vec2(0.0f);
+        glm::vec2 m_Max = glm::vec2(0.0f);
+
+        // Level k is a grid of (kScatterDensityResolution >> k)^2 cells over the points bounds, row 0 is at MinY
+        std::vector<std::vector<uint32_t>> m_Levels;
+        // Summed area table of level 0: cell (x + 1, y + 1) is the count of cells [0, x] x [0, y], so CountPoints()
+        // takes O(1)
+        std::vector<uint32_t> m_SummedCounts;
+
+        bool m_HasView = false;
+        PlotLodView m_View;
+        bool m_IsDensity = false;
+        std::vector<double> m_Xs;
+        std::vector<double> m_Ys;
+        std::vector<float> m_Density;
+        uint32_t m_DensityWidth = 0;
+        uint32_t m_DensityHeight = 0;
+        float m_MaxDensity = 0.0f;
+    };
+
+}    // namespace LM
@@ -0,0 +1,168 @@
+#include "PlotSelection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Engine/ImGui/Plots/implot.h"
+
+namespace LM
+{
+
+    constexpr size_t kPlotHitPointsPerCell = 4;
+    constexpr uint32_t kPlotHitMaxResolution = 4096;
+
+    static bool IsSameItem(const PlotItem& _A, const PlotItem& _B) { return _A.Is(_B.Source, _B.Index); }
+
+    bool PlotSelection::NewFrame()
+    {
+        bool changed = !IsSameItem(m_Hovered, m_NextHovered);
+        m_Hovered = m_NextHovered;
+        m_NextHovered = {};
+        return changed;
+    }
+
+    void PlotSelection::Select(const PlotItem& _Item)
+    {
+        m_Selected = _Item;
+        m_SelectionChanged = true;
+    }
+
+    void PlotSelection::Clear(PlotSource _Source)
+    {
+        for (PlotItem* item : { &m_Hovered, &m_NextHovered, &m_Selected })
+        {
+            if (item->Is(_Source))
+            {
+                *item = {};
+            }
+        }
+    }
+
+    bool PlotSelection::PopSelectionChanged()
+    {
+        bool changed = m_SelectionChanged;
+        m_SelectionChanged = false;
+        return changed;
+    }
+
+    glm::dvec2 GetPlotPickRadius(float _Pixels)
+    {
+        ImPlotRect limits = ImPlot::GetPlotLimits();
+        ImVec2 size = ImPlot::GetPlotSize();
+        return glm::dvec2(limits.X.Size() / glm::max(double(size.x), 1.0),
+                          limits.Y.Size() / glm::max(double(size.y), 1.0)) *
+               double(_Pixels);
+    }
+
+    int64_t FindNearestSorted(const double* _Xs, size_t _Count, double _X, double _MaxDistance)
+    {
+        const double* next = std::lower_bound(_Xs, _Xs + _Count, _X);
+
+        int64_t nearest = -1;
+        double nearestDistance = _MaxDistance;
+        if (next != _Xs + _Count && *next - _X <= nearestDistance)
+        {
+            nearest = next - _Xs;
+            nearestDistance = *next - _X;
+        }
+        if (next != _Xs && _X - *(next - 1) < nearestDistance)
+        {
+            nearest = next - 1 - _Xs;
+        }
+        return nearest;
+    }
+
+    void PlotHitGrid::Build(const float* _Xs, const float* _Ys, size_t _Count)
+    {
+        m_Points.resize(_Count);
+        m_Indices.resize(_Count);
+
+        glm::vec2 min(std::numeric_limits<float>::max());
+        glm::vec2 max(std::numeric_limits<float>::lowest());
+        for (size_t i = 0; i < _Count; i++)
+        {
+            min = glm::min(min, glm::vec2(_Xs[i], _Ys[i]));
+            max = glm::max(max, glm::vec2(_Xs[i], _Ys[i]));
+        }
+        if (_Count == 0)
+        {
+            min = max = glm::vec2(0.0f);
+        }
+
+        m_Resolution = uint32_t(glm::clamp(std::sqrt(double(_Count / kPlotHitPointsPerCell)), 1.0,
+                                           double(kPlotHitMaxResolution)));
+        m_Min = min;
+        m_CellSize = (max - min) / float(m_Resolution);
+        m_CellSize = glm::vec2(m_CellSize.x > 0.0f ? m_CellSize.x : 1.0f, m_CellSize.y > 0.0f ? m_CellSize.y : 1.0f);
+
+        auto getCell = [&](float _X, float _Y) {
+            uint32_t x = uint32_t(glm::clamp((_X - m_Min.x) / m_CellSize.x, 0.0f, float(m_Resolution - 1)));
+            uint32_t y = uint32_t(glm::clamp((_Y - m_Min.y) / m_CellSize.y, 0.0f, float(m_Resolution - 1)));
+            return y * m_Resolution + x;
+        };
+
+        // Counting sort by cell
+        m_CellStarts.assign(size_t(m_Resolution) * m_Resolution + 1, 0);
+        for (size_t i = 0; i < _Count; i++)
+        {
+            m_CellStarts[getCell(_Xs[i], _Ys[i]) + 1]++;
+        }
+        for (size_t cell = 1; cell < m_CellStarts.size(); cell++)
+        {
+            m_CellStarts[cell] += m_CellStarts[cell - 1];
+        }
+
+        std::vector<uint32_t> cellEnds(m_CellStarts.begin(), m_CellStarts.end() - 1);
+        for (size_t i = 0; i < _Count; i++)
+        {
+            uint32_t position = cellEnds[getCell(_Xs[i], _Ys[i])]++;
+            m_Points[position] = glm::vec2(_Xs[i], _Ys[i]);
+            m_Indices[position] = uint32_t(i);
+        }
+    }
+
+    int64_t PlotHitGrid::FindNearest(const glm::dvec2& _Point, const glm::dvec2& _Radius) const
+    {
+        if (m_Points.empty() || !(_Radius.x > 0.0) || !(_Radius.y > 0.0))
+        {
+            return -1;
+        }
+
+        const glm::dvec2 cellSize = glm::dvec2(m_CellSize);
+        const glm::dvec2 first = glm::floor((_Point - _Radius - glm::dvec2(m_Min)) / cellSize);
+        const glm::dvec2 last = glm::floor((_Point + _Radius - glm::dvec2(m_Min)) / cellSize);
+        // Points out of the bounds are clamped to the border cells, so only ranges fully out of the grid are empty
+        if (last.x < 0.0 || last.y < 0.0 || first.x >= m_Resolution || first.y >= m_Resolution)
+        {
+            return -1;
+        }
+
+        const uint32_t beginX = uint32_t(glm::max(first.x, 0.0));
+        const uint32_t beginY = uint32_t(glm::max(first.y, 0.0));
+        const uint32_t endX = uint32_t(glm::min(last.x, double(m_Resolution - 1))) + 1;
+        const uint32_t endY = uint32_t(glm::min(last.y, double(m_Resolution - 1))) + 1;
+
+        int64_t nearest = -1;
+        double nearestDistance = 1.0;
+        for (uint32_t y = beginY; y < endY; y++)
+        {
+            for (uint32_t x = beginX; x < endX; x++)
+            {
+                const uint32_t cell = y * m_Resolution + x;
+                for (uint32_t i = m_CellStarts[cell]; i < m_CellStarts[cell + 1]; i++)
+                {
+                    glm::dvec2 offset = (glm::dvec2(m_Points[i]) - _Point) / _Radius;
+                    double distance = glm::dot(offset, offset);
+                    if (distance <= nearestDistance)
+                    {
+                        nearest = m_Indices[i];
+                        nearestDistance = distance;
+                    }
+                }
+            }
+        }
+        return nearest;
+    }
+
+}    // namespace LM
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Calculations/Calculations.h"
+
+namespace LM
+{
+
+    enum class PlotSource
+    {
+        None = 0,
+        ToolAnglePlot,
+        WheelDiametrPlot,
+        Candidates,
+    };
+
+    // Item of a plot, every view which shows items of the same source highlights it
+    struct PlotItem
+    {
+        PlotSource Source = PlotSource::None;
+        int64_t Index = -1;
+
+        // Wheel and tool the item stands for, drawn in "Output Wheel" when the item is selected
+        GrindingWheelCalcParams Values = {};
+        ToolParams Tool = {};
+
+        bool Is(PlotSource _Source) const { return Source == _Source; }
+        bool Is(PlotSource _Source, int64_t _Index) const { return Source == _Source && Index == _Index; }
+    };
+
+    // Hovered and selected items shared by all plots. Views are drawn one after another, so the item hovered in one
+    // frame is shown by all views in the next one
+    class PlotSelection
+    {
+    public:
+        // Returns true if the hovered item changed, then one more frame is needed to show it everywhere
+        bool NewFrame();
+
+        void Hover(const PlotItem& _Item) { m_NextHovered = _Item; }
+        void Select(const PlotItem& _Item);
+        // Indices of the source are invalid after its data has changed
+        void Clear(PlotSource _Source);
+
+        const PlotItem& GetHovered() const { return m_Hovered; }
+        const PlotItem& GetSelected() const { return m_Selected; }
+
+        // Returns true once after every Select()
+        bool PopSelectionChanged();
+
+    protected:
+        PlotItem m_Hovered;
+        PlotItem m_NextHovered;
+        PlotItem m_Selected;
+        bool m_SelectionChanged = false;
+    };
+
+    // Pick radius of _Pixels pixels in units of the current plot axes, call it between ImPlot::BeginPlot and
+    // ImPlot::EndPlot after the axes setup
+    glm::dvec2 GetPlotPickRadius(float _Pixels);
+
+    // Index of the point of sorted _Xs nearest to _X in O(log n), -1 if it is farther than _MaxDistance
+    int64_t FindNearestSorted(const double* _Xs, size_t _Count, double _X, double _MaxDistance);
+
+    // Points bucketed in a uniform grid over their bounds with about kPlotHitPointsPerCell points per cell, so the
+    // point nearest to the mouse is searched only among the points of the cells under the pick radius
+    class PlotHitGrid
+    {
+    public:
+        void Build(const float* _Xs, const float* _Ys, size_t _Count);
+
+        // Index of the nearest point inside the ellipse with _Radius half axes around _Point, -1 if there is none
+        int64_t FindNearest(const glm::dvec2& _Point, const glm::dvec2& _Radius) const;
+
+    protected:
+        glm::vec2 m_Min = glm::vec2(0.0f);
+        glm::vec2 m_CellSize = glm::vec2(1.0f);
+        uint32_t m_Resolution = 0;
+
+        // Points of cell i are [m_CellStarts[i], m_CellStarts[i + 1]) of m_Points and m_Indices
+        std::vector<uint32_t> m_CellStarts;
+        std::vector<glm::vec2> m_Points;
+        std::vector<uint32_t> m_Indices;
+    };
+
+}    // namespace LM
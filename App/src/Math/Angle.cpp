@@ -5,8 +5,8 @@ namespace LM
 
     float CalcAngle(glm::vec4 _Vec1, glm::vec4 _Vec2)
     {
-        return glm::degrees(
-            glm::acos((_Vec1.x * _Vec2.x + _Vec1.y * _Vec2.y) / (Vec2Length(_Vec1) * Vec2Length(_Vec2))));
+        float lengths2 = (_Vec1.x * _Vec1.x + _Vec1.y * _Vec1.y) * (_Vec2.x * _Vec2.x + _Vec2.y * _Vec2.y);
+        return glm::degrees(glm::acos((_Vec1.x * _Vec2.x + _Vec1.y * _Vec2.y) / glm::sqrt(lengths2)));
     }
 
 }    // namespace LM
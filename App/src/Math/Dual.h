@@ -0,0 +1,322 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+namespace LM
+{
+
+    // Value and its derivatives by N inputs for forward mode automatic differentiation: every operation applies the
+    // chain rule to the derivatives, so one evaluation of a function gives its value and its gradient. Computed in
+    // double, derivatives of float kernels by finite differences lose most of their digits
+    template <size_t N>
+    struct Dual
+    {
+        double Value = 0.0;
+        std::array<double, N> Derivatives = {};
+
+        Dual() = default;
+        Dual(double _Value) : Value(_Value) { }
+
+        // Input _Index of the function
+        static Dual Variable(double _Value, size_t _Index)
+        {
+            Dual result(_Value);
+            result.Derivatives[_Index] = 1.0;
+            return result;
+        }
+    };
+
+    // f(_X) with value _Value and derivative _Derivative
+    template <size_t N>
+    inline Dual<N> ApplyChain(const Dual<N>& _X, double _Value, double _Derivative)
+    {
+        Dual<N> result(_Value);
+        for (size_t i = 0; i < N; i++)
+        {
+            result.Derivatives[i] = _Derivative * _X.Derivatives[i];
+        }
+        return result;
+    }
+
+    template <size_t N>
+    inline Dual<N> operator-(const Dual<N>& _A)
+    {
+        return ApplyChain(_A, -_A.Value, -1.0);
+    }
+
+    template <size_t N>
+    inline Dual<N> operator+(const Dual<N>& _A, const Dual<N>& _B)
+    {
+        Dual<N> result(_A.Value + _B.Value);
+        for (size_t i = 0; i < N; i++)
+        {
+            result.Derivatives[i] = _A.Derivatives[i] + _B.Derivatives[i];
+        }
+        return result;
+    }
+
+    template <size_t N>
+    inline Dual<N> operator-(const Dual<N>& _A, const Dual<N>& _B)
+    {
+        Dual<N> result(_A.Value - _B.Value);
+        for (size_t i = 0; i < N; i++)
+        {
+            result.Derivatives[i] = _A.Derivatives[i] - _B.Derivatives[i];
+        }
+        return result;
+    }
+
+    template <size_t N>
+    inline Dual<N> operator*(const Dual<N>& _A, const Dual<N>& _B)
+    {
+        Dual<N> result(_A.Value * _B.Value);
+        for (size_t i = 0; i < N; i++)
+        {
+            result.Derivatives[i] = _A.Derivatives[i] * _B.Value + _A.Value * _B.Derivatives[i];
+        }
+        return result;
+    }
+
+    template <size_t N>
+    inline Dual<N> operator/(const Dual<N>& _A, const Dual<N>& _B)
+    {
+        Dual<N> result(_A.Value / _B.Value);
+        for (size_t i = 0; i < N; i++)
+        {
+            result.Derivatives[i] = (_A.Derivatives[i] - result.Value * _B.Derivatives[i]) / _B.Value;
+        }
+        return result;
+    }
+
+    // Template arguments aren't deduced through conversions, so constants need their own operators
+    template <size_t N>
+    inline Dual<N> operator+(const Dual<N>& _A, double _B)
+    {
+        return ApplyChain(_A, _A.Value + _B, 1.0);
+    }
+
+    template <size_t N>
+    inline Dual<N> operator+(double _A, const Dual<N>& _B)
+    {
+        return ApplyChain(_B, _A + _B.Value, 1.0);
+    }
+
+    template <size_t N>
+    inline Dual<N> operator-(const Dual<N>& _A, double _B)
+    {
+        return ApplyChain(_A, _A.Value - _B, 1.0);
+    }
+
+    template <size_t N>
+    inline Dual<N> operator-(double _A, const Dual<N>& _B)
+    {
+        return ApplyChain(_B, _A - _B.Value, -1.0);
+    }
+
+    template <size_t N>
+    inline Dual<N> operator*(const Dual<N>& _A, double _B)
+    {
+        return ApplyChain(_A, _A.Value * _B, _B);
+    }
+
+    template <size_t N>
+    inline Dual<N> operator*(double _A, const Dual<N>& _B)
+    {
+        return ApplyChain(_B, _A * _B.Value, _A);
+    }
+
+    template <size_t N>
+    inline Dual<N> operator/(const Dual<N>& _A, double _B)
+    {
+        return ApplyChain(_A, _A.Value / _B, 1.0 / _B);
+    }
+
+    template <size_t N>
+    inline Dual<N> operator/(double _A, const Dual<N>& _B)
+    {
+        double value = _A / _B.Value;
+        return ApplyChain(_B, value, -value / _B.Value);
+    }
+
+    template <size_t N>
+    inline Dual<N> Sqrt(const Dual<N>& _X)
+    {
+        double value = std::sqrt(_X.Value);
+        return ApplyChain(_X, value, 0.5 / value);
+    }
+
+    template <size_t N>
+    inline Dual<N> Sin(const Dual<N>& _X)
+    {
+        return ApplyChain(_X, std::sin(_X.Value), std::cos(_X.Value));
+    }
+
+    template <size_t N>
+    inline Dual<N> Cos(const Dual<N>& _X)
+    {
+        return ApplyChain(_X, std::cos(_X.Value), -std::sin(_X.Value));
+    }
+
+    template <size_t N>
+    inline Dual<N> Tan(const Dual<N>& _X)
+    {
+        double value = std::tan(_X.Value);
+        return ApplyChain(_X, value, 1.0 + value * value);
+    }
+
+    // Derivative is infinite at -1 and 1 and NaN outside, as the value
+    template <size_t N>
+    inline Dual<N> Acos(const Dual<N>& _X)
+    {
+        return ApplyChain(_X, std::acos(_X.Value), -1.0 / std::sqrt(1.0 - _X.Value * _X.Value));
+    }
+
+    template <size_t N>
+    inline Dual<N> Abs(const Dual<N>& _X)
+    {
+        return ApplyChain(_X, std::abs(_X.Value), _X.Value < 0.0 ? -1.0 : 1.0);
+    }
+
+    // The smaller by value with its derivatives, derivative of the min where both are equal is taken from _A
+    template <size_t N>
+    inline const Dual<N>& Min(const Dual<N>& _A, const Dual<N>& _B)
+    {
+        return _B.Value < _A.Value ? _B : _A;
+    }
+
+    template <size_t N>
+    inline Dual<N> Radians(const Dual<N>& _X)
+    {
+        return _X * glm::radians(1.0);
+    }
+
+    template <size_t N>
+    inline Dual<N> Degrees(const Dual<N>& _X)
+    {
+        return _X * glm::degrees(1.0);
+    }
+
+    template <size_t N>
+    struct DualVec2
+    {
+        Dual<N> x;
+        Dual<N> y;
+    };
+
+    template <size_t N>
+    struct DualVec4
+    {
+        Dual<N> x;
+        Dual<N> y;
+        Dual<N> z;
+        Dual<N> w;
+    };
+
+    template <size_t N>
+    inline DualVec2<N> operator-(const DualVec2<N>& _A)
+    {
+        return { -_A.x, -_A.y };
+    }
+
+    template <size_t N>
+    inline DualVec4<N> operator-(const DualVec4<N>& _A, const DualVec4<N>& _B)
+    {
+        return { _A.x - _B.x, _A.y - _B.y, _A.z - _B.z, _A.w - _B.w };
+    }
+
+    template <size_t N>
+    inline DualVec2<N> ToVec2(const DualVec4<N>& _Vec)
+    {
+        return { _Vec.x, _Vec.y };
+    }
+
+    // Column major as glm::mat4: Columns[column][row]
+    template <size_t N>
+    struct DualMat4
+    {
+        std::array<std::array<Dual<N>, 4>, 4> Columns;
+
+        static DualMat4 Identity()
+        {
+            DualMat4 result;
+            for (size_t i = 0; i < 4; i++)
+            {
+                result.Columns[i][i] = 1.0;
+            }
+            return result;
+        }
+    };
+
+    template <size_t N>
+    inline DualMat4<N> operator*(const DualMat4<N>& _A, const DualMat4<N>& _B)
+    {
+        DualMat4<N> result;
+        for (size_t column = 0; column < 4; column++)
+        {
+            for (size_t row = 0; row < 4; row++)
+            {
+                Dual<N> sum;
+                for (size_t k = 0; k < 4; k++)
+                {
+                    sum = sum + _A.Columns[k][row] * _B.Columns[column][k];
+                }
+                result.Columns[column][row] = sum;
+            }
+        }
+        return result;
+    }
+
+    template <size_t N>
+    inline DualVec4<N> operator*(const DualMat4<N>& _Matrix, const DualVec4<N>& _Vec)
+    {
+        std::array<Dual<N>, 4> result;
+        for (size_t row = 0; row < 4; row++)
+        {
+            result[row] = _Matrix.Columns[0][row] * _Vec.x + _Matrix.Columns[1][row] * _Vec.y +
+                          _Matrix.Columns[2][row] * _Vec.z + _Matrix.Columns[3][row] * _Vec.w;
+        }
+        return { result[0], result[1], result[2], result[3] };
+    }
+
+    // Same as glm::translate(glm::mat4(1.0f), _Offset)
+    template <size_t N>
+    inline DualMat4<N> Translate(const Dual<N>& _X, const Dual<N>& _Y, const Dual<N>& _Z)
+    {
+        DualMat4<N> result = DualMat4<N>::Identity();
+        result.Columns[3][0] = _X;
+        result.Columns[3][1] = _Y;
+        result.Columns[3][2] = _Z;
+        return result;
+    }
+
+    // Same as glm::rotate(glm::mat4(1.0f), _Angle, _Axis)
+    template <size_t N>
+    inline DualMat4<N> Rotate(const Dual<N>& _Angle, const glm::vec3& _Axis)
+    {
+        const glm::dvec3 axis = glm::normalize(glm::dvec3(_Axis));
+        const Dual<N> c = Cos(_Angle);
+        const Dual<N> s = Sin(_Angle);
+
+        DualMat4<N> result = DualMat4<N>::Identity();
+        for (size_t column = 0; column < 3; column++)
+        {
+            for (size_t row = 0; row < 3; row++)
+            {
+                result.Columns[column][row] = (1.0 - c) * (axis[column] * axis[row]);
+            }
+            result.Columns[column][column] = result.Columns[column][column] + c;
+        }
+        result.Columns[0][1] = result.Columns[0][1] + s * axis.z;
+        result.Columns[0][2] = result.Columns[0][2] - s * axis.y;
+        result.Columns[1][0] = result.Columns[1][0] - s * axis.z;
+        result.Columns[1][2] = result.Columns[1][2] + s * axis.x;
+        result.Columns[2][0] = result.Columns[2][0] + s * axis.y;
+        result.Columns[2][1] = result.Columns[2][1] - s * axis.x;
+        return result;
+    }
+
+}    // namespace LM
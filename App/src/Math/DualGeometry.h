@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Dual.h"
+#include "Intersections.h"
+
+namespace LM
+{
+
+    // Dual number versions of the geometry kernels: same formulas as the float ones (Angle.h, Intersections.h), so a
+    // single evaluation gives the values and their derivatives by all inputs
+
+    template <size_t N>
+    Dual<N> CalcAngle(const DualVec2<N>& _Vec1, const DualVec2<N>& _Vec2)
+    {
+        Dual<N> lengths2 = (_Vec1.x * _Vec1.x + _Vec1.y * _Vec1.y) * (_Vec2.x * _Vec2.x + _Vec2.y * _Vec2.y);
+        return Degrees(Acos((_Vec1.x * _Vec2.x + _Vec1.y * _Vec2.y) / Sqrt(lengths2)));
+    }
+
+    template <size_t N>
+    DualVec2<N> LineCircleIntersection(const Dual<N>& _ToolRadius, const DualVec2<N>& _Vec1, const DualVec2<N>& _Vec2)
+    {
+        Dual<N> dx = _Vec2.x - _Vec1.x;
+        Dual<N> dy = _Vec2.y - _Vec1.y;
+        Dual<N> dr2 = dx * dx + dy * dy;
+
+        Dual<N> d = _Vec1.x * _Vec2.y - _Vec2.x * _Vec1.y;
+
+        Dual<N> discriminant = Sqrt(_ToolRadius * _ToolRadius * dr2 - d * d);
+
+        double sgnDy = dy.Value < 0.0 ? -1.0 : 1.0;
+        Dual<N> x1 = (d * dy + sgnDy * dx * discriminant) / dr2;
+        Dual<N> y1 = (Abs(dy) * discriminant - d * dx) / dr2;
+
+        return { x1, y1 };
+    }
+
+    template <size_t N>
+    Dual<N> LineToPointDistance(const DualVec2<N>& _Vec1, const DualVec2<N>& _Vec2, const DualVec2<N>& _Point)
+    {
+        DualVec2<N> line = { _Vec2.x - _Vec1.x, _Vec2.y - _Vec1.y };
+        Dual<N> t = ((_Point.x - _Vec1.x) * line.x + (_Point.y - _Vec1.y) * line.y) /
+                    (line.x * line.x + line.y * line.y);
+
+        // Clamped ends don't move with the inputs
+        if (t.Value < 0.0)
+        {
+            t = 0.0;
+        }
+        else if (t.Value > 1.0)
+        {
+            t = 1.0;
+        }
+
+        Dual<N> x = _Vec1.x + t * line.x - _Point.x;
+        Dual<N> y = _Vec1.y + t * line.y - _Point.y;
+        return Sqrt(x * x + y * y);
+    }
+
+    // Same as ArcToPointDistance. The nearest point is searched with the values only: inside the arc the squared
+    // distance is stationary by t there, so its derivatives by the inputs don't depend on how t moves, and at the
+    // ends t is the end of the arc which is differentiated as usual
+    template <size_t N>
+    Dual<N> ArcToPointDistance(const DualMat4<N>& _Matrix, const DualVec4<N>& _Center, const Dual<N>& _Radius,
+                               const Dual<N>& _AngleStart, const Dual<N>& _AngleEnd, const DualVec2<N>& _Point)
+    {
+        Dual<N> start = Radians(_AngleStart);
+        Dual<N> end = Radians(_AngleEnd);
+        Dual<N> middle = (start + end) / 2.0;
+        Dual<N> limit = Tan((end - start) / 4.0);
+
+        DualVec4<N> axisX = _Matrix * DualVec4<N> { _Radius, 0.0, 0.0, 0.0 };
+        DualVec4<N> axisY = _Matrix * DualVec4<N> { 0.0, _Radius, 0.0, 0.0 };
+        DualVec4<N> center = _Matrix * _Center;
+        DualVec2<N> d = { center.x - _Point.x, center.y - _Point.y };
+
+        Dual<N> cosMiddle = Cos(middle);
+        Dual<N> sinMiddle = Sin(middle);
+        DualVec2<N> u = { axisX.x * cosMiddle + axisY.x * sinMiddle, axisX.y * cosMiddle + axisY.y * sinMiddle };
+        DualVec2<N> v = { axisY.x * cosMiddle - axisX.x * sinMiddle, axisY.y * cosMiddle - axisX.y * sinMiddle };
+
+        double t = FindArcNearestParam(glm::dvec2(d.x.Value, d.y.Value), glm::dvec2(u.x.Value, u.y.Value),
+                                       glm::dvec2(v.x.Value, v.y.Value), limit.Value);
+
+        Dual<N> dualT = t;
+        if (t == -limit.Value)
+        {
+            dualT = -limit;
+        }
+        else if (t == limit.Value)
+        {
+            dualT = limit;
+        }
+
+        Dual<N> t2 = dualT * dualT;
+        Dual<N> cosT = (1.0 - t2) / (1.0 + t2);
+        Dual<N> sinT = 2.0 * dualT / (1.0 + t2);
+        Dual<N> x = d.x + u.x * cosT + v.x * sinT;
+        Dual<N> y = d.y + u.y * cosT + v.y * sinT;
+        return Sqrt(x * x + y * y);
+    }
+
+}    // namespace LM
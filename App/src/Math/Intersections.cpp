@@ -1,24 +1,154 @@
 #include "Intersections.h"
 
+#include <utility>
+
 namespace LM
 {
 
+    constexpr uint32_t kMaxPolynomialDegree = 4;
+    constexpr uint32_t kRootSteps = 64;
+    constexpr double kRootTolerance = 1e-10;
+
+    static double EvaluatePolynomial(const double* _Coeffs, uint32_t _Degree, double _X)
+    {
+        double result = _Coeffs[_Degree];
+        for (uint32_t i = _Degree; i > 0; i--)
+        {
+            result = result * _X + _Coeffs[i - 1];
+        }
+        return result;
+    }
+
+    static uint32_t FindQuadraticRoots(const double* _Coeffs, double _Low, double _High, double* _Roots)
+    {
+        double roots[2];
+        uint32_t rootsCount = 0;
+        if (_Coeffs[2] == 0.0)
+        {
+            if (_Coeffs[1] != 0.0)
+            {
+                roots[rootsCount++] = -_Coeffs[0] / _Coeffs[1];
+            }
+        }
+        else
+        {
+            double discriminant = _Coeffs[1] * _Coeffs[1] - 4.0 * _Coeffs[2] * _Coeffs[0];
+            if (discriminant >= 0.0)
+            {
+                // Without the cancellation of -b + sqrt(D) when b is large
+                double q = -0.5 * (_Coeffs[1] + (_Coeffs[1] < 0.0 ? -1.0 : 1.0) * glm::sqrt(discriminant));
+                roots[rootsCount++] = q / _Coeffs[2];
+                if (q != 0.0)
+                {
+                    roots[rootsCount++] = _Coeffs[0] / q;
+                }
+            }
+        }
+        if (rootsCount == 2 && roots[0] > roots[1])
+        {
+            std::swap(roots[0], roots[1]);
+        }
+
+        uint32_t result = 0;
+        for (uint32_t i = 0; i < rootsCount; i++)
+        {
+            if (roots[i] >= _Low && roots[i] <= _High)
+            {
+                _Roots[result++] = roots[i];
+            }
+        }
+        return result;
+    }
+
+    // Real roots of _Coeffs[0] + _Coeffs[1] * x + ... + _Coeffs[_Degree] * x^_Degree on [_Low, _High] in ascending
+    // order. Roots of the derivative split the range into monotone pieces, every piece has at most one root which is
+    // found with Newton steps safeguarded by bisection
+    static uint32_t FindPolynomialRoots(const double* _Coeffs, uint32_t _Degree, double _Low, double _High,
+                                        double* _Roots)
+    {
+        if (_Degree == 2)
+        {
+            return FindQuadraticRoots(_Coeffs, _Low, _High, _Roots);
+        }
+
+        double bounds[kMaxPolynomialDegree + 1];
+        uint32_t boundsCount = 0;
+        bounds[boundsCount++] = _Low;
+        if (_Degree > 2)
+        {
+            double derivative[kMaxPolynomialDegree];
+            for (uint32_t i = 0; i < _Degree; i++)
+            {
+                derivative[i] = double(i + 1) * _Coeffs[i + 1];
+            }
+            boundsCount += FindPolynomialRoots(derivative, _Degree - 1, _Low, _High, bounds + 1);
+        }
+        bounds[boundsCount++] = _High;
+
+        uint32_t rootsCount = 0;
+        for (uint32_t piece = 0; piece + 1 < boundsCount; piece++)
+        {
+            double low = bounds[piece];
+            double high = bounds[piece + 1];
+            double lowValue = EvaluatePolynomial(_Coeffs, _Degree, low);
+            double highValue = EvaluatePolynomial(_Coeffs, _Degree, high);
+            if (lowValue == 0.0)
+            {
+                if (rootsCount == 0 || _Roots[rootsCount - 1] != low)
+                {
+                    _Roots[rootsCount++] = low;
+                }
+                continue;
+            }
+            if ((lowValue < 0.0) == (highValue < 0.0))
+            {
+                continue;
+            }
+
+            bool isGrowing = lowValue < 0.0;
+            double x = (low + high) / 2.0;
+            for (uint32_t i = 0; i < kRootSteps && low < x && x < high; i++)
+            {
+                double value = EvaluatePolynomial(_Coeffs, _Degree, x);
+                ((value < 0.0) == isGrowing ? low : high) = x;
+
+                double derivative = 0.0;
+                for (uint32_t j = _Degree; j > 0; j--)
+                {
+                    derivative = derivative * x + double(j) * _Coeffs[j];
+                }
+                double next = x - value / derivative;
+                if (!(next > low && next < high))
+                {
+                    next = (low + high) / 2.0;
+                }
+                bool isConverged = glm::abs(next - x) <= kRootTolerance;
+                x = next;
+                if (isConverged)
+                {
+                    break;
+                }
+            }
+            _Roots[rootsCount++] = x;
+        }
+        return rootsCount;
+    }
+
     float SGN(float _Val) { return _Val < 0.0f ? -1.0f : 1.0f; }
 
     glm::vec2 LineCircleIntersection(float _ToolRadius, const glm::vec2& _Vec1, const glm::vec2& _Vec2)
     {
         float dx = _Vec2.x - _Vec1.x;
         float dy = _Vec2.y - _Vec1.y;
-        float dr = glm::sqrt(dx * dx + dy * dy);
+        float dr2 = dx * dx + dy * dy;
 
         float d = _Vec1.x * _Vec2.y - _Vec2.x * _Vec1.y;
 
-        // float discriminant = _ToolRadius * _ToolRadius * dr * dr - d * d;
+        float discriminant = glm::sqrt(_ToolRadius * _ToolRadius * dr2 - d * d);
 
-        float x1 = (d * dy + SGN(dy) * dx * glm::sqrt(_ToolRadius * _ToolRadius * dr * dr - d * d)) / (dr * dr);
-        float x2 = (d * dy - SGN(dy) * dx * glm::sqrt(_ToolRadius * _ToolRadius * dr * dr - d * d)) / (dr * dr);
-        float y1 = (-d * dx + glm::abs(dy) * glm::sqrt(_ToolRadius * _ToolRadius * dr * dr - d * d)) / (dr * dr);
-        float y2 = (-d * dx - glm::abs(dy) * glm::sqrt(_ToolRadius * _ToolRadius * dr * dr - d * d)) / (dr * dr);
+        // Second intersection is (d * dy - SGN(dy) * dx * discriminant, -d * dx - |dy| * discriminant) / dr2
+        float x1 = (d * dy + SGN(dy) * dx * discriminant) / dr2;
+        float y1 = (-d * dx + glm::abs(dy) * discriminant) / dr2;
 
         return { x1, y1 };
     }
@@ -34,4 +164,60 @@ namespace LM
                          glm::pow(_Vec1.y + t * (_Vec2.y - _Vec1.y) - _Point.y, 2.0f));
     }
 
+    double FindArcNearestParam(const glm::dvec2& _D, const glm::dvec2& _U, const glm::dvec2& _V, double _Limit)
+    {
+        auto distance2 = [&](double _T) {
+            double t2 = _T * _T;
+            glm::dvec2 point = _D + (_U * (1.0 - t2) + _V * (2.0 * _T)) / (1.0 + t2);
+            return glm::dot(point, point);
+        };
+
+        // Half of the derivative of the squared distance by the angle is
+        // a * cos(x) + b * sin(x) + h * sin(2x) + m * cos(2x), multiplied by (1 + t^2)^2 it is a quartic of t
+        double a = glm::dot(_D, _V);
+        double b = -glm::dot(_D, _U);
+        double h = (glm::dot(_V, _V) - glm::dot(_U, _U)) / 2.0;
+        double m = glm::dot(_U, _V);
+        double coeffs[kMaxPolynomialDegree + 1] = { a + m, 2.0 * b + 4.0 * h, -6.0 * m, 2.0 * b - 4.0 * h, m - a };
+
+        double roots[kMaxPolynomialDegree];
+        uint32_t rootsCount = FindPolynomialRoots(coeffs, kMaxPolynomialDegree, -_Limit, _Limit, roots);
+
+        double result = -_Limit;
+        double resultDistance2 = distance2(-_Limit);
+        for (uint32_t i = 0; i <= rootsCount; i++)
+        {
+            double t = i < rootsCount ? roots[i] : _Limit;
+            double tDistance2 = distance2(t);
+            if (tDistance2 < resultDistance2)
+            {
+                result = t;
+                resultDistance2 = tDistance2;
+            }
+        }
+        return result;
+    }
+
+    float ArcToPointDistance(const glm::mat4& _Matrix, const glm::vec4& _Center, float _Radius, float _AngleStart,
+                             float _AngleEnd, const glm::vec2& _Point)
+    {
+        // Angle is counted from the middle of the arc and replaced by t = tan(angle / 2), so the arc is t in
+        // [-limit, limit] and its point is d + u * (1 - t^2) / (1 + t^2) + v * 2t / (1 + t^2) relative to _Point
+        double start = glm::radians(double(_AngleStart));
+        double end = glm::radians(double(_AngleEnd));
+        double middle = (start + end) / 2.0;
+        double limit = glm::tan((end - start) / 4.0);
+
+        glm::dvec2 axisX = glm::dvec2(glm::vec2(_Matrix * glm::vec4(_Radius, 0.0f, 0.0f, 0.0f)));
+        glm::dvec2 axisY = glm::dvec2(glm::vec2(_Matrix * glm::vec4(0.0f, _Radius, 0.0f, 0.0f)));
+        glm::dvec2 d = glm::dvec2(glm::vec2(_Matrix * _Center) - _Point);
+        glm::dvec2 u = axisX * glm::cos(middle) + axisY * glm::sin(middle);
+        glm::dvec2 v = axisY * glm::cos(middle) - axisX * glm::sin(middle);
+
+        double t = FindArcNearestParam(d, u, v, limit);
+        double t2 = t * t;
+        glm::dvec2 point = d + (u * (1.0 - t2) + v * (2.0 * t)) / (1.0 + t2);
+        return float(glm::sqrt(glm::dot(point, point)));
+    }
+
 }    // namespace LM
@@ -9,4 +9,14 @@ namespace LM
 
     float LineToPointDistance(const glm::vec2& _Vec1, const glm::vec2& _Vec2, const glm::vec2& _Point);
 
+    // Distance in the xy plane from _Point to the arc of the circle (_Center, _Radius) from _AngleStart to _AngleEnd
+    // (degrees, counterclockwise, less than 360) transformed by _Matrix. A tilted arc is an elliptic arc in the xy
+    // plane, its stationary points are the roots of a quartic which are isolated on the arc without sampling it
+    float ArcToPointDistance(const glm::mat4& _Matrix, const glm::vec4& _Center, float _Radius, float _AngleStart,
+                             float _AngleEnd, const glm::vec2& _Point);
+
+    // Parameter t in [-_Limit, _Limit] of the point d + u * (1 - t^2) / (1 + t^2) + v * 2t / (1 + t^2) of an arc
+    // nearest to the origin, where t = tan(angle / 2) of the angle from the middle of the arc
+    double FindArcNearestParam(const glm::dvec2& _D, const glm::dvec2& _U, const glm::dvec2& _V, double _Limit);
+
 }    // namespace LM
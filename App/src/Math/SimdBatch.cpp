@@ -0,0 +1,115 @@
+#include "SimdBatch.h"
+
+#include <cmath>
+#include <limits>
+
+#include "SimdOps.h"
+
+namespace LM
+{
+
+    constexpr float kPi = 3.14159265358979323846f;
+    constexpr float kRadToDeg = 180.0f / kPi;
+
+    constexpr float kAcosCoefs[] = { 1.5707963050f,  -0.2145988016f, 0.0889789874f,  -0.0501743046f,
+                                     0.0308918810f,  -0.0170881256f, 0.0066700901f,  -0.0012624911f };
+
+    template <typename Ops>
+    static typename Ops::Float AcosKernel(typename Ops::Float _X)
+    {
+        typedef typename Ops::Float Float;
+
+        Float ax = Ops::Abs(_X);
+
+        Float poly = Ops::Set(kAcosCoefs[7]);
+        for (int i = 6; i >= 0; i--)
+        {
+            poly = Ops::MulAdd(poly, ax, Ops::Set(kAcosCoefs[i]));
+        }
+
+        Float result = Ops::Mul(Ops::Sqrt(Ops::Max(Ops::Sub(Ops::Set(1.0f), ax), Ops::Set(0.0f))), poly);
+        result = Ops::Select(Ops::Less(_X, Ops::Set(0.0f)), Ops::Sub(Ops::Set(kPi), result), result);
+
+        // Comparison with NaN is false, so NaN input stays NaN
+        return Ops::Select(Ops::LessEqual(ax, Ops::Set(1.0f)), result,
+                           Ops::Set(std::numeric_limits<float>::quiet_NaN()));
+    }
+
+    template <typename Ops>
+    static void LineCircleIntersectionKernel(float _Radius, const float* _X1, const float* _Y1, const float* _X2,
+                                             const float* _Y2, float* _X, float* _Y)
+    {
+        typedef typename Ops::Float Float;
+
+        Float x1 = Ops::Load(_X1);
+        Float y1 = Ops::Load(_Y1);
+        Float x2 = Ops::Load(_X2);
+        Float y2 = Ops::Load(_Y2);
+
+        Float dx = Ops::Sub(x2, x1);
+        Float dy = Ops::Sub(y2, y1);
+        Float dr2 = Ops::MulAdd(dx, dx, Ops::Mul(dy, dy));
+        Float d = Ops::Sub(Ops::Mul(x1, y2), Ops::Mul(x2, y1));
+
+        Float discriminant = Ops::Sqrt(Ops::Sub(Ops::Mul(Ops::Set(_Radius * _Radius), dr2), Ops::Mul(d, d)));
+        Float sgnDy = Ops::Select(Ops::Less(dy, Ops::Set(0.0f)), Ops::Set(-1.0f), Ops::Set(1.0f));
+
+        Float x = Ops::MulAdd(Ops::Mul(sgnDy, dx), discriminant, Ops::Mul(d, dy));
+        Float y = Ops::Sub(Ops::Mul(Ops::Abs(dy), discriminant), Ops::Mul(d, dx));
+
+        Ops::Store(_X, Ops::Div(x, dr2));
+        Ops::Store(_Y, Ops::Div(y, dr2));
+    }
+
+    template <typename Ops>
+    static void CalcAngleKernel(const float* _X1, const float* _Y1, const float* _X2, const float* _Y2, float* _Angle)
+    {
+        typedef typename Ops::Float Float;
+
+        Float x1 = Ops::Load(_X1);
+        Float y1 = Ops::Load(_Y1);
+        Float x2 = Ops::Load(_X2);
+        Float y2 = Ops::Load(_Y2);
+
+        Float dot = Ops::MulAdd(x1, x2, Ops::Mul(y1, y2));
+        Float lengths2 = Ops::Mul(Ops::MulAdd(x1, x1, Ops::Mul(y1, y1)), Ops::MulAdd(x2, x2, Ops::Mul(y2, y2)));
+
+        Float angle = AcosKernel<Ops>(Ops::Div(dot, Ops::Sqrt(lengths2)));
+        Ops::Store(_Angle, Ops::Mul(angle, Ops::Set(kRadToDeg)));
+    }
+
+    size_t GetSimdWidth() { return SimdOps::kWidth; }
+
+    const char* GetSimdName() { return SimdOps::kName; }
+
+    float FastAcos(float _X) { return AcosKernel<ScalarOps>(_X); }
+
+    void LineCircleIntersectionBatch(float _Radius, const float* _X1, const float* _Y1, const float* _X2,
+                                     const float* _Y2, float* _X, float* _Y, size_t _Count)
+    {
+        size_t i = 0;
+        for (; i + SimdOps::kWidth <= _Count; i += SimdOps::kWidth)
+        {
+            LineCircleIntersectionKernel<SimdOps>(_Radius, _X1 + i, _Y1 + i, _X2 + i, _Y2 + i, _X + i, _Y + i);
+        }
+        for (; i < _Count; i++)
+        {
+            LineCircleIntersectionKernel<ScalarOps>(_Radius, _X1 + i, _Y1 + i, _X2 + i, _Y2 + i, _X + i, _Y + i);
+        }
+    }
+
+    void CalcAngleBatch(const float* _X1, const float* _Y1, const float* _X2, const float* _Y2, float* _Angle,
+                        size_t _Count)
+    {
+        size_t i = 0;
+        for (; i + SimdOps::kWidth <= _Count; i += SimdOps::kWidth)
+        {
+            CalcAngleKernel<SimdOps>(_X1 + i, _Y1 + i, _X2 + i, _Y2 + i, _Angle + i);
+        }
+        for (; i < _Count; i++)
+        {
+            CalcAngleKernel<ScalarOps>(_X1 + i, _Y1 + i, _X2 + i, _Y2 + i, _Angle + i);
+        }
+    }
+
+}    // namespace LM
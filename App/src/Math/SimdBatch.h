@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+namespace LM
+{
+
+    // Batched versions of LineCircleIntersection and CalcAngle. Inputs are arrays of _Count values (structure of
+    // arrays), any _Count is allowed. The instruction set is selected at compile time: AVX2 (8 lanes) when the
+    // compiler targets it (AVX2 option in CMake), SSE (4 lanes) on x86-64 and scalar code otherwise.
+
+    size_t GetSimdWidth();
+    const char* GetSimdName();
+
+    // acos approximation (Abramowitz and Stegun 4.4.46), absolute error is below 2e-8 rad before float rounding.
+    // Returns NaN outside of [-1, 1] like std::acos
+    float FastAcos(float _X);
+
+    // Same as LineCircleIntersection for lines (_X1, _Y1) - (_X2, _Y2), the square root is computed once per line
+    void LineCircleIntersectionBatch(float _Radius, const float* _X1, const float* _Y1, const float* _X2,
+                                     const float* _Y2, float* _X, float* _Y, size_t _Count);
+
+    // Same as CalcAngle for vectors (_X1, _Y1) and (_X2, _Y2), in degrees, uses FastAcos
+    void CalcAngleBatch(const float* _X1, const float* _Y1, const float* _X2, const float* _Y2, float* _Angle,
+                        size_t _Count);
+
+}    // namespace LM
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+    #define LM_SIMD_AVX2
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #define LM_SIMD_SSE
+    #include <emmintrin.h>
+#endif
+
+namespace LM
+{
+
+    // Lane operations for kernels written once as a template over Ops: ScalarOps processes one value, SimdOps as many
+    // as the instruction set selected at compile time (see SimdBatch.h). Used by SimdBatch and SoftwareRasterizer
+    struct ScalarOps
+    {
+        typedef float Float;
+        typedef bool Mask;
+
+        static constexpr size_t kWidth = 1;
+
+        static Float Load(const float* _Ptr) { return *_Ptr; }
+        static void Store(float* _Ptr, Float _Value) { *_Ptr = _Value; }
+        static Float Set(float _Value) { return _Value; }
+
+        static Float Add(Float _A, Float _B) { return _A + _B; }
+        static Float Sub(Float _A, Float _B) { return _A - _B; }
+        static Float Mul(Float _A, Float _B) { return _A * _B; }
+        static Float Div(Float _A, Float _B) { return _A / _B; }
+        static Float MulAdd(Float _A, Float _B, Float _C) { return _A * _B + _C; }
+        static Float Sqrt(Float _A) { return std::sqrt(_A); }
+        static Float Max(Float _A, Float _B) { return _A > _B ? _A : _B; }
+        static Float Abs(Float _A) { return std::fabs(_A); }
+
+        static Mask Less(Float _A, Float _B) { return _A < _B; }
+        static Mask LessEqual(Float _A, Float _B) { return _A <= _B; }
+        static Float Select(Mask _Mask, Float _A, Float _B) { return _Mask ? _A : _B; }
+
+        static Mask And(Mask _A, Mask _B) { return _A && _B; }
+        // Bit i is set when lane i of the mask is true
+        static uint32_t MoveMask(Mask _Mask) { return _Mask ? 1u : 0u; }
+    };
+
+#if defined(LM_SIMD_AVX2)
+    struct SimdOps
+    {
+        typedef __m256 Float;
+        typedef __m256 Mask;
+
+        static constexpr size_t kWidth = 8;
+        static constexpr const char* kName = "AVX2";
+
+        static Float Load(const float* _Ptr) { return _mm256_loadu_ps(_Ptr); }
+        static void Store(float* _Ptr, Float _Value) { _mm256_storeu_ps(_Ptr, _Value); }
+        static Float Set(float _Value) { return _mm256_set1_ps(_Value); }
+
+        static Float Add(Float _A, Float _B) { return _mm256_add_ps(_A, _B); }
+        static Float Sub(Float _A, Float _B) { return _mm256_sub_ps(_A, _B); }
+        static Float Mul(Float _A, Float _B) { return _mm256_mul_ps(_A, _B); }
+        static Float Div(Float _A, Float _B) { return _mm256_div_ps(_A, _B); }
+    #if defined(__FMA__)
+        static Float MulAdd(Float _A, Float _B, Float _C) { return _mm256_fmadd_ps(_A, _B, _C); }
+    #else
+        static Float MulAdd(Float _A, Float _B, Float _C) { return _mm256_add_ps(_mm256_mul_ps(_A, _B), _C); }
+    #endif
+        static Float Sqrt(Float _A) { return _mm256_sqrt_ps(_A); }
+        static Float Max(Float _A, Float _B) { return _mm256_max_ps(_A, _B); }
+        static Float Abs(Float _A) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _A); }
+
+        static Mask Less(Float _A, Float _B) { return _mm256_cmp_ps(_A, _B, _CMP_LT_OQ); }
+        static Mask LessEqual(Float _A, Float _B) { return _mm256_cmp_ps(_A, _B, _CMP_LE_OQ); }
+        static Float Select(Mask _Mask, Float _A, Float _B) { return _mm256_blendv_ps(_B, _A, _Mask); }
+
+        static Mask And(Mask _A, Mask _B) { return _mm256_and_ps(_A, _B); }
+        static uint32_t MoveMask(Mask _Mask) { return uint32_t(_mm256_movemask_ps(_Mask)); }
+    };
+#elif defined(LM_SIMD_SSE)
+    struct SimdOps
+    {
+        typedef __m128 Float;
+        typedef __m128 Mask;
+
+        static constexpr size_t kWidth = 4;
+        static constexpr const char* kName = "SSE2";
+
+        static Float Load(const float* _Ptr) { return _mm_loadu_ps(_Ptr); }
+        static void Store(float* _Ptr, Float _Value) { _mm_storeu_ps(_Ptr, _Value); }
+        static Float Set(float _Value) { return _mm_set1_ps(_Value); }
+
+        static Float Add(Float _A, Float _B) { return _mm_add_ps(_A, _B); }
+        static Float Sub(Float _A, Float _B) { return _mm_sub_ps(_A, _B); }
+        static Float Mul(Float _A, Float _B) { return _mm_mul_ps(_A, _B); }
+        static Float Div(Float _A, Float _B) { return _mm_div_ps(_A, _B); }
+        static Float MulAdd(Float _A, Float _B, Float _C) { return _mm_add_ps(_mm_mul_ps(_A, _B), _C); }
+        static Float Sqrt(Float _A) { return _mm_sqrt_ps(_A); }
+        static Float Max(Float _A, Float _B) { return _mm_max_ps(_A, _B); }
+        static Float Abs(Float _A) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), _A); }
+
+        static Mask Less(Float _A, Float _B) { return _mm_cmplt_ps(_A, _B); }
+        static Mask LessEqual(Float _A, Float _B) { return _mm_cmple_ps(_A, _B); }
+        static Float Select(Mask _Mask, Float _A, Float _B)
+        {
+            return _mm_or_ps(_mm_and_ps(_Mask, _A), _mm_andnot_ps(_Mask, _B));
+        }
+
+        static Mask And(Mask _A, Mask _B) { return _mm_and_ps(_A, _B); }
+        static uint32_t MoveMask(Mask _Mask) { return uint32_t(_mm_movemask_ps(_Mask)); }
+    };
+#else
+    struct SimdOps : ScalarOps
+    {
+        static constexpr const char* kName = "Scalar";
+    };
+#endif
+
+}    // namespace LM
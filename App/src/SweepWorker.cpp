@@ -0,0 +1,678 @@
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Engine/Buffers/PixelReadback.h"
+#include "Engine/Core/HeadlessContext.h"
+#include "Engine/Textures/ImageWriter.h"
+#include "Engine/Utils/ConsoleLog.h"
+
+#include "Calculations/DexelSimulation.h"
+#include "Calculations/SweepFiles.h"
+#include "Calculations/SweepRunner.h"
+#include "Graphics/CrossSectionRenderer.h"
+#include "Math/Angle.h"
+#include "Math/Intersections.h"
+#include "Math/SimdBatch.h"
+
+namespace LM
+{
+
+    static void PrintUsage()
+    {
+        std::cout << "Usage:\n"
+                  << "  SweepWorker run <job.json> <shard> <shards_count> <out_dir> [--top K] [--single-thread]\n"
+                  << "                  [--checkpoint <file>] [--checkpoint-interval <seconds>] [--candidates N]\n"
+                  << "  SweepWorker merge <dir> <shards_count> [--top K]\n"
+                  << "  SweepWorker render <result.json> <out_dir> [--top K] [--size <pixels>] [--samples <msaa>]\n"
+                  << "                     [--envelope] [--cpu]\n"
+                  << "  SweepWorker simulate <result.json> [--top K] [--rings N] [--sectors N]\n"
+                  << "  SweepWorker simd-report [count]\n";
+    }
+
+    static bool ParseUInt(const char* _Str, uint64_t* _Value)
+    {
+        char* end = nullptr;
+        unsigned long long value = std::strtoull(_Str, &end, 10);
+        if (end == _Str || *end != '\0')
+        {
+            LOGE("Bad number: ", _Str);
+            return false;
+        }
+        *_Value = value;
+        return true;
+    }
+
+    struct WorkerOptions
+    {
+        uint64_t TopCount = kSweepDefaultTopCount;
+        bool Parallel = true;
+        // Candidates of the whole sweep kept for the plots, every shard of a job takes its share of them, so all
+        // shards must be run with the same limit
+        uint64_t CandidatesLimit = 0;
+
+        // Progress is saved to the checkpoint file and continued from it on the next run of the same shard with the
+        // same --top and --candidates
+        std::string CheckpointPath;
+        uint64_t CheckpointInterval = kSweepCheckpointInterval.count();
+    };
+
+    static bool ParseOptions(int _Argc, char** _Argv, int _First, WorkerOptions* _Options)
+    {
+        for (int i = _First; i < _Argc; i++)
+        {
+            if (std::strcmp(_Argv[i], "--top") == 0 && i + 1 < _Argc)
+            {
+                if (!ParseUInt(_Argv[++i], &_Options->TopCount) || _Options->TopCount == 0)
+                {
+                    return false;
+                }
+            }
+            else if (std::strcmp(_Argv[i], "--checkpoint") == 0 && i + 1 < _Argc)
+            {
+                _Options->CheckpointPath = _Argv[++i];
+            }
+            else if (std::strcmp(_Argv[i], "--checkpoint-interval") == 0 && i + 1 < _Argc)
+            {
+                if (!ParseUInt(_Argv[++i], &_Options->CheckpointInterval))
+                {
+                    return false;
+                }
+            }
+            else if (std::strcmp(_Argv[i], "--candidates") == 0 && i + 1 < _Argc)
+            {
+                if (!ParseUInt(_Argv[++i], &_Options->CandidatesLimit))
+                {
+                    return false;
+                }
+            }
+            else if (std::strcmp(_Argv[i], "--single-thread") == 0)
+            {
+                _Options->Parallel = false;
+            }
+            else
+            {
+                LOGE("Unknown option: ", _Argv[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static int RunShard(int _Argc, char** _Argv)
+    {
+        uint64_t shard = 0;
+        uint64_t shardsCount = 0;
+        WorkerOptions options;
+        if (_Argc < 6 || !ParseUInt(_Argv[3], &shard) || !ParseUInt(_Argv[4], &shardsCount) ||
+            !ParseOptions(_Argc, _Argv, 6, &options))
+        {
+            PrintUsage();
+            return 1;
+        }
+        if (shardsCount == 0 || shard >= shardsCount || shardsCount > UINT32_MAX)
+        {
+            LOGE("Shard must be in [0, shards_count)");
+            return 1;
+        }
+
+        SweepJob job;
+        if (!LoadSweepJob(_Argv[2], &job))
+        {
+            return 1;
+        }
+
+        SweepRunner runner(job, options.TopCount, options.CandidatesLimit);
+        uint64_t blockBegin = GetShardBlockBegin(runner.GetBlocksCount(), uint32_t(shard), uint32_t(shardsCount));
+        uint64_t blockEnd = GetShardBlockBegin(runner.GetBlocksCount(), uint32_t(shard + 1), uint32_t(shardsCount));
+
+        LOGI("Shard ", shard, " of ", shardsCount, ": blocks [", blockBegin, ", ", blockEnd, ") of ",
+             runner.GetBlocksCount());
+
+        auto startTime = std::chrono::system_clock::now();
+        SweepResult result;
+        if (options.CheckpointPath.empty())
+        {
+            result = runner.Run(blockBegin, blockEnd, options.Parallel);
+        }
+        else
+        {
+            SweepProgress progress;
+            if (!std::filesystem::exists(options.CheckpointPath) ||
+                !LoadSweepCheckpointFor(options.CheckpointPath, runner, blockBegin, blockEnd, &progress))
+            {
+                progress = runner.CreateProgress(blockBegin, blockEnd, options.Parallel, true);
+            }
+
+            SweepCheckpointWriter checkpointWriter(options.CheckpointPath, runner,
+                                                   std::chrono::seconds(options.CheckpointInterval));
+            result = runner.Run(progress, options.Parallel, [&checkpointWriter](const SweepProgress& _Progress) {
+                checkpointWriter.OnChunkCompleted(_Progress);
+            });
+        }
+        auto endTime = std::chrono::system_clock::now();
+
+        LOGI("Shard ", shard, " calculated: ", result.Meta.Calculated, ", bad: ", result.Meta.BadCalculations,
+             ", time: ", std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count() / 1000.0,
+             "s");
+
+        return SaveSweepShard(_Argv[5], uint32_t(shard), uint32_t(shardsCount), job, result) ? 0 : 1;
+    }
+
+    static int MergeShards(int _Argc, char** _Argv)
+    {
+        uint64_t shardsCount = 0;
+        WorkerOptions options;
+        if (_Argc < 4 || !ParseUInt(_Argv[3], &shardsCount) || !ParseOptions(_Argc, _Argv, 4, &options))
+        {
+            PrintUsage();
+            return 1;
+        }
+        if (shardsCount == 0 || shardsCount > UINT32_MAX)
+        {
+            LOGE("Bad shards count: ", shardsCount);
+            return 1;
+        }
+
+        SweepJob job;
+        SweepResult result;
+        if (!MergeSweepShards(_Argv[2], uint32_t(shardsCount), options.TopCount, &job, &result))
+        {
+            return 1;
+        }
+
+        if (!result.TopResults.empty())
+        {
+            const SweepCandidate& best = result.TopResults.front();
+            LOGI("Best delta: ", best.Delta, ", front angle: ", best.Result.FrontAngle,
+                 ", step angle: ", best.Result.StepAngle, ", diametr in: ", best.Result.DiametrIn);
+        }
+
+        return 0;
+    }
+
+    // Frames read back at the same time, the GPU renders the next ones while the CPU encodes the oldest
+    constexpr uint32_t kReadbackSlots = 3;
+
+    struct RenderOptions
+    {
+        uint64_t TopCount = kSweepDefaultTopCount;
+        uint64_t Size = 1024;
+        uint64_t Samples = 4;
+        // Draws the groove of the whole rotation, it is calculated on the CPU for every candidate
+        bool DrawEnvelope = false;
+        // SoftwareRasterizer instead of OpenGL
+        bool UseCPU = false;
+    };
+
+    static bool ParseRenderOptions(int _Argc, char** _Argv, int _First, RenderOptions* _Options)
+    {
+        for (int i = _First; i < _Argc; i++)
+        {
+            if (std::strcmp(_Argv[i], "--top") == 0 && i + 1 < _Argc)
+            {
+                if (!ParseUInt(_Argv[++i], &_Options->TopCount) || _Options->TopCount == 0)
+                {
+                    return false;
+                }
+            }
+            else if (std::strcmp(_Argv[i], "--size") == 0 && i + 1 < _Argc)
+            {
+                if (!ParseUInt(_Argv[++i], &_Options->Size) || _Options->Size == 0 || _Options->Size > 16384)
+                {
+                    return false;
+                }
+            }
+            else if (std::strcmp(_Argv[i], "--samples") == 0 && i + 1 < _Argc)
+            {
+                if (!ParseUInt(_Argv[++i], &_Options->Samples) || _Options->Samples == 0 || _Options->Samples > 32)
+                {
+                    return false;
+                }
+            }
+            else if (std::strcmp(_Argv[i], "--envelope") == 0)
+            {
+                _Options->DrawEnvelope = true;
+            }
+            else if (std::strcmp(_Argv[i], "--cpu") == 0)
+            {
+                _Options->UseCPU = true;
+            }
+            else
+            {
+                LOGE("Unknown option: ", _Argv[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static std::filesystem::path GetCandidateImagePath(const std::filesystem::path& _Dir, uint64_t _Rank)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "candidate_%04llu.png", (unsigned long long)_Rank);
+        return _Dir / name;
+    }
+
+    // PNGs are encoded on other threads while the next images are rendered, at most one per hardware thread
+    class PngEncoder
+    {
+    public:
+        void Encode(const std::filesystem::path& _Path, uint32_t _Width, uint32_t _Height,
+                    std::vector<uint8_t>&& _Pixels, bool _BottomUp)
+        {
+            if (m_Encodings.size() >= m_MaxEncodings)
+            {
+                WaitOldest();
+            }
+
+            m_Encodings.push_back(
+                std::async(std::launch::async, [_Path, _Width, _Height, pixels = std::move(_Pixels), _BottomUp]() {
+                    return SavePng(_Path, _Width, _Height, pixels.data(), _BottomUp);
+                }));
+        }
+
+        // Waits for all encodings, returns the number of failed ones
+        size_t Finish()
+        {
+            while (!m_Encodings.empty())
+            {
+                WaitOldest();
+            }
+            return m_FailedCount;
+        }
+
+    protected:
+        void WaitOldest()
+        {
+            m_FailedCount += !m_Encodings.front().get();
+            m_Encodings.pop_front();
+        }
+
+    protected:
+        const size_t m_MaxEncodings = std::max(std::thread::hardware_concurrency(), 1u);
+        std::deque<std::future<bool>> m_Encodings;
+        size_t m_FailedCount = 0;
+    };
+
+    static WheelEnvelopeMesh CalculateCandidateEnvelope(const BestResult& _Candidate, const ToolParams& _Tool)
+    {
+        return CalculateWheelEnvelope(
+            { { _Candidate.Diametr, _Candidate.Width, _Candidate.R1, _Candidate.R2, _Candidate.Angle },
+              { _Candidate.OffsetToolCenter, _Candidate.OffsetToolAxis, _Candidate.RotationAngle },
+              _Tool });
+    }
+
+    // OpenGL without a window. Readback and encoding overlap with rendering: pixel buffers are mapped a few frames
+    // later and PNGs are encoded on other threads
+    static bool RenderResultsGL(const SweepJob& _Job, const std::vector<SweepCandidate>& _Candidates,
+                                const RenderOptions& _Options, float _CameraZoom, const std::filesystem::path& _OutDir,
+                                PngEncoder& _Encoder)
+    {
+        Scope<HeadlessContext> context = HeadlessContext::Create();
+        if (!context)
+        {
+            LOGE("Can't create headless OpenGL context, use --cpu to render without OpenGL");
+            return false;
+        }
+        LOGI("Rendering on ", context->GetRendererName());
+
+        CrossSectionRenderer renderer;
+        renderer.SetCameraZoom(_CameraZoom);
+
+        Ref<FrameBuffer> frameBuffer = FrameBuffer::Create({ uint32_t(_Options.Size),
+                                                             uint32_t(_Options.Size),
+                                                             { FrameBufferColorMASK::NONE },
+                                                             FrameBufferMASK::DEPTH,
+                                                             uint32_t(_Options.Samples) });
+
+        Ref<PixelReadback> readback =
+            PixelReadback::Create(kReadbackSlots, [&_Encoder, &_OutDir](ReadbackImage&& _Image) {
+                _Encoder.Encode(GetCandidateImagePath(_OutDir, _Image.Tag), _Image.Width, _Image.Height,
+                                std::move(_Image.Pixels), true);
+            });
+
+        for (size_t i = 0; i < _Candidates.size(); i++)
+        {
+            const BestResult& candidate = _Candidates[i].Result;
+
+            WheelEnvelopeMesh envelope;
+            if (_Options.DrawEnvelope)
+            {
+                envelope = CalculateCandidateEnvelope(candidate, _Job.Tool);
+            }
+
+            renderer.Render(frameBuffer, _Job.Tool, candidate, _Options.DrawEnvelope ? &envelope : nullptr);
+            readback->Read(frameBuffer, i);
+        }
+        readback->Flush();
+
+        return true;
+    }
+
+    static bool RenderResultsCPU(const SweepJob& _Job, const std::vector<SweepCandidate>& _Candidates,
+                                 const RenderOptions& _Options, float _CameraZoom,
+                                 const std::filesystem::path& _OutDir, PngEncoder& _Encoder)
+    {
+        LOGI("Rendering on the CPU, SIMD: ", GetSimdName());
+
+        CrossSectionRasterizer rasterizer(uint32_t(_Options.Size), uint32_t(_Options.Samples));
+        rasterizer.SetCameraZoom(_CameraZoom);
+
+        RasterImage image;
+        for (size_t i = 0; i < _Candidates.size(); i++)
+        {
+            const BestResult& candidate = _Candidates[i].Result;
+
+            WheelEnvelopeMesh envelope;
+            if (_Options.DrawEnvelope)
+            {
+                envelope = CalculateCandidateEnvelope(candidate, _Job.Tool);
+            }
+
+            rasterizer.Render(image, _Job.Tool, candidate, _Options.DrawEnvelope ? &envelope : nullptr);
+            _Encoder.Encode(GetCandidateImagePath(_OutDir, i), image.Width, image.Height, std::move(image.Pixels),
+                            false);
+        }
+
+        return true;
+    }
+
+    // Renders the top results into PNG files without a window
+    static int RenderResults(int _Argc, char** _Argv)
+    {
+        RenderOptions options;
+        if (_Argc < 4 || !ParseRenderOptions(_Argc, _Argv, 4, &options))
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        SweepJob job;
+        SweepResult result;
+        if (!LoadSweepResult(_Argv[2], &job, &result))
+        {
+            return 1;
+        }
+
+        std::filesystem::path outDir = _Argv[3];
+        std::error_code error;
+        std::filesystem::create_directories(outDir, error);
+        if (error)
+        {
+            LOGE("Can't create directory ", outDir.string(), ": ", error.message());
+            return 1;
+        }
+
+        result.TopResults.resize(std::min(size_t(options.TopCount), result.TopResults.size()));
+        const std::vector<SweepCandidate>& candidates = result.TopResults;
+        if (candidates.empty())
+        {
+            LOGW("Result has no candidates to render");
+            return 0;
+        }
+
+        // All images have the same scale, so they can be compared side by side
+        float cameraZoom = 0.0f;
+        for (const SweepCandidate& candidate : candidates)
+        {
+            cameraZoom = glm::max(cameraZoom, CrossSectionRenderer::GetCameraZoom(candidate.Result, job.Tool));
+        }
+
+        LOGI("Rendering ", candidates.size(), " candidates ", options.Size, "x", options.Size, ", samples: ",
+             options.Samples);
+
+        auto startTime = std::chrono::steady_clock::now();
+        PngEncoder encoder;
+        bool isRendered = options.UseCPU
+                              ? RenderResultsCPU(job, candidates, options, cameraZoom, outDir, encoder)
+                              : RenderResultsGL(job, candidates, options, cameraZoom, outDir, encoder);
+        size_t failedCount = encoder.Finish();
+        auto endTime = std::chrono::steady_clock::now();
+
+        if (!isRendered)
+        {
+            return 1;
+        }
+
+        double seconds = std::chrono::duration<double>(endTime - startTime).count();
+        LOGI("Rendered ", candidates.size() - failedCount, " of ", candidates.size(), " images to ", outDir.string(),
+             " in ", seconds, "s (", seconds * 1000.0 / double(candidates.size()), " ms per image)");
+
+        return failedCount == 0 ? 0 : 1;
+    }
+
+    struct ErrorStats
+    {
+        double MaxError = 0.0;
+        uint64_t NaNMismatches = 0;
+
+        void Add(float _Value, float _Reference)
+        {
+            if (std::isnan(_Value) || std::isnan(_Reference))
+            {
+                NaNMismatches += std::isnan(_Value) != std::isnan(_Reference);
+                return;
+            }
+            MaxError = glm::max(MaxError, std::abs(double(_Value) - double(_Reference)));
+        }
+    };
+
+    template <typename Func>
+    static double MeasureSeconds(Func&& _Func)
+    {
+        auto startTime = std::chrono::steady_clock::now();
+        _Func();
+        auto endTime = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(endTime - startTime).count();
+    }
+
+    struct SimulateOptions
+    {
+        uint64_t TopCount = 10;
+        uint64_t RingsCount = DexelSimulationParams().RingsCount;
+        uint64_t SectorsCount = DexelSimulationParams().SectorsCount;
+    };
+
+    static bool ParseSimulateOptions(int _Argc, char** _Argv, int _First, SimulateOptions* _Options)
+    {
+        for (int i = _First; i < _Argc; i++)
+        {
+            if (std::strcmp(_Argv[i], "--top") == 0 && i + 1 < _Argc)
+            {
+                if (!ParseUInt(_Argv[++i], &_Options->TopCount) || _Options->TopCount == 0)
+                {
+                    return false;
+                }
+            }
+            else if (std::strcmp(_Argv[i], "--rings") == 0 && i + 1 < _Argc)
+            {
+                if (!ParseUInt(_Argv[++i], &_Options->RingsCount) || _Options->RingsCount == 0 ||
+                    _Options->RingsCount > 4096)
+                {
+                    return false;
+                }
+            }
+            else if (std::strcmp(_Argv[i], "--sectors") == 0 && i + 1 < _Argc)
+            {
+                if (!ParseUInt(_Argv[++i], &_Options->SectorsCount) || _Options->SectorsCount < 8 ||
+                    _Options->SectorsCount > 65536)
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                LOGE("Unknown option: ", _Argv[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Checks the top results with the 3D material removal: params of the simulated flute in the middle of the tool
+    // next to the ones from the sweep
+    static int SimulateResults(int _Argc, char** _Argv)
+    {
+        SimulateOptions options;
+        if (_Argc < 3 || !ParseSimulateOptions(_Argc, _Argv, 3, &options))
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        SweepJob job;
+        SweepResult result;
+        if (!LoadSweepResult(_Argv[2], &job, &result))
+        {
+            return 1;
+        }
+
+        size_t count = std::min(size_t(options.TopCount), result.TopResults.size());
+        LOGI("Simulating ", count, " candidates, rings: ", options.RingsCount, ", sectors: ", options.SectorsCount);
+
+        size_t failedCount = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            const BestResult& candidate = result.TopResults[i].Result;
+
+            DexelSimulationParams params = MakeDexelSimulationParams(job, candidate);
+            params.RingsCount = uint32_t(options.RingsCount);
+            params.SectorsCount = uint32_t(options.SectorsCount);
+
+            DexelSimulation simulation;
+            ParamsToFind simulated;
+            bool isSimulated = false;
+            double seconds = MeasureSeconds([&]() {
+                isSimulated = simulation.Run(params) && simulation.CalculateParams(0.0f, &simulated);
+            });
+            if (!isSimulated)
+            {
+                LOGW("#", i, ": can't simulate");
+                failedCount++;
+                continue;
+            }
+
+            LOGI("#", i, " front angle: ", candidate.FrontAngle, " / ", simulated.FrontAngle,
+                 ", step angle: ", candidate.StepAngle, " / ", simulated.StepAngle,
+                 ", inner diametr: ", candidate.DiametrIn, " / ", simulated.DiametrIn,
+                 " (sweep / 3D), removed volume: ", simulation.GetRemovedVolume(), ", poses: ",
+                 simulation.GetPosesCount(), ", ", seconds, "s");
+        }
+
+        return failedCount == 0 ? 0 : 1;
+    }
+
+    // Compares batched versions with the scalar ones on random lines around the tool
+    static int ReportSimdAccuracy(int _Argc, char** _Argv)
+    {
+        uint64_t count = 1 << 20;
+        if (_Argc >= 3 && !ParseUInt(_Argv[2], &count))
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        const float radius = 50.0f;
+
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> distribution(-2.0f * radius, 2.0f * radius);
+
+        std::vector<float> x1(count), y1(count), x2(count), y2(count);
+        for (uint64_t i = 0; i < count; i++)
+        {
+            x1[i] = distribution(generator);
+            y1[i] = distribution(generator);
+            x2[i] = distribution(generator);
+            y2[i] = distribution(generator);
+        }
+
+        std::vector<float> x(count), y(count), angle(count);
+        std::vector<float> refX(count), refY(count), refAngle(count);
+
+        double scalarIntersectionTime = MeasureSeconds([&]() {
+            for (uint64_t i = 0; i < count; i++)
+            {
+                glm::vec2 point = LineCircleIntersection(radius, { x1[i], y1[i] }, { x2[i], y2[i] });
+                refX[i] = point.x;
+                refY[i] = point.y;
+            }
+        });
+        double batchIntersectionTime = MeasureSeconds([&]() {
+            LineCircleIntersectionBatch(radius, x1.data(), y1.data(), x2.data(), y2.data(), x.data(), y.data(), count);
+        });
+
+        double scalarAngleTime = MeasureSeconds([&]() {
+            for (uint64_t i = 0; i < count; i++)
+            {
+                refAngle[i] = CalcAngle({ x1[i], y1[i], 0.0f, 1.0f }, { x2[i], y2[i], 0.0f, 1.0f });
+            }
+        });
+        double batchAngleTime = MeasureSeconds(
+            [&]() { CalcAngleBatch(x1.data(), y1.data(), x2.data(), y2.data(), angle.data(), count); });
+
+        ErrorStats intersectionStats;
+        ErrorStats angleStats;
+        for (uint64_t i = 0; i < count; i++)
+        {
+            intersectionStats.Add(x[i], refX[i]);
+            intersectionStats.Add(y[i], refY[i]);
+            angleStats.Add(angle[i], refAngle[i]);
+        }
+
+        ErrorStats acosStats;
+        const int acosSteps = 2000000;
+        for (int i = 0; i <= acosSteps; i++)
+        {
+            float value = -1.0f + 2.0f * float(i) / float(acosSteps);
+            acosStats.Add(FastAcos(value), float(std::acos(double(value))));
+        }
+
+        LOGI("SIMD: ", GetSimdName(), ", width: ", GetSimdWidth(), ", pairs: ", count);
+        LOGI("LineCircleIntersection max abs error: ", intersectionStats.MaxError,
+             ", NaN mismatches: ", intersectionStats.NaNMismatches, ", scalar: ", scalarIntersectionTime,
+             "s, batch: ", batchIntersectionTime, "s");
+        LOGI("CalcAngle max abs error (deg): ", angleStats.MaxError, ", NaN mismatches: ", angleStats.NaNMismatches,
+             ", scalar: ", scalarAngleTime, "s, batch: ", batchAngleTime, "s");
+        LOGI("FastAcos max abs error (rad): ", acosStats.MaxError, ", NaN mismatches: ", acosStats.NaNMismatches);
+
+        return 0;
+    }
+
+}    // namespace LM
+
+int main(int argc, char** argv)
+{
+    LOG_INIT();
+
+    if (argc >= 2 && std::strcmp(argv[1], "run") == 0)
+    {
+        return LM::RunShard(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "merge") == 0)
+    {
+        return LM::MergeShards(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "render") == 0)
+    {
+        return LM::RenderResults(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "simulate") == 0)
+    {
+        return LM::SimulateResults(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "simd-report") == 0)
+    {
+        return LM::ReportSimdAccuracy(argc, argv);
+    }
+
+    LM::PrintUsage();
+    return 1;
+}
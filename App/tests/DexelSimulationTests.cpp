@@ -0,0 +1,37 @@
+#include "TestSweepJob.h"
+
+#include "Calculations/DexelSimulation.h"
+
+using namespace LM;
+
+// Top results of the test sweep are simulated with the tool of the job. The 2D section of the sweep and the 3D
+// simulation agree on the inner diameter, the step angle of the helix differs from the section one
+int main(int argc, char** argv)
+{
+    LOG_INIT();
+
+    const SweepJob job = CreateTestSweepJob();
+    SweepResult result = SweepRunner(job, 3).Run();
+    TEST_CHECK(!result.TopResults.empty());
+
+    for (const SweepCandidate& candidate : result.TopResults)
+    {
+        DexelSimulationParams params = MakeDexelSimulationParams(job, candidate.Result);
+        TEST_CHECK(params.Tool == job.Tool);
+        TEST_CHECK(params.Profile.OffsetToolCenter == candidate.Result.OffsetToolCenter);
+        TEST_CHECK(params.Profile.RotationAngle == candidate.Result.RotationAngle);
+        params.RingsCount = 64;
+        params.SectorsCount = 1024;
+
+        DexelSimulation simulation;
+        ParamsToFind simulated;
+        TEST_CHECK(simulation.Run(params) && simulation.CalculateParams(0.0f, &simulated));
+
+        LOGI("Diametr in: ", candidate.Result.DiametrIn, " / ", simulated.DiametrIn, ", step angle: ",
+             candidate.Result.StepAngle, " / ", simulated.StepAngle, " (sweep / 3D)");
+        TEST_CHECK(simulated.StepAngle >= 0.0f && simulated.StepAngle <= 180.0f);
+        TEST_CHECK(glm::abs(simulated.DiametrIn - candidate.Result.DiametrIn) < 1.0f);
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include "TestSweepJob.h"
+
+#include "Calculations/Refinement.h"
+
+using namespace LM;
+
+// Refinement of the top results of the test sweep. Refined results stay in the bounds of the job and their deltas are
+// calculated with its tool and targets
+int main(int argc, char** argv)
+{
+    LOG_INIT();
+
+    const SweepJob job = CreateTestSweepJob();
+    SweepResult result = SweepRunner(job, 5).Run();
+    TEST_CHECK(!result.TopResults.empty());
+
+    RefinementParams params = MakeRefinementParams(job);
+    TEST_CHECK(params.Tool == job.Tool);
+    TEST_CHECK(params.ToFind == job.ToFind);
+
+    RefinementResult refinement = RefineTopResults(params, result.TopResults, result.TopResults.size());
+    LOGI("Refinement: ", refinement.Improved, " of ", refinement.Refined, " results improved, best delta: ",
+         result.TopResults.front().Delta, " / ", refinement.TopResults.front().Delta, " (sweep / refined)");
+    TEST_CHECK(refinement.TopResults.size() == result.TopResults.size());
+    TEST_CHECK(refinement.TopResults.front().Delta <= result.TopResults.front().Delta);
+
+    const GrindingWheelCalcParams& min = job.Params.Min;
+    const GrindingWheelCalcParams& max = job.Params.Max;
+    for (const SweepCandidate& candidate : refinement.TopResults)
+    {
+        const BestResult& refined = candidate.Result;
+        TEST_CHECK(refined.Diametr == min.Diametr && refined.Width == min.Width && refined.R1 == min.R1 &&
+                   refined.R2 == min.R2 && refined.Angle == min.Angle && refined.OffsetToolAxis == min.OffsetToolAxis);
+        TEST_CHECK(refined.OffsetToolCenter >= min.OffsetToolCenter &&
+                   refined.OffsetToolCenter <= max.OffsetToolCenter);
+        TEST_CHECK(refined.RotationAngle >= min.RotationAngle && refined.RotationAngle <= max.RotationAngle);
+
+        GrindingWheelParams wheel = { refined.Diametr, refined.Width, refined.R1, refined.R2, refined.Angle };
+        ParamsToFind calculated;
+        TEST_CHECK(CalculateParamsSingle(CalculateGrindingWheelSizes(wheel), wheel,
+                                         { refined.OffsetToolCenter, refined.OffsetToolAxis, refined.RotationAngle },
+                                         job.Tool, &calculated));
+        TEST_CHECK(glm::abs(CalculateParamsDelta(calculated, job.ToFind) - candidate.Delta) < 1e-3f);
+    }
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Calculations/SweepRunner.h"
+#include "Engine/Utils/ConsoleLog.h"
+
+#include <glm/glm.hpp>
+
+// Fails the test with the checked expression in the log
+#define TEST_CHECK(x)                                                                                                  \
+    {                                                                                                                  \
+        if (!(x))                                                                                                      \
+        {                                                                                                              \
+            LOGE("Check failed: ", #x, " (", __FILE__, ":", __LINE__, ")");                                            \
+            return 1;                                                                                                  \
+        }                                                                                                              \
+    }
+
+namespace LM
+{
+
+    // Small grid sweep of the reference wheel profile. Its tool and targets differ from the editor defaults, so a
+    // calculation which takes them from anywhere but the job gives other values
+    inline SweepJob CreateTestSweepJob()
+    {
+        SweepJob job;
+        job.Tool = { 100.0f, 600.0f, 60.0f };
+        job.ToFind = { 5.0f, 45.0f, 70.0f };
+
+        const float axisOffset = glm::sin(glm::radians(job.ToFind.FrontAngle)) * (job.Tool.Diametr / 2.0f);
+        job.Params.Min = { 200.0f, 85.0f, 2.0f, 1.0f, 15.0f, 30.0f, axisOffset, 45.0f };
+        job.Params.Max = { 200.0f, 85.0f, 2.0f, 1.0f, 15.0f, 40.0f, axisOffset, 65.0f };
+        job.Params.Steps = { 0, 0, 0, 0, 0, 10, 0, 20 };
+
+        return job;
+    }
+
+}    // namespace LM
@@ -0,0 +1,41 @@
+#include "TestSweepJob.h"
+
+#include "Calculations/ToleranceAnalysis.h"
+
+using namespace LM;
+
+// Analysis of the best result of the test sweep. Without tolerances every sample is the nominal, which must be the
+// result the sweep found with the tool of the job
+int main(int argc, char** argv)
+{
+    LOG_INIT();
+
+    const SweepJob job = CreateTestSweepJob();
+    SweepResult result = SweepRunner(job, 1).Run();
+    TEST_CHECK(!result.TopResults.empty());
+    const BestResult& best = result.TopResults.front().Result;
+
+    ToleranceAnalysisParams tolerances;
+    tolerances.SamplesCount = 1000;
+    ToleranceAnalysisParams params = MakeToleranceAnalysisParams(tolerances, job, best);
+    TEST_CHECK(params.Tool == job.Tool);
+    TEST_CHECK(params.ToFind == job.ToFind);
+
+    ToleranceAnalysisResult analysis = RunToleranceAnalysis(params);
+    LOGI("Step angle: ", best.StepAngle, " / ", analysis.StepAngle.Nominal, " (sweep / nominal)");
+    TEST_CHECK(analysis.HasNominal);
+    TEST_CHECK(analysis.ToFind == job.ToFind);
+    TEST_CHECK(analysis.Calculated == params.SamplesCount && analysis.BadCalculations == 0);
+    TEST_CHECK(glm::abs(analysis.FrontAngle.Nominal - best.FrontAngle) < 1e-3f);
+    TEST_CHECK(glm::abs(analysis.StepAngle.Nominal - best.StepAngle) < 1e-3f);
+    TEST_CHECK(glm::abs(analysis.DiametrIn.Nominal - best.DiametrIn) < 1e-3f);
+    TEST_CHECK(glm::abs(analysis.StepAngle.Mean - best.StepAngle) < 1e-3f && analysis.StepAngle.StdDev < 1e-3f);
+
+    // Tool angle tolerance moves the step angle of the helix
+    params.Inputs[uint32_t(ToleranceInput::ToolAngle)].Tolerance = 1.0f;
+    analysis = RunToleranceAnalysis(params);
+    TEST_CHECK(analysis.StepAngle.StdDev > 0.0f);
+    TEST_CHECK(analysis.StepAngle.Min <= best.StepAngle && best.StepAngle <= analysis.StepAngle.Max);
+
+    return 0;
+}
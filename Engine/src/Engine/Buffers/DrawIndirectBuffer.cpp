@@ -0,0 +1,18 @@
+#include "DrawIndirectBuffer.h"
+
+#include "Engine/Core/Assert.h"
+
+#include "Platform/OpenGL4/Buffers/OGL4DrawIndirectBuffer.h"
+
+namespace LM
+{
+
+    Ref<DrawIndirectBuffer> DrawIndirectBuffer::Create(const DrawElementsIndirectCommand* _Commands, uint32_t _Count)
+    {
+        return CreateRef<OGL4DrawIndirectBuffer>(_Commands, _Count);
+
+        CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
+}    // namespace LM
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Engine/Core/Base.h"
+
+namespace LM
+{
+
+    // One command of glMultiDrawElementsIndirect, the layout is defined by OpenGL
+    struct DrawElementsIndirectCommand
+    {
+        uint32_t Count;
+        uint32_t InstanceCount;
+        uint32_t FirstIndex;
+        int32_t BaseVertex;
+        uint32_t BaseInstance;
+    };
+
+    class DrawIndirectBuffer
+    {
+    public:
+        virtual ~DrawIndirectBuffer() = default;
+
+        virtual void Bind() const = 0;
+        virtual void Unbind() const = 0;
+
+        // Storage grows when _Count is bigger than the current capacity
+        virtual void SetCommands(const DrawElementsIndirectCommand* _Commands, uint32_t _Count) = 0;
+
+        virtual uint32_t GetCount() const = 0;
+
+        static Ref<DrawIndirectBuffer> Create(const DrawElementsIndirectCommand* _Commands, uint32_t _Count);
+    };
+
+}    // namespace LM
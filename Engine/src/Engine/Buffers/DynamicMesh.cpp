@@ -0,0 +1,19 @@
+#include "DynamicMesh.h"
+
+#include "Engine/Core/Assert.h"
+
+#include "Platform/OpenGL4/Buffers/OGL4DynamicMesh.h"
+
+namespace LM
+{
+
+    Ref<DynamicMesh> DynamicMesh::Create(const BufferLayout& _Layout, uint32_t _VerticesCapacity,
+                                         uint32_t _IndicesCapacity)
+    {
+        return CreateRef<OGL4DynamicMesh>(_Layout, _VerticesCapacity, _IndicesCapacity);
+
+        CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
+}    // namespace LM
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+#include "BufferLayout.h"
+
+namespace LM
+{
+
+    // Indexed triangle mesh which is updated often (e.g. on every slider drag). Buffers are created once and keep
+    // their capacity, new data is written in place into the region the GPU doesn't read at the moment
+    class DynamicMesh
+    {
+    public:
+        virtual ~DynamicMesh() = default;
+
+        // _VerticesCount vertices of the layout stride and _IndicesCount indices into them. Storage grows only when
+        // the data doesn't fit in the capacity
+        virtual void SetData(const void* _Vertices, uint32_t _VerticesCount, const uint32_t* _Indices,
+                             uint32_t _IndicesCount) = 0;
+
+        virtual void Draw() const = 0;
+
+        virtual uint32_t GetVerticesCount() const = 0;
+        virtual uint32_t GetIndicesCount() const = 0;
+
+        virtual const BufferLayout& GetLayout() const = 0;
+
+        static Ref<DynamicMesh> Create(const BufferLayout& _Layout, uint32_t _VerticesCapacity,
+                                       uint32_t _IndicesCapacity);
+    };
+
+}    // namespace LM
@@ -41,6 +41,8 @@ namespace LM
         uint32_t Height = 128;
         std::vector<FrameBufferColorMASK::FrameBufferColorMASK> FBColorMask;
         FrameBufferMASK::FrameBufferMASK FBMask = FrameBufferMASK::NONE;
+        // MSAA samples, multisampled attachments are resolved into the color textures on Unbind()
+        uint32_t Samples = 1;
     };
 
     class FrameBuffer
@@ -63,6 +65,9 @@ namespace LM
 
         virtual void Resize(uint32_t _Width, uint32_t _Height) = 0;
 
+        virtual uint32_t GetSamples() const = 0;
+        virtual void SetSamples(uint32_t _Samples) = 0;
+
         virtual void BindColorTexture(uint32_t _Id, uint32_t _SlotId) = 0;
 
         static Ref<FrameBuffer> Create(const FrameBufferProps& _Props = FrameBufferProps());
@@ -0,0 +1,18 @@
+#include "PixelReadback.h"
+
+#include "Engine/Core/Assert.h"
+
+#include "Platform/OpenGL4/Buffers/OGL4PixelReadback.h"
+
+namespace LM
+{
+
+    Ref<PixelReadback> PixelReadback::Create(uint32_t _SlotsCount, const ImageCallbackFn& _OnImage)
+    {
+        return CreateRef<OGL4PixelReadback>(_SlotsCount, _OnImage);
+
+        CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
+}    // namespace LM
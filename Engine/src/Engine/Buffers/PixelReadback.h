@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Engine/Buffers/FrameBuffer.h"
+#include "Engine/Core/Base.h"
+
+namespace LM
+{
+
+    // RGBA8 pixels of the first color attachment, rows go from the bottom to the top like in OpenGL
+    struct ReadbackImage
+    {
+        uint64_t Tag = 0;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        std::vector<uint8_t> Pixels;
+    };
+
+    // Asynchronous framebuffer readback through a ring of pixel buffer objects. Read() only queues the copy on the
+    // GPU, the copy is mapped when its slot is needed again (or on Flush), so while the CPU processes image N the GPU
+    // renders and copies the next _SlotsCount - 1 images. Images come to the callback in the order of Read() calls
+    class PixelReadback
+    {
+    public:
+        using ImageCallbackFn = std::function<void(ReadbackImage&&)>;
+
+        virtual ~PixelReadback() = default;
+
+        // The framebuffer can be drawn again right after the call. When all slots are busy the oldest read is
+        // finished first
+        virtual void Read(const Ref<FrameBuffer>& _FrameBuffer, uint64_t _Tag) = 0;
+        // Finishes all queued reads
+        virtual void Flush() = 0;
+
+        virtual uint32_t GetSlotsCount() const = 0;
+
+        static Ref<PixelReadback> Create(uint32_t _SlotsCount, const ImageCallbackFn& _OnImage);
+    };
+
+}    // namespace LM
@@ -0,0 +1,26 @@
+#include "UniformBuffer.h"
+
+#include "Engine/Core/Assert.h"
+
+#include "Platform/OpenGL4/Buffers/OGL4UniformBuffer.h"
+
+namespace LM
+{
+
+    Ref<UniformBuffer> UniformBuffer::Create(uint32_t _Size)
+    {
+        return CreateRef<OGL4UniformBuffer>(_Size);
+
+        CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
+    Ref<UniformBuffer> UniformBuffer::Create(const void* _Data, uint32_t _Size)
+    {
+        return CreateRef<OGL4UniformBuffer>(_Data, _Size);
+
+        CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
+}    // namespace LM
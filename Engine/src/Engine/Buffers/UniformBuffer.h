@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Engine/Core/Base.h"
+
+namespace LM
+{
+
+    // Data of a "layout(std140, binding = _SlotId) uniform" block, shared by all shaders using the slot
+    class UniformBuffer
+    {
+    public:
+        virtual ~UniformBuffer() = default;
+
+        virtual void Bind(uint32_t _SlotId) const = 0;
+        virtual void Unbind() const = 0;
+
+        virtual void SetData(const void* _Data, uint32_t _Size) = 0;
+
+        static Ref<UniformBuffer> Create(uint32_t _Size);
+        static Ref<UniformBuffer> Create(const void* _Data, uint32_t _Size);
+    };
+
+}    // namespace LM
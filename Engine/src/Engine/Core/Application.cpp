@@ -13,6 +13,11 @@ namespace LM
 
     Application* Application::s_Instance = nullptr;
 
+    // ImGui needs a few frames to settle hover and layout changes after an event
+    constexpr int kRedrawFramesAfterEvent = 3;
+    // Waiting is a loop with a timeout, so a lost wake up can't freeze the window
+    constexpr double kIdleWaitTimeout = 0.5;
+
     Application::Application(const ApplicationSpecification& specification) : m_Specification(specification)
     {
         CORE_ASSERT(!s_Instance, "Application already exists!");
@@ -27,6 +32,9 @@ namespace LM
             std::filesystem::current_path(m_Specification.WorkingDirectory);
         }
 
+        m_OnDemandRedraw = m_Specification.OnDemandRedraw;
+        m_RedrawFrames = kRedrawFramesAfterEvent;
+
         m_Window = Window::Create(WindowProps { m_Specification.Name });
         m_Window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
 
@@ -48,10 +56,28 @@ namespace LM
         layer->OnAttach();
     }
 
-    void Application::Close() { m_Running = false; }
+    void Application::Close()
+    {
+        m_Running = false;
+        m_Window->PostEmptyEvent();
+    }
+
+    void Application::RequestRedraw()
+    {
+        m_RedrawFrames = kRedrawFramesAfterEvent;
+        m_Window->PostEmptyEvent();
+    }
+
+    void Application::SetOnDemandRedraw(bool _OnDemandRedraw)
+    {
+        m_OnDemandRedraw = _OnDemandRedraw;
+        m_RedrawFrames = kRedrawFramesAfterEvent;
+    }
 
     void Application::OnEvent(Event& e)
     {
+        m_RedrawFrames = kRedrawFramesAfterEvent;
+
         EventDispatcher dispatcher(e);
         dispatcher.Dispatch<WindowCloseEvent>(BIND_EVENT_FN(Application::OnWindowClose));
         dispatcher.Dispatch<WindowResizeEvent>(BIND_EVENT_FN(Application::OnWindowResize));
@@ -95,6 +121,25 @@ namespace LM
             }
 
             m_Window->OnUpdate();
+
+            if (m_OnDemandRedraw)
+            {
+                WaitForRedraw();
+            }
+        }
+    }
+
+    void Application::WaitForRedraw()
+    {
+        if (m_RedrawFrames > 0)
+        {
+            m_RedrawFrames--;
+            return;
+        }
+
+        while (m_Running && m_OnDemandRedraw && m_RedrawFrames == 0)
+        {
+            m_Window->WaitEvents(kIdleWaitTimeout);
         }
     }
 
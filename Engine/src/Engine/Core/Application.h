@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 
 #include "Engine/Core/Assert.h"
@@ -32,6 +33,8 @@ namespace LM
         std::string Name = "LM Application";
         std::string WorkingDirectory;
         ApplicationCommandLineArgs CommandLineArgs;
+        // Frames are drawn only after events and RequestRedraw(), otherwise every vsync
+        bool OnDemandRedraw = true;
     };
 
     class Application
@@ -49,6 +52,13 @@ namespace LM
 
         void Close();
 
+        // Draws the next frames even without events. Can be called from any thread, e.g. when a background job is
+        // done, and every frame by layers which animate something
+        void RequestRedraw();
+
+        bool IsOnDemandRedraw() const { return m_OnDemandRedraw; }
+        void SetOnDemandRedraw(bool _OnDemandRedraw);
+
         ImGuiLayer* GetImGuiLayer() { return m_ImGuiLayer; }
 
         static Application& Get() { return *s_Instance; }
@@ -57,6 +67,7 @@ namespace LM
 
     private:
         void Run();
+        void WaitForRedraw();
         bool OnWindowClose(WindowCloseEvent& e);
         bool OnWindowResize(WindowResizeEvent& e);
 
@@ -69,6 +80,10 @@ namespace LM
         LayerStack m_LayerStack;
         float m_LastFrameTime = 0.0f;
 
+        bool m_OnDemandRedraw = true;
+        // Frames to draw before waiting for events again
+        std::atomic<int> m_RedrawFrames = 0;
+
     private:
         static Application* s_Instance;
         friend int ::main(int argc, char** argv);
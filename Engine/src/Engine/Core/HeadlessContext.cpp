@@ -0,0 +1,26 @@
+#include "HeadlessContext.h"
+
+#include "Engine/Utils/ConsoleLog.h"
+
+#if defined(OPENGL) && defined(__linux__)
+    #include "Platform/OpenGL/Core/EGLHeadlessContext.h"
+#endif
+
+namespace LM
+{
+
+    Scope<HeadlessContext> HeadlessContext::Create()
+    {
+#if defined(OPENGL) && defined(__linux__)
+        Scope<HeadlessContext> context = CreateScope<EGLHeadlessContext>();
+        if (context->IsValid())
+        {
+            return context;
+        }
+#else
+        LOGE("Headless rendering is not supported on this platform!");
+#endif
+        return nullptr;
+    }
+
+}    // namespace LM
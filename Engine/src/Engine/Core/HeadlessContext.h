@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+#include "Engine/Core/Base.h"
+
+namespace LM
+{
+
+    // OpenGL context without a window for offscreen rendering into framebuffers (batch image export, machines
+    // without a display). Falls back to software rasterization when there is no GPU. The context is current on the
+    // thread which created it
+    class HeadlessContext
+    {
+    public:
+        virtual ~HeadlessContext() = default;
+
+        virtual bool IsValid() const = 0;
+
+        virtual std::string GetRendererName() const = 0;
+
+        // Returns nullptr if no context can be created on this platform
+        static Scope<HeadlessContext> Create();
+    };
+
+}    // namespace LM
@@ -28,6 +28,11 @@ namespace LM
 
         virtual void OnUpdate() = 0;
 
+        // Blocks until an event comes or the timeout is over, events are dispatched to the callback
+        virtual void WaitEvents(double _TimeoutSeconds) = 0;
+        // Wakes WaitEvents up, can be called from any thread
+        virtual void PostEmptyEvent() = 0;
+
         virtual void SetEventCallback(const EventCallbackFn& callback) = 0;
 
         virtual void* GetNativeWindow() const = 0;
@@ -22,4 +22,6 @@ namespace LM
         return nullptr;
     }
 
+    const ShaderLoadStats& Shader::GetLoadStats() { return OGLShader::GetLoadStats(); }
+
 }    // namespace LM
@@ -10,6 +10,22 @@
 namespace LM
 {
 
+    // Uniform location resolved once with Shader::GetUniform, setting it by the handle does no name lookup
+    struct UniformHandle
+    {
+        int Location = -1;
+
+        bool IsValid() const { return Location != -1; }
+    };
+
+    // Shader startup cost since the application start
+    struct ShaderLoadStats
+    {
+        uint32_t CacheHits = 0;
+        uint32_t Compiled = 0;
+        double TotalMs = 0.0;
+    };
+
     class Shader
     {
     public:
@@ -18,6 +34,11 @@ namespace LM
         virtual void Enable() const = 0;
         virtual void Disable() const = 0;
 
+        // Loads the sources again, the current program is kept if they fail to compile. Uniform handles must be
+        // resolved again after a successful reload
+        virtual bool Reload() = 0;
+        virtual const ShaderLayout& GetLayout() const = 0;
+
         virtual void SetUniform1f(std::string_view _Name, float value) = 0;
         virtual void SetUniform1fv(std::string_view _Name, float* value, int count) = 0;
         virtual void SetUniform1i(std::string_view _Name, int value) = 0;
@@ -27,8 +48,19 @@ namespace LM
         virtual void SetUniform4f(std::string_view _Name, const glm::vec4& vector) = 0;
         virtual void SetUniformMat4(std::string_view _Name, const glm::mat4& matrix) = 0;
 
+        virtual UniformHandle GetUniform(std::string_view _Name) const = 0;
+
+        virtual void SetUniform1f(UniformHandle _Uniform, float value) = 0;
+        virtual void SetUniform1i(UniformHandle _Uniform, int value) = 0;
+        virtual void SetUniform2f(UniformHandle _Uniform, const glm::vec2& vector) = 0;
+        virtual void SetUniform3f(UniformHandle _Uniform, const glm::vec3& vector) = 0;
+        virtual void SetUniform4f(UniformHandle _Uniform, const glm::vec4& vector) = 0;
+        virtual void SetUniformMat4(UniformHandle _Uniform, const glm::mat4& matrix) = 0;
+
         // static Ref<Shader> Create(std::string_view _VertPath, std::string_view _FragPath);
         static Ref<Shader> Create(const ShaderLayout& _Layout);
+
+        static const ShaderLoadStats& GetLoadStats();
     };
 
 }    // namespace LM
@@ -0,0 +1,32 @@
+#include "ImageWriter.h"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+#include "Engine/Utils/ConsoleLog.h"
+
+namespace LM
+{
+
+    bool SavePng(const std::filesystem::path& _Path, uint32_t _Width, uint32_t _Height, const uint8_t* _Pixels,
+                 bool _BottomUp)
+    {
+        const int channels = 4;
+        int stride = int(_Width) * channels;
+        const uint8_t* firstRow = _Pixels;
+        // A negative stride flips the image without stbi_flip_vertically_on_write, which is global for all threads
+        if (_BottomUp && _Height > 0)
+        {
+            firstRow += size_t(_Height - 1) * stride;
+            stride = -stride;
+        }
+
+        if (!stbi_write_png(_Path.string().c_str(), int(_Width), int(_Height), channels, firstRow, stride))
+        {
+            LOGE("Can't write image: ", _Path.string());
+            return false;
+        }
+        return true;
+    }
+
+}    // namespace LM
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace LM
+{
+
+    // Writes RGBA8 pixels to a PNG file. _BottomUp is for images read back from OpenGL, their first row is the
+    // bottom one. Can be called from any thread
+    bool SavePng(const std::filesystem::path& _Path, uint32_t _Width, uint32_t _Height, const uint8_t* _Pixels,
+                 bool _BottomUp);
+
+}    // namespace LM
@@ -0,0 +1,190 @@
+#include "FileWatcher.h"
+
+#include <chrono>
+
+#ifdef __linux__
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+#include "Engine/Utils/ConsoleLog.h"
+
+namespace LM
+{
+
+    constexpr auto kPollingInterval = std::chrono::milliseconds(250);
+    // Wake up period of the inotify thread to check m_Running
+    constexpr int kNotifyTimeoutMs = 100;
+
+    static std::filesystem::file_time_type GetWriteTime(const std::filesystem::path& _Path)
+    {
+        std::error_code Error;
+        auto Time = std::filesystem::last_write_time(_Path, Error);
+        return Error ? std::filesystem::file_time_type::min() : Time;
+    }
+
+    FileWatcher::FileWatcher()
+    {
+#ifdef __linux__
+        m_NotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_NotifyFd < 0)
+        {
+            LOGW("inotify is not available, file watcher uses polling");
+        }
+#endif
+        m_Thread = std::thread(&FileWatcher::Run, this);
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+        m_Running = false;
+        m_Thread.join();
+
+#ifdef __linux__
+        if (m_NotifyFd >= 0)
+        {
+            close(m_NotifyFd);
+        }
+#endif
+    }
+
+    void FileWatcher::Watch(const std::filesystem::path& _Path)
+    {
+        std::filesystem::path Path = _Path.lexically_normal();
+        std::filesystem::path Dir = Path.parent_path().empty() ? "." : Path.parent_path();
+
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+
+#ifdef __linux__
+        // Directories are watched instead of files, editors often save by renaming a new file over the old one
+        if (m_NotifyFd >= 0 && m_Files.find(Dir) == m_Files.end())
+        {
+            int Wd = inotify_add_watch(m_NotifyFd, Dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+            if (Wd < 0)
+            {
+                LOGW("Can't watch directory: ", Dir.string());
+            }
+            else
+            {
+                m_NotifyDirs[Wd] = Dir;
+            }
+        }
+#endif
+
+        m_Files[Dir].insert(Path.filename());
+        m_WriteTimes[Path] = GetWriteTime(Path);
+    }
+
+    void FileWatcher::SetOnChanged(const std::function<void()>& _OnChanged)
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        m_OnChanged = _OnChanged;
+    }
+
+    std::vector<std::filesystem::path> FileWatcher::TakeChanged()
+    {
+        std::lock_guard<std::mutex> Lock(m_Mutex);
+        std::vector<std::filesystem::path> Changed(m_Changed.begin(), m_Changed.end());
+        m_Changed.clear();
+        return Changed;
+    }
+
+    void FileWatcher::AddChanged(const std::filesystem::path& _Path)
+    {
+        std::function<void()> OnChanged;
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            m_Changed.insert(_Path);
+            OnChanged = m_OnChanged;
+        }
+
+        if (OnChanged)
+        {
+            OnChanged();
+        }
+    }
+
+    void FileWatcher::Run()
+    {
+        if (!RunNotify())
+        {
+            RunPolling();
+        }
+    }
+
+    bool FileWatcher::RunNotify()
+    {
+#ifdef __linux__
+        if (m_NotifyFd < 0)
+        {
+            return false;
+        }
+
+        alignas(inotify_event) char Buffer[4096];
+        while (m_Running)
+        {
+            pollfd PollFd = { m_NotifyFd, POLLIN, 0 };
+            if (poll(&PollFd, 1, kNotifyTimeoutMs) <= 0)
+            {
+                continue;
+            }
+
+            ssize_t Length = read(m_NotifyFd, Buffer, sizeof(Buffer));
+            for (ssize_t Offset = 0; Offset < Length;)
+            {
+                const inotify_event* Event = (const inotify_event*)(Buffer + Offset);
+                Offset += sizeof(inotify_event) + Event->len;
+                if (Event->len == 0)
+                {
+                    continue;
+                }
+
+                std::filesystem::path Path;
+                {
+                    std::lock_guard<std::mutex> Lock(m_Mutex);
+                    auto DirIt = m_NotifyDirs.find(Event->wd);
+                    if (DirIt == m_NotifyDirs.end() || !m_Files.at(DirIt->second).count(Event->name))
+                    {
+                        continue;
+                    }
+                    Path = (DirIt->second / Event->name).lexically_normal();
+                }
+                AddChanged(Path);
+            }
+        }
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void FileWatcher::RunPolling()
+    {
+        while (m_Running)
+        {
+            std::this_thread::sleep_for(kPollingInterval);
+
+            std::vector<std::filesystem::path> Changed;
+            {
+                std::lock_guard<std::mutex> Lock(m_Mutex);
+                for (auto& [Path, WriteTime] : m_WriteTimes)
+                {
+                    auto Time = GetWriteTime(Path);
+                    if (Time != WriteTime)
+                    {
+                        WriteTime = Time;
+                        Changed.push_back(Path);
+                    }
+                }
+            }
+
+            for (const std::filesystem::path& Path : Changed)
+            {
+                AddChanged(Path);
+            }
+        }
+    }
+
+}    // namespace LM
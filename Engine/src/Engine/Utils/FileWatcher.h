@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace LM
+{
+
+    // Watches files on a background thread: inotify on Linux, modification time polling elsewhere or if inotify is
+    // not available. Changes are collected until TakeChanged() is called from the owner thread
+    class FileWatcher
+    {
+    public:
+        FileWatcher();
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        void Watch(const std::filesystem::path& _Path);
+
+        // Called on the watcher thread after a change of a watched file
+        void SetOnChanged(const std::function<void()>& _OnChanged);
+
+        // Changed files since the last call, paths are the same as passed to Watch()
+        std::vector<std::filesystem::path> TakeChanged();
+
+    protected:
+        void Run();
+        bool RunNotify();
+        void RunPolling();
+        void AddChanged(const std::filesystem::path& _Path);
+
+    protected:
+        std::mutex m_Mutex;
+        // Watched file names by directory
+        std::map<std::filesystem::path, std::set<std::filesystem::path>> m_Files;
+        std::map<std::filesystem::path, std::filesystem::file_time_type> m_WriteTimes;
+        std::set<std::filesystem::path> m_Changed;
+        std::function<void()> m_OnChanged;
+
+        // inotify descriptor and watch descriptors of the directories
+        int m_NotifyFd = -1;
+        std::map<int, std::filesystem::path> m_NotifyDirs;
+
+        std::atomic<bool> m_Running = true;
+        std::thread m_Thread;
+    };
+
+}    // namespace LM
@@ -0,0 +1,192 @@
+#include "EGLHeadlessContext.h"
+
+// EGL is linked on Linux only, other platforms get no headless context from HeadlessContext::Create()
+#if defined(__linux__)
+
+    #include <cstring>
+
+    #include <GL/glew.h>
+
+    // Native types are not used, so no X11 headers are needed
+    #define EGL_NO_X11
+    #include <EGL/egl.h>
+    #include <EGL/eglext.h>
+
+    #include "Engine/Utils/ConsoleLog.h"
+
+namespace LM
+{
+
+    static bool HasExtension(const char* _Extensions, const char* _Name)
+    {
+        if (!_Extensions)
+        {
+            return false;
+        }
+
+        size_t nameLength = std::strlen(_Name);
+        for (const char* extension = std::strstr(_Extensions, _Name); extension;
+             extension = std::strstr(extension + nameLength, _Name))
+        {
+            bool isStart = extension == _Extensions || extension[-1] == ' ';
+            bool isEnd = extension[nameLength] == ' ' || extension[nameLength] == '\0';
+            if (isStart && isEnd)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    EGLHeadlessContext::EGLHeadlessContext() { m_IsValid = Init(); }
+
+    EGLHeadlessContext::~EGLHeadlessContext()
+    {
+        if (!m_Display)
+        {
+            return;
+        }
+
+        eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (m_Context)
+        {
+            eglDestroyContext(m_Display, m_Context);
+        }
+        if (m_Surface)
+        {
+            eglDestroySurface(m_Display, m_Surface);
+        }
+        eglTerminate(m_Display);
+    }
+
+    void* EGLHeadlessContext::GetDisplay() const
+    {
+        // Client extensions are queried without a display
+        const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless") &&
+            HasExtension(clientExtensions, "EGL_EXT_platform_base"))
+        {
+            auto getPlatformDisplay =
+                (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+            if (getPlatformDisplay)
+            {
+                EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+                if (display != EGL_NO_DISPLAY)
+                {
+                    return display;
+                }
+            }
+        }
+
+        return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    bool EGLHeadlessContext::Init()
+    {
+        m_Display = GetDisplay();
+        if (m_Display == EGL_NO_DISPLAY)
+        {
+            LOGE("Can't get EGL display!");
+            return false;
+        }
+
+        EGLint major = 0;
+        EGLint minor = 0;
+        if (!eglInitialize(m_Display, &major, &minor))
+        {
+            LOGE("Can't initialize EGL: ", eglGetError());
+            m_Display = nullptr;
+            return false;
+        }
+        LOGI("EGL version: ", major, ".", minor);
+
+        // clang-format off
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE,       EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+            EGL_RED_SIZE,           8,
+            EGL_GREEN_SIZE,         8,
+            EGL_BLUE_SIZE,          8,
+            EGL_ALPHA_SIZE,         8,
+            EGL_DEPTH_SIZE,         24,
+            EGL_NONE,
+        };
+        // clang-format on
+        EGLConfig config = nullptr;
+        EGLint configsCount = 0;
+        if (!eglChooseConfig(m_Display, configAttribs, &config, 1, &configsCount) || configsCount == 0)
+        {
+            LOGE("No EGL config for OpenGL pbuffers!");
+            return false;
+        }
+
+        const EGLint surfaceAttribs[] = { EGL_WIDTH, 16, EGL_HEIGHT, 16, EGL_NONE };
+        m_Surface = eglCreatePbufferSurface(m_Display, config, surfaceAttribs);
+        if (m_Surface == EGL_NO_SURFACE)
+        {
+            LOGE("Can't create EGL pbuffer: ", eglGetError());
+            m_Surface = nullptr;
+            return false;
+        }
+
+        if (!eglBindAPI(EGL_OPENGL_API))
+        {
+            LOGE("EGL doesn't support desktop OpenGL!");
+            return false;
+        }
+
+        // clang-format off
+        const EGLint contextAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION,          4,
+            EGL_CONTEXT_MINOR_VERSION,          5,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK,    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE,
+        };
+        // clang-format on
+        m_Context = eglCreateContext(m_Display, config, EGL_NO_CONTEXT, contextAttribs);
+        if (m_Context == EGL_NO_CONTEXT)
+        {
+            LOGE("Can't create OpenGL 4.5 context: ", eglGetError());
+            m_Context = nullptr;
+            return false;
+        }
+
+        if (!eglMakeCurrent(m_Display, m_Surface, m_Surface, m_Context))
+        {
+            LOGE("Can't make EGL context current: ", eglGetError());
+            return false;
+        }
+
+        // GLEW built for GLX reports the missing X display after it has loaded the functions of the current context
+        glewExperimental = GL_TRUE;
+        GLenum glewResult = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+        if (glewResult == GLEW_ERROR_NO_GLX_DISPLAY)
+        {
+            glewResult = GLEW_OK;
+        }
+#endif
+        if (glewResult != GLEW_OK)
+        {
+            LOGE("Could not initialise GLEW!");
+            return false;
+        }
+
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        LOGI("OpenGL version: ", glGetString(GL_VERSION));
+        LOGI("OpenGL renderer: ", glGetString(GL_RENDERER));
+
+        return true;
+    }
+
+    std::string EGLHeadlessContext::GetRendererName() const
+    {
+        const GLubyte* renderer = glGetString(GL_RENDERER);
+        return renderer ? std::string((const char*)renderer) : std::string();
+    }
+
+}    // namespace LM
+
+#endif
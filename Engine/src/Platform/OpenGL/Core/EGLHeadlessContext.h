@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Engine/Core/HeadlessContext.h"
+
+namespace LM
+{
+
+    // OpenGL 4.5 core context on an EGL pbuffer. The Mesa surfaceless platform is used when available, so neither an
+    // X server nor a GPU is required (llvmpipe renders on the CPU). Rendering goes to framebuffers, the pbuffer is
+    // only there to make the context current
+    class EGLHeadlessContext : public HeadlessContext
+    {
+    public:
+        EGLHeadlessContext();
+        virtual ~EGLHeadlessContext();
+
+        virtual bool IsValid() const override { return m_IsValid; }
+
+        virtual std::string GetRendererName() const override;
+
+    protected:
+        bool Init();
+        void* GetDisplay() const;
+
+    protected:
+        // EGLDisplay, EGLSurface, EGLContext
+        void* m_Display = nullptr;
+        void* m_Surface = nullptr;
+        void* m_Context = nullptr;
+
+        bool m_IsValid = false;
+    };
+
+}    // namespace LM
@@ -28,6 +28,10 @@ namespace LM
         glfwSwapBuffers(m_Window);
     }
 
+    void GLFWWindow::WaitEvents(double _TimeoutSeconds) { glfwWaitEventsTimeout(_TimeoutSeconds); }
+
+    void GLFWWindow::PostEmptyEvent() { glfwPostEmptyEvent(); }
+
     bool GLFWWindow::Init()
     {
         if (!glfwInit())
@@ -18,6 +18,9 @@ namespace LM
 
         virtual void OnUpdate() override;
 
+        virtual void WaitEvents(double _TimeoutSeconds) override;
+        virtual void PostEmptyEvent() override;
+
         void SetEventCallback(const EventCallbackFn& callback) override { m_Data.EventCallback = callback; }
 
         virtual void* GetNativeWindow() const override { return m_Window; }
@@ -1,6 +1,8 @@
 #include "OGLShader.h"
 
+#include <chrono>
 #include <fstream>
+#include <sstream>
 #include <string>
 
 #include <GL/glew.h>
@@ -11,11 +13,25 @@
 namespace LM
 {
 
+    constexpr const char* kShaderCacheDir = RES_FOLDER "cache/shaders";
+
+    constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+    constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+    static uint64_t HashFnv1a(std::string_view _Data, uint64_t _Hash)
+    {
+        for (char Char : _Data)
+        {
+            _Hash = (_Hash ^ uint8_t(Char)) * kFnvPrime;
+        }
+        return _Hash;
+    }
+
+    ShaderLoadStats OGLShader::s_LoadStats;
+
     OGLShader::OGLShader(const ShaderLayout& _Layout)
     {
-#ifdef DEBUG
         m_Layout = _Layout;
-#endif
 
         m_ShaderID = Load(_Layout);
     }
@@ -26,13 +42,62 @@ namespace LM
 
     void OGLShader::Disable() const { glUseProgram(0); }
 
+    bool OGLShader::Reload()
+    {
+        uint32_t Program = Load(m_Layout);
+        if (!Program)
+        {
+            LOGE("Shader reload failed, the old program is kept: ", GetLayoutName(m_Layout));
+            return false;
+        }
+
+        glDeleteProgram(m_ShaderID);
+        m_ShaderID = Program;
+        m_UniformLocationCache.clear();
+        return true;
+    }
+
     uint32_t OGLShader::Load(const ShaderLayout& _Layout)
+    {
+        auto StartTime = std::chrono::steady_clock::now();
+
+        std::vector<std::string> Sources;
+        for (uint32_t i = 0; i < _Layout.GetSources().size(); ++i)
+        {
+            Sources.emplace_back(GenerateSource(_Layout, i));
+        }
+
+        std::string Name = GetLayoutName(_Layout);
+        std::filesystem::path CachePath = GetCachePath(_Layout, Sources);
+
+        bool FromCache = !CachePath.empty();
+        uint32_t Program = FromCache ? LoadBinary(CachePath) : 0;
+        if (!Program)
+        {
+            FromCache = false;
+            Program = Compile(_Layout, Sources);
+            if (Program && !CachePath.empty())
+            {
+                SaveBinary(Program, CachePath);
+            }
+        }
+
+        double Ms =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - StartTime).count();
+        s_LoadStats.TotalMs += Ms;
+        (FromCache ? s_LoadStats.CacheHits : s_LoadStats.Compiled)++;
+        LOGI("Shader ", Name, (FromCache ? " loaded from cache in " : " compiled in "), Ms, " ms");
+
+        return Program;
+    }
+
+    uint32_t OGLShader::Compile(const ShaderLayout& _Layout, const std::vector<std::string>& _Sources)
     {
         uint32_t Program = glCreateProgram();
         std::vector<uint32_t> Shaders;
-        for (uint32_t i = 0; i < _Layout.GetSources().size(); ++i)
+        for (uint32_t i = 0; i < _Sources.size(); ++i)
         {
-            Shaders.emplace_back(LoadShader(_Layout, i));
+            Shaders.emplace_back(LoadShader(_Layout.GetSource(i).GetType(), _Sources[i]));
         }
 
         for (uint32_t ShaderID : Shaders)
@@ -40,9 +105,15 @@ namespace LM
             glAttachShader(Program, ShaderID);
         }
 
+        glProgramParameteri(Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
         glLinkProgram(Program);
         glValidateProgram(Program);
 
+        for (uint32_t ShaderID : Shaders)
+        {
+            glDeleteShader(ShaderID);
+        }
+
         int CompileRes;
         glGetProgramiv(Program, GL_LINK_STATUS, &CompileRes);
         if (CompileRes == GL_FALSE)
@@ -56,14 +127,132 @@ namespace LM
             return 0;
         }
 
-        for (uint32_t ShaderID : Shaders)
+        return Program;
+    }
+
+    std::string OGLShader::GetLayoutName(const ShaderLayout& _Layout)
+    {
+        std::string Name;
+        for (const ShaderSource& Source : _Layout.GetSources())
         {
-            glDeleteShader(ShaderID);
+            Name += Name.empty() ? "" : " + ";
+            Name += Source.GetLoadType() == ShaderSource::LoadType::FILEPATH ? Source.GetSource() : "<source>";
+        }
+        return Name;
+    }
+
+    std::filesystem::path OGLShader::GetCachePath(const ShaderLayout& _Layout, const std::vector<std::string>& _Sources)
+    {
+        int FormatsCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &FormatsCount);
+        if (FormatsCount == 0)
+        {
+            return {};
+        }
+
+        // Binaries are valid only for the same driver, so it is a part of the key
+        uint64_t Hash = kFnvOffsetBasis;
+        for (GLenum Name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+        {
+            const char* Value = (const char*)glGetString(Name);
+            Hash = HashFnv1a(Value ? Value : "", Hash);
+        }
+        for (uint32_t i = 0; i < _Sources.size(); ++i)
+        {
+            Hash = HashFnv1a(GetName(_Layout.GetSource(i).GetType()), Hash);
+            Hash = HashFnv1a(_Sources[i], Hash);
+        }
+
+        char FileName[32];
+        snprintf(FileName, sizeof(FileName), "%016llx.bin", (unsigned long long)Hash);
+        return std::filesystem::path(kShaderCacheDir) / FileName;
+    }
+
+    uint32_t OGLShader::LoadBinary(const std::filesystem::path& _Path)
+    {
+        std::ifstream File(_Path, std::ios::binary);
+        if (!File.is_open())
+        {
+            return 0;
+        }
+
+        uint32_t Format = 0;
+        File.read((char*)&Format, sizeof(Format));
+        if (!File)
+        {
+            return 0;
+        }
+
+        // istreambuf_iterator reads through the buffer and never sets the stream state, so only the size is checked
+        std::vector<char> Binary((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+        if (Binary.empty())
+        {
+            return 0;
+        }
+
+        uint32_t Program = glCreateProgram();
+        glProgramBinary(Program, Format, Binary.data(), Binary.size());
+
+        // Driver updates and damaged files make the binary invalid, the caller compiles the sources then
+        int LinkRes;
+        glGetProgramiv(Program, GL_LINK_STATUS, &LinkRes);
+        if (LinkRes == GL_FALSE)
+        {
+            LOGW("Shader cache is outdated: ", _Path.string());
+            glDeleteProgram(Program);
+            return 0;
         }
 
         return Program;
     }
 
+    void OGLShader::SaveBinary(uint32_t _Program, const std::filesystem::path& _Path)
+    {
+        int Length = 0;
+        glGetProgramiv(_Program, GL_PROGRAM_BINARY_LENGTH, &Length);
+        if (Length <= 0)
+        {
+            return;
+        }
+
+        std::vector<char> Binary(Length);
+        GLenum Format = 0;
+        glGetProgramBinary(_Program, Length, &Length, &Format, Binary.data());
+
+        std::error_code Error;
+        std::filesystem::create_directories(_Path.parent_path(), Error);
+
+        // Written next to the entry and renamed over it, so an interrupted write never leaves a truncated entry
+        std::filesystem::path TempPath = _Path;
+        TempPath += ".tmp";
+        {
+            std::ofstream File(TempPath, std::ios::binary);
+            if (!File.is_open())
+            {
+                LOGW("Can't write shader cache: ", TempPath.string());
+                return;
+            }
+
+            uint32_t Format32 = Format;
+            File.write((const char*)&Format32, sizeof(Format32));
+            File.write(Binary.data(), Length);
+            File.close();
+            if (!File)
+            {
+                LOGW("Can't write shader cache: ", TempPath.string());
+                std::filesystem::remove(TempPath, Error);
+                return;
+            }
+        }
+
+        std::filesystem::rename(TempPath, _Path, Error);
+        if (Error)
+        {
+            LOGW("Can't write shader cache: ", _Path.string(), ", ", Error.message());
+            std::filesystem::remove(TempPath, Error);
+        }
+    }
+
     uint32_t OGLShader::GetType(ShaderSource::Type _Type)
     {
         switch (_Type)
@@ -129,11 +318,9 @@ namespace LM
         return Res;
     }
 
-    uint32_t OGLShader::LoadShader(const ShaderLayout& _Layout, uint32_t _SourceID)
+    std::string OGLShader::GenerateSource(const ShaderLayout& _Layout, uint32_t _SourceID)
     {
         const ShaderSource& Source = _Layout.GetSource(_SourceID);
-        uint32_t Type = GetType(Source.GetType());
-        std::string Name = GetName(Source.GetType());
 
         std::string SourceString = LoadVersion();
         if (Source.GetType() == ShaderSource::Type::VERTEX)
@@ -142,13 +329,19 @@ namespace LM
         }
         SourceString += (Source.GetLoadType() == ShaderSource::LoadType::FILEPATH ? LoadFile(Source.GetSource())
                                                                                   : Source.GetSource());
-        const char* CharSource = SourceString.c_str();
+        return SourceString;
+    }
+
+    uint32_t OGLShader::LoadShader(ShaderSource::Type _Type, const std::string& _Source)
+    {
+        uint32_t Type = GetType(_Type);
+        std::string Name = GetName(_Type);
+
+        const char* CharSource = _Source.c_str();
         uint32_t Res = glCreateShader(Type);
         glShaderSource(Res, 1, &CharSource, NULL);
         glCompileShader(Res);
 
-        LOGI(Name, " shader code: \n", SourceString);
-
         int CompileRes;
         glGetShaderiv(Res, GL_COMPILE_STATUS, &CompileRes);
         if (CompileRes == GL_FALSE)
@@ -157,7 +350,7 @@ namespace LM
             glGetShaderiv(Res, GL_INFO_LOG_LENGTH, &Length);
             std::vector<char> Error(Length + 1024);
             glGetShaderInfoLog(Res, Length, &Length, &Error[0]);
-            LOGE("Failed to compile ", Name, " shader!\n    ", &Error[0]);
+            LOGE("Failed to compile ", Name, " shader!\n    ", &Error[0], "\n", Name, " shader code: \n", _Source);
             glDeleteShader(Res);
             return 0;
         }
@@ -167,72 +360,35 @@ namespace LM
 
     std::string OGLShader::LoadFile(std::string_view _FilePath)
     {
-        std::ifstream IfStream(_FilePath.data());
+        std::ifstream IfStream(std::string(_FilePath), std::ios::binary);
         if (!IfStream.is_open())
         {
             LOGE("Can't Open Shader file: ", _FilePath);
+            return "";
         }
-        std::string Line;
-        std::string Shader;
 
-        while (getline(IfStream, Line))
-        {
-            // if (Line.find("#texture") < Line.size())
-            //{
-            //	int IDsCount;
-            //	int MaxTextures;
-            //	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &IDsCount);
-            //	glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &MaxTextures);
-            //
-            //	const int PackCount = MaxTextures / IDsCount;
-            //	const int NoneSimpleTextures = 1;
-            //	const int TexturesToUse = MaxTextures - NoneSimpleTextures;
-            //
-            //	for (int i = 1; i <= PackCount; i++)
-            //	{
-            //		std::string TexName = "u_Textures" + std::to_string(i) + "[" + std::to_string(i != PackCount ?
-            //IDsCount : IDsCount - NoneSimpleTextures) + "]"; 		Shader += "uniform sampler2D " + TexName + "; \n";
-            //	}
-            //
-            //	Shader += "	vec4 GetTextureColor(int tid) \n";
-            //	Shader += "	{ \n";
-            //	Shader += "		if (tid == -1) \n";
-            //	Shader += "			return vec4(1.0f, 1.0f, 1.0f, 1.0f); \n";
-            //	Shader += "		switch (tid) \n";
-            //	Shader += "		{ \n";
-            //
-            //	for (int i = 0; i < TexturesToUse; i++)
-            //	{
-            //		std::string caseStr = "case " + std::to_string(i) + ": \n";
-            //		caseStr += "return texture(u_Textures" + std::to_string(i / IDsCount + 1) + "[" + std::to_string(i %
-            //IDsCount) + "], v_UV); \n";
-            //
-            //		Shader += caseStr; //i / IDsCount + 1; [i % IDsCount] ;
-            //	}
-            //	Shader +="		} \n";
-            //	Shader +="	} \n";
-            //
-            //	continue;
-            // }
-
-            Shader += Line + "\n";
-        }
-
-        return Shader;
+        std::stringstream Shader;
+        Shader << IfStream.rdbuf();
+        return Shader.str();
     }
 
     int OGLShader::GetUniformLocation(std::string_view _Name) const
     {
-        if (m_UniformLocationCache.find(_Name.data()) != m_UniformLocationCache.end())
+        auto it = m_UniformLocationCache.find(_Name);
+        if (it != m_UniformLocationCache.end())
         {
-            return m_UniformLocationCache[_Name.data()];
+            return it->second;
         }
 
-        GLint location = glGetUniformLocation(m_ShaderID, _Name.data());
-        m_UniformLocationCache[_Name.data()] = location;
+        // string_view may be not null terminated
+        std::string Name(_Name);
+        GLint location = glGetUniformLocation(m_ShaderID, Name.c_str());
+        m_UniformLocationCache.emplace(std::move(Name), location);
         return location;
     }
 
+    UniformHandle OGLShader::GetUniform(std::string_view _Name) const { return { GetUniformLocation(_Name) }; }
+
     void OGLShader::SetUniform1f(std::string_view _Name, float value) { glUniform1f(GetUniformLocation(_Name), value); }
     void OGLShader::SetUniform1fv(std::string_view _Name, float* value, int count)
     {
@@ -260,4 +416,23 @@ namespace LM
         glUniformMatrix4fv(GetUniformLocation(_Name), 1, GL_FALSE, &matrix[0][0]);
     }
 
+    void OGLShader::SetUniform1f(UniformHandle _Uniform, float value) { glUniform1f(_Uniform.Location, value); }
+    void OGLShader::SetUniform1i(UniformHandle _Uniform, int value) { glUniform1i(_Uniform.Location, value); }
+    void OGLShader::SetUniform2f(UniformHandle _Uniform, const glm::vec2& vector)
+    {
+        glUniform2f(_Uniform.Location, vector.x, vector.y);
+    }
+    void OGLShader::SetUniform3f(UniformHandle _Uniform, const glm::vec3& vector)
+    {
+        glUniform3f(_Uniform.Location, vector.x, vector.y, vector.z);
+    }
+    void OGLShader::SetUniform4f(UniformHandle _Uniform, const glm::vec4& vector)
+    {
+        glUniform4f(_Uniform.Location, vector.x, vector.y, vector.z, vector.w);
+    }
+    void OGLShader::SetUniformMat4(UniformHandle _Uniform, const glm::mat4& matrix)
+    {
+        glUniformMatrix4fv(_Uniform.Location, 1, GL_FALSE, &matrix[0][0]);
+    }
+
 }    // namespace LM
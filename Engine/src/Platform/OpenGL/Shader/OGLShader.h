@@ -1,5 +1,7 @@
 #pragma once
 
+#include <filesystem>
+#include <string>
 #include <unordered_map>
 
 #include "Engine/Shader/Shader.h"
@@ -17,6 +19,9 @@ namespace LM
         virtual void Enable() const override;
         virtual void Disable() const override;
 
+        virtual bool Reload() override;
+        virtual const ShaderLayout& GetLayout() const override { return m_Layout; }
+
         virtual void SetUniform1f(std::string_view _Name, float value) override;
         virtual void SetUniform1fv(std::string_view _Name, float* value, int count) override;
         virtual void SetUniform1i(std::string_view _Name, int value) override;
@@ -26,23 +31,51 @@ namespace LM
         virtual void SetUniform4f(std::string_view _Name, const glm::vec4& vector) override;
         virtual void SetUniformMat4(std::string_view _Name, const glm::mat4& matrix) override;
 
+        virtual UniformHandle GetUniform(std::string_view _Name) const override;
+
+        virtual void SetUniform1f(UniformHandle _Uniform, float value) override;
+        virtual void SetUniform1i(UniformHandle _Uniform, int value) override;
+        virtual void SetUniform2f(UniformHandle _Uniform, const glm::vec2& vector) override;
+        virtual void SetUniform3f(UniformHandle _Uniform, const glm::vec3& vector) override;
+        virtual void SetUniform4f(UniformHandle _Uniform, const glm::vec4& vector) override;
+        virtual void SetUniformMat4(UniformHandle _Uniform, const glm::mat4& matrix) override;
+
+        static const ShaderLoadStats& GetLoadStats() { return s_LoadStats; }
+
     protected:
+        // Program binary is taken from the cache if it has one for the same sources and driver, otherwise the
+        // sources are compiled and the binary is saved to the cache
         uint32_t Load(const ShaderLayout& _Layout);
+        uint32_t Compile(const ShaderLayout& _Layout, const std::vector<std::string>& _Sources);
+        std::string GetLayoutName(const ShaderLayout& _Layout);
+        // Empty if the driver doesn't support program binaries
+        std::filesystem::path GetCachePath(const ShaderLayout& _Layout, const std::vector<std::string>& _Sources);
+        uint32_t LoadBinary(const std::filesystem::path& _Path);
+        void SaveBinary(uint32_t _Program, const std::filesystem::path& _Path);
         uint32_t GetType(ShaderSource::Type _Type);
         std::string GetName(ShaderSource::Type _Type);
         std::string LoadVersion();
         std::string GetAttributeTypeName(ShaderDataType _Type);
         std::string LoadAttributes(const std::vector<ShaderAttribute>& _Attributes);
-        uint32_t LoadShader(const ShaderLayout& _Layout, uint32_t _SourceID);
+        std::string GenerateSource(const ShaderLayout& _Layout, uint32_t _SourceID);
+        uint32_t LoadShader(ShaderSource::Type _Type, const std::string& _Source);
         std::string LoadFile(std::string_view _FilePath);
         int GetUniformLocation(std::string_view name) const;
 
+    protected:
+        // Transparent hash, so string_view lookups don't construct std::string
+        struct StringHash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view _Str) const { return std::hash<std::string_view>()(_Str); }
+        };
+
     protected:
         uint32_t m_ShaderID;
-        mutable std::unordered_map<std::string, int> m_UniformLocationCache;
-#ifdef DEBUG
+        mutable std::unordered_map<std::string, int, StringHash, std::equal_to<>> m_UniformLocationCache;
         ShaderLayout m_Layout;
-#endif
+
+        static ShaderLoadStats s_LoadStats;
     };
 
 }    // namespace LM
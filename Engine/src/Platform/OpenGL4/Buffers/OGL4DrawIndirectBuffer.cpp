@@ -0,0 +1,34 @@
+#include "OGL4DrawIndirectBuffer.h"
+
+#include <GL/glew.h>
+
+namespace LM
+{
+
+    OGL4DrawIndirectBuffer::OGL4DrawIndirectBuffer(const DrawElementsIndirectCommand* _Commands, uint32_t _Count)
+    {
+        glCreateBuffers(1, &m_BufferID);
+        SetCommands(_Commands, _Count);
+    }
+
+    OGL4DrawIndirectBuffer::~OGL4DrawIndirectBuffer() { glDeleteBuffers(1, &m_BufferID); }
+
+    void OGL4DrawIndirectBuffer::Bind() const { glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_BufferID); }
+
+    void OGL4DrawIndirectBuffer::Unbind() const { glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0); }
+
+    void OGL4DrawIndirectBuffer::SetCommands(const DrawElementsIndirectCommand* _Commands, uint32_t _Count)
+    {
+        if (_Count > m_Capacity || m_Capacity == 0)
+        {
+            m_Capacity = _Count > 0 ? _Count : 1;
+            glNamedBufferData(m_BufferID, m_Capacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+        }
+        if (_Count > 0)
+        {
+            glNamedBufferSubData(m_BufferID, 0, _Count * sizeof(DrawElementsIndirectCommand), _Commands);
+        }
+        m_Count = _Count;
+    }
+
+}    // namespace LM
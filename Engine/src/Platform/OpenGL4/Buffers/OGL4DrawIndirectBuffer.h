@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Engine/Buffers/DrawIndirectBuffer.h"
+
+namespace LM
+{
+
+    class OGL4DrawIndirectBuffer : public DrawIndirectBuffer
+    {
+    public:
+        OGL4DrawIndirectBuffer(const DrawElementsIndirectCommand* _Commands, uint32_t _Count);
+        virtual ~OGL4DrawIndirectBuffer();
+
+        virtual void Bind() const override;
+        virtual void Unbind() const override;
+
+        virtual void SetCommands(const DrawElementsIndirectCommand* _Commands, uint32_t _Count) override;
+
+        virtual uint32_t GetCount() const override { return m_Count; }
+
+        inline uint32_t GetBufferID() const { return m_BufferID; }
+
+    protected:
+        uint32_t m_BufferID;
+        uint32_t m_Count = 0;
+        uint32_t m_Capacity = 0;
+    };
+
+}    // namespace LM
@@ -0,0 +1,134 @@
+#include "OGL4DynamicMesh.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <GL/glew.h>
+
+namespace LM
+{
+
+    constexpr GLbitfield kStorageFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    OGL4DynamicMesh::OGL4DynamicMesh(const BufferLayout& _Layout, uint32_t _VerticesCapacity,
+                                     uint32_t _IndicesCapacity)
+        : m_Layout(_Layout)
+    {
+        CreateStorage(std::max(_VerticesCapacity, 1u), std::max(_IndicesCapacity, 1u));
+    }
+
+    OGL4DynamicMesh::~OGL4DynamicMesh() { DestroyStorage(); }
+
+    void OGL4DynamicMesh::CreateStorage(uint32_t _VerticesCapacity, uint32_t _IndicesCapacity)
+    {
+        m_VerticesCapacity = _VerticesCapacity;
+        m_IndicesCapacity = _IndicesCapacity;
+
+        GLsizeiptr verticesSize = GLsizeiptr(m_VerticesCapacity) * m_Layout.GetStride() * kRegionsCount;
+        GLsizeiptr indicesSize = GLsizeiptr(m_IndicesCapacity) * sizeof(uint32_t) * kRegionsCount;
+
+        glCreateBuffers(1, &m_VertexBufferID);
+        glNamedBufferStorage(m_VertexBufferID, verticesSize, nullptr, kStorageFlags);
+        m_MappedVertices = (uint8_t*)glMapNamedBufferRange(m_VertexBufferID, 0, verticesSize, kStorageFlags);
+
+        glCreateBuffers(1, &m_IndexBufferID);
+        glNamedBufferStorage(m_IndexBufferID, indicesSize, nullptr, kStorageFlags);
+        m_MappedIndices = (uint32_t*)glMapNamedBufferRange(m_IndexBufferID, 0, indicesSize, kStorageFlags);
+
+        CORE_ASSERT(m_MappedVertices && m_MappedIndices, "Can't map dynamic mesh buffers!");
+
+        m_VertexArray = CreateRef<OGL4VertexArray>();
+        m_VertexArray->AddVertexBuffer(m_VertexBufferID, m_Layout);
+        m_VertexArray->SetIndexBuffer(m_IndexBufferID);
+
+        m_Region = 0;
+    }
+
+    void OGL4DynamicMesh::DestroyStorage()
+    {
+        for (void*& fence : m_Fences)
+        {
+            if (fence)
+            {
+                glDeleteSync(static_cast<GLsync>(fence));
+                fence = nullptr;
+            }
+        }
+
+        m_VertexArray = nullptr;
+
+        glUnmapNamedBuffer(m_VertexBufferID);
+        glUnmapNamedBuffer(m_IndexBufferID);
+        glDeleteBuffers(1, &m_VertexBufferID);
+        glDeleteBuffers(1, &m_IndexBufferID);
+
+        m_MappedVertices = nullptr;
+        m_MappedIndices = nullptr;
+    }
+
+    void OGL4DynamicMesh::WaitRegion(uint32_t _Region)
+    {
+        GLsync fence = static_cast<GLsync>(m_Fences[_Region]);
+        if (!fence)
+        {
+            return;
+        }
+
+        GLenum waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        while (waitResult == GL_TIMEOUT_EXPIRED)
+        {
+            waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }
+
+        glDeleteSync(fence);
+        m_Fences[_Region] = nullptr;
+    }
+
+    void OGL4DynamicMesh::SetData(const void* _Vertices, uint32_t _VerticesCount, const uint32_t* _Indices,
+                                  uint32_t _IndicesCount)
+    {
+        if (_VerticesCount > m_VerticesCapacity || _IndicesCount > m_IndicesCapacity)
+        {
+            // Buffers still used by the GPU are released by the driver after the draws are done
+            uint32_t verticesCapacity = std::max(_VerticesCount, m_VerticesCapacity * 2);
+            uint32_t indicesCapacity = std::max(_IndicesCount, m_IndicesCapacity * 2);
+            DestroyStorage();
+            CreateStorage(verticesCapacity, indicesCapacity);
+        }
+        else
+        {
+            m_Region = (m_Region + 1) % kRegionsCount;
+            WaitRegion(m_Region);
+        }
+
+        const uint32_t stride = m_Layout.GetStride();
+        std::memcpy(m_MappedVertices + size_t(m_Region) * m_VerticesCapacity * stride, _Vertices,
+                    size_t(_VerticesCount) * stride);
+        std::memcpy(m_MappedIndices + size_t(m_Region) * m_IndicesCapacity, _Indices,
+                    size_t(_IndicesCount) * sizeof(uint32_t));
+
+        m_VerticesCount = _VerticesCount;
+        m_IndicesCount = _IndicesCount;
+    }
+
+    void OGL4DynamicMesh::Draw() const
+    {
+        if (m_IndicesCount == 0)
+        {
+            return;
+        }
+
+        m_VertexArray->Bind();
+        glDrawElementsBaseVertex(GL_TRIANGLES, m_IndicesCount, GL_UNSIGNED_INT,
+                                 (const void*)(size_t(m_Region) * m_IndicesCapacity * sizeof(uint32_t)),
+                                 GLint(m_Region * m_VerticesCapacity));
+
+        // The last draw from the region is enough to know when the GPU is done with it
+        if (m_Fences[m_Region])
+        {
+            glDeleteSync(static_cast<GLsync>(m_Fences[m_Region]));
+        }
+        m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+}    // namespace LM
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Engine/Buffers/DynamicMesh.h"
+
+#include "OGL4VertexArray.h"
+
+namespace LM
+{
+
+    // Vertex and index buffers use persistent mapped coherent storage split in kRegionsCount regions. Every SetData
+    // writes the next region and Draw() fences the region it reads, so CPU writes wait only for a region the GPU
+    // still reads (practically never with 3 regions) and no GL objects are created while capacity is enough
+    class OGL4DynamicMesh : public DynamicMesh
+    {
+    public:
+        OGL4DynamicMesh(const BufferLayout& _Layout, uint32_t _VerticesCapacity, uint32_t _IndicesCapacity);
+        virtual ~OGL4DynamicMesh();
+
+        virtual void SetData(const void* _Vertices, uint32_t _VerticesCount, const uint32_t* _Indices,
+                             uint32_t _IndicesCount) override;
+
+        virtual void Draw() const override;
+
+        virtual uint32_t GetVerticesCount() const override { return m_VerticesCount; }
+        virtual uint32_t GetIndicesCount() const override { return m_IndicesCount; }
+
+        virtual const BufferLayout& GetLayout() const override { return m_Layout; }
+
+    protected:
+        void CreateStorage(uint32_t _VerticesCapacity, uint32_t _IndicesCapacity);
+        void DestroyStorage();
+
+        void WaitRegion(uint32_t _Region);
+
+    protected:
+        static constexpr uint32_t kRegionsCount = 3;
+
+        BufferLayout m_Layout;
+
+        // Capacity of one region
+        uint32_t m_VerticesCapacity = 0;
+        uint32_t m_IndicesCapacity = 0;
+
+        uint32_t m_VertexBufferID = 0;
+        uint32_t m_IndexBufferID = 0;
+        uint8_t* m_MappedVertices = nullptr;
+        uint32_t* m_MappedIndices = nullptr;
+
+        Ref<OGL4VertexArray> m_VertexArray;
+
+        uint32_t m_Region = 0;
+        uint32_t m_VerticesCount = 0;
+        uint32_t m_IndicesCount = 0;
+
+        // GLsync of the last draw from every region
+        mutable void* m_Fences[kRegionsCount] = {};
+    };
+
+}    // namespace LM
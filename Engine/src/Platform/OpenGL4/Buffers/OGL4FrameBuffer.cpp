@@ -13,6 +13,7 @@ namespace LM
         m_Width = _Props.Width;
         m_Height = _Props.Height;
         m_BufferMask = _Props.FBMask;
+        m_Samples = _Props.Samples;
 
         for (const auto& Mask : _Props.FBColorMask)
         {
@@ -21,6 +22,10 @@ namespace LM
 
         glGetIntegerv(GL_MAX_TEXTURE_SIZE, &m_TextureMaxSize);
 
+        int maxSamples = 1;
+        glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+        m_Samples = glm::clamp(m_Samples, 1u, uint32_t(maxSamples));
+
         OnAttach();
     }
 
@@ -35,11 +40,15 @@ namespace LM
 
         CreateRenderBuffer();
 
-        CheckStatus();
+        CheckStatus(m_BufferID);
+
+        CreateMultisample();
     }
 
     void OGL4FrameBuffer::OnDetach()
     {
+        DestroyMultisample();
+
         for (uint32_t i = 0; i < m_ColorTextures.size(); i++)
         {
             glDeleteTextures(1, &m_ColorTextures[i].Id);
@@ -131,11 +140,90 @@ namespace LM
         glNamedFramebufferRenderbuffer(m_BufferID, RenderBufferAttach, GL_RENDERBUFFER, m_RenderBufferId);
     }
 
-    void OGL4FrameBuffer::CheckStatus()
+    void OGL4FrameBuffer::CreateMultisample()
+    {
+        if (!IsMultisampled())
+        {
+            return;
+        }
+
+        glCreateFramebuffers(1, &m_MultisampleBufferID);
+
+        std::vector<uint32_t> Attachments;
+        m_MultisampleColorIds.resize(m_ColorTextures.size());
+        for (uint32_t i = 0; i < m_ColorTextures.size(); i++)
+        {
+            uint32_t TextureFormat = m_ColorTextures[i].Mask & FrameBufferColorMASK::HDR ? GL_RGBA16F : GL_RGBA8;
+            glCreateRenderbuffers(1, &m_MultisampleColorIds[i]);
+            glNamedRenderbufferStorageMultisample(m_MultisampleColorIds[i], m_Samples, TextureFormat, m_Width,
+                                                  m_Height);
+            glNamedFramebufferRenderbuffer(m_MultisampleBufferID, GL_COLOR_ATTACHMENT0 + i, GL_RENDERBUFFER,
+                                           m_MultisampleColorIds[i]);
+            Attachments.push_back(GL_COLOR_ATTACHMENT0 + i);
+        }
+        if (m_ColorTextures.size() > 1)
+        {
+            glNamedFramebufferDrawBuffers(m_MultisampleBufferID, m_ColorTextures.size(), Attachments.data());
+        }
+
+        if (HasRenderBuffer())
+        {
+            glCreateRenderbuffers(1, &m_MultisampleRenderBufferId);
+            glNamedRenderbufferStorageMultisample(m_MultisampleRenderBufferId, m_Samples, GetRenderBufferFormat(),
+                                                  m_Width, m_Height);
+            glNamedFramebufferRenderbuffer(m_MultisampleBufferID, GetRenderBufferAttach(), GL_RENDERBUFFER,
+                                           m_MultisampleRenderBufferId);
+        }
+
+        CheckStatus(m_MultisampleBufferID);
+    }
+
+    void OGL4FrameBuffer::DestroyMultisample()
+    {
+        if (!m_MultisampleBufferID)
+        {
+            return;
+        }
+
+        glDeleteRenderbuffers(m_MultisampleColorIds.size(), m_MultisampleColorIds.data());
+        m_MultisampleColorIds.clear();
+
+        if (m_MultisampleRenderBufferId)
+        {
+            glDeleteRenderbuffers(1, &m_MultisampleRenderBufferId);
+            m_MultisampleRenderBufferId = 0;
+        }
+
+        glDeleteFramebuffers(1, &m_MultisampleBufferID);
+        m_MultisampleBufferID = 0;
+    }
+
+    void OGL4FrameBuffer::Resolve() const
+    {
+        for (uint32_t i = 0; i < m_ColorTextures.size(); i++)
+        {
+            glNamedFramebufferReadBuffer(m_MultisampleBufferID, GL_COLOR_ATTACHMENT0 + i);
+            glNamedFramebufferDrawBuffer(m_BufferID, GL_COLOR_ATTACHMENT0 + i);
+            glBlitNamedFramebuffer(m_MultisampleBufferID, m_BufferID, 0, 0, m_Width, m_Height, 0, 0, m_Width,
+                                   m_Height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        }
+
+        if (m_ColorTextures.size() > 1)
+        {
+            std::vector<uint32_t> Attachments;
+            for (uint32_t i = 0; i < m_ColorTextures.size(); i++)
+            {
+                Attachments.push_back(GL_COLOR_ATTACHMENT0 + i);
+            }
+            glNamedFramebufferDrawBuffers(m_BufferID, m_ColorTextures.size(), Attachments.data());
+        }
+    }
+
+    void OGL4FrameBuffer::CheckStatus(uint32_t _BufferID)
     {
         // CORE_ASSERT(glCheckNamedFramebufferStatus(m_BufferID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
         // "FRAMEBUFFER: Framebuffer is not complete!");
-        switch (glCheckNamedFramebufferStatus(m_BufferID, GL_FRAMEBUFFER))
+        switch (glCheckNamedFramebufferStatus(_BufferID, GL_FRAMEBUFFER))
         {
             case GL_FRAMEBUFFER_UNDEFINED: CORE_ASSERT(false, "FRAMEBUFFER: GL_FRAMEBUFFER_UNDEFINED"); break;
             case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT:
@@ -162,10 +250,17 @@ namespace LM
     void OGL4FrameBuffer::Bind() const
     {
         glViewport(0, 0, m_Width, m_Height);
-        glBindFramebuffer(GL_FRAMEBUFFER, m_BufferID);
+        glBindFramebuffer(GL_FRAMEBUFFER, GetDrawBufferID());
     }
 
-    void OGL4FrameBuffer::Unbind() const { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+    void OGL4FrameBuffer::Unbind() const
+    {
+        if (IsMultisampled())
+        {
+            Resolve();
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
 
     void OGL4FrameBuffer::Clear(glm::vec4 _Color) const
     {
@@ -173,10 +268,10 @@ namespace LM
         int Stencil = 0;
         for (int i = 0; i < m_ColorTextures.size(); i++)
         {
-            glClearNamedFramebufferfv(m_BufferID, GL_COLOR, i, glm::value_ptr(_Color));
+            glClearNamedFramebufferfv(GetDrawBufferID(), GL_COLOR, i, glm::value_ptr(_Color));
         }
-        glClearNamedFramebufferfv(m_BufferID, GL_DEPTH, 0, &Depth);
-        glClearNamedFramebufferiv(m_BufferID, GL_STENCIL, 0, &Stencil);
+        glClearNamedFramebufferfv(GetDrawBufferID(), GL_DEPTH, 0, &Depth);
+        glClearNamedFramebufferiv(GetDrawBufferID(), GL_STENCIL, 0, &Stencil);
     }
 
     void OGL4FrameBuffer::Resize(uint32_t _Width, uint32_t _Height)
@@ -204,6 +299,9 @@ namespace LM
 
         CreateTextures();
 
+        DestroyMultisample();
+        CreateMultisample();
+
         if (!HasRenderBuffer())
         {
             return;
@@ -214,6 +312,21 @@ namespace LM
         glNamedRenderbufferStorage(m_RenderBufferId, RenderBufferFormat, m_Width, m_Height);
     }
 
+    void OGL4FrameBuffer::SetSamples(uint32_t _Samples)
+    {
+        int maxSamples = 1;
+        glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+        _Samples = glm::clamp(_Samples, 1u, uint32_t(maxSamples));
+        if (_Samples == m_Samples)
+        {
+            return;
+        }
+
+        m_Samples = _Samples;
+        DestroyMultisample();
+        CreateMultisample();
+    }
+
     void OGL4FrameBuffer::BindColorTexture(uint32_t _Id, uint32_t _SlotId)
     {
         glBindTextureUnit(_SlotId, m_ColorTextures[_Id].Id);
@@ -33,6 +33,9 @@ namespace LM
 
         virtual void Resize(uint32_t _Width, uint32_t _Height) override;
 
+        virtual uint32_t GetSamples() const override { return m_Samples; }
+        virtual void SetSamples(uint32_t _Samples) override;
+
         virtual void BindColorTexture(uint32_t _Id, uint32_t _SlotId) override;
 
     protected:
@@ -42,7 +45,13 @@ namespace LM
         uint32_t GetRenderBufferFormat();
         uint32_t GetRenderBufferAttach();
         void CreateRenderBuffer();
-        void CheckStatus();
+        void CreateMultisample();
+        void DestroyMultisample();
+        void Resolve() const;
+        void CheckStatus(uint32_t _BufferID);
+
+        bool IsMultisampled() const { return m_Samples > 1; }
+        uint32_t GetDrawBufferID() const { return IsMultisampled() ? m_MultisampleBufferID : m_BufferID; }
 
     protected:
         struct ColorTexture
@@ -63,6 +72,12 @@ namespace LM
 
         std::vector<ColorTexture> m_ColorTextures;
         uint32_t m_BufferMask;
+
+        // Rendering goes here when m_Samples > 1, the color textures get the resolved image
+        uint32_t m_Samples = 1;
+        uint32_t m_MultisampleBufferID = 0;
+        std::vector<uint32_t> m_MultisampleColorIds;
+        uint32_t m_MultisampleRenderBufferId = 0;
     };
 
 }    // namespace LM
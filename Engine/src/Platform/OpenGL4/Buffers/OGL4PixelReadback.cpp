@@ -0,0 +1,119 @@
+#include "OGL4PixelReadback.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <GL/glew.h>
+
+#include "Engine/Utils/ConsoleLog.h"
+
+namespace LM
+{
+
+    constexpr size_t kPixelSize = 4;
+
+    OGL4PixelReadback::OGL4PixelReadback(uint32_t _SlotsCount, const ImageCallbackFn& _OnImage)
+        : m_Slots(std::max(_SlotsCount, 1u)), m_OnImage(_OnImage)
+    {
+        for (Slot& slot : m_Slots)
+        {
+            glCreateBuffers(1, &slot.BufferID);
+        }
+    }
+
+    OGL4PixelReadback::~OGL4PixelReadback()
+    {
+        for (Slot& slot : m_Slots)
+        {
+            if (slot.Fence)
+            {
+                glDeleteSync(static_cast<GLsync>(slot.Fence));
+            }
+            glDeleteBuffers(1, &slot.BufferID);
+        }
+    }
+
+    void OGL4PixelReadback::Read(const Ref<FrameBuffer>& _FrameBuffer, uint64_t _Tag)
+    {
+        Slot& slot = m_Slots[m_NextSlot];
+        if (slot.IsBusy)
+        {
+            Finish(slot);
+        }
+
+        slot.Tag = _Tag;
+        slot.Width = _FrameBuffer->GetWidth();
+        slot.Height = _FrameBuffer->GetHeight();
+
+        size_t size = size_t(slot.Width) * slot.Height * kPixelSize;
+        if (size > slot.Capacity)
+        {
+            // Immutable storage can't be resized, so the buffer is recreated
+            glDeleteBuffers(1, &slot.BufferID);
+            glCreateBuffers(1, &slot.BufferID);
+            glNamedBufferStorage(slot.BufferID, size, nullptr, GL_MAP_READ_BIT);
+            slot.Capacity = size;
+        }
+
+        uint32_t frameBufferID = uint32_t(size_t(_FrameBuffer->GetId()));
+        glNamedFramebufferReadBuffer(frameBufferID, GL_COLOR_ATTACHMENT0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, frameBufferID);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.BufferID);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, slot.Width, slot.Height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+        slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.IsBusy = true;
+
+        m_NextSlot = (m_NextSlot + 1) % m_Slots.size();
+    }
+
+    void OGL4PixelReadback::Flush()
+    {
+        // Starting from the oldest read keeps the order of images
+        for (size_t i = 0; i < m_Slots.size(); i++)
+        {
+            Slot& slot = m_Slots[(m_NextSlot + i) % m_Slots.size()];
+            if (slot.IsBusy)
+            {
+                Finish(slot);
+            }
+        }
+    }
+
+    void OGL4PixelReadback::Finish(Slot& _Slot)
+    {
+        GLsync fence = static_cast<GLsync>(_Slot.Fence);
+        GLenum waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        while (waitResult == GL_TIMEOUT_EXPIRED)
+        {
+            waitResult = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }
+        glDeleteSync(fence);
+        _Slot.Fence = nullptr;
+        _Slot.IsBusy = false;
+
+        ReadbackImage image;
+        image.Tag = _Slot.Tag;
+        image.Width = _Slot.Width;
+        image.Height = _Slot.Height;
+        image.Pixels.resize(size_t(_Slot.Width) * _Slot.Height * kPixelSize);
+
+        const void* mapped = glMapNamedBufferRange(_Slot.BufferID, 0, image.Pixels.size(), GL_MAP_READ_BIT);
+        if (!mapped)
+        {
+            LOGE("Can't map pixel buffer of image ", _Slot.Tag);
+            return;
+        }
+        std::memcpy(image.Pixels.data(), mapped, image.Pixels.size());
+        glUnmapNamedBuffer(_Slot.BufferID);
+
+        if (m_OnImage)
+        {
+            m_OnImage(std::move(image));
+        }
+    }
+
+}    // namespace LM
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Engine/Buffers/PixelReadback.h"
+
+namespace LM
+{
+
+    // glReadPixels into a GL_PIXEL_PACK_BUFFER returns right away, a fence after it tells when the copy is done
+    class OGL4PixelReadback : public PixelReadback
+    {
+    public:
+        OGL4PixelReadback(uint32_t _SlotsCount, const ImageCallbackFn& _OnImage);
+        virtual ~OGL4PixelReadback();
+
+        virtual void Read(const Ref<FrameBuffer>& _FrameBuffer, uint64_t _Tag) override;
+        virtual void Flush() override;
+
+        virtual uint32_t GetSlotsCount() const override { return uint32_t(m_Slots.size()); }
+
+    protected:
+        struct Slot
+        {
+            uint32_t BufferID = 0;
+            size_t Capacity = 0;
+
+            bool IsBusy = false;
+            uint64_t Tag = 0;
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+            // GLsync of the read
+            void* Fence = nullptr;
+        };
+
+        void Finish(Slot& _Slot);
+
+    protected:
+        std::vector<Slot> m_Slots;
+        uint32_t m_NextSlot = 0;
+
+        ImageCallbackFn m_OnImage;
+    };
+
+}    // namespace LM
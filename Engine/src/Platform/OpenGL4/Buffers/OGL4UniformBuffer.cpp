@@ -0,0 +1,34 @@
+#include "OGL4UniformBuffer.h"
+
+#include <GL/glew.h>
+
+namespace LM
+{
+
+    OGL4UniformBuffer::OGL4UniformBuffer(uint32_t _Size)
+    {
+        glCreateBuffers(1, &m_BufferID);
+        glNamedBufferData(m_BufferID, _Size, nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    OGL4UniformBuffer::OGL4UniformBuffer(const void* _Data, uint32_t _Size)
+    {
+        glCreateBuffers(1, &m_BufferID);
+        glNamedBufferData(m_BufferID, _Size, _Data, GL_DYNAMIC_DRAW);
+    }
+
+    OGL4UniformBuffer::~OGL4UniformBuffer() { glDeleteBuffers(1, &m_BufferID); }
+
+    void OGL4UniformBuffer::Bind(uint32_t _SlotId) const
+    {
+        glBindBufferBase(GL_UNIFORM_BUFFER, _SlotId, m_BufferID);
+    }
+
+    void OGL4UniformBuffer::Unbind() const { glBindBuffer(GL_UNIFORM_BUFFER, 0); }
+
+    void OGL4UniformBuffer::SetData(const void* _Data, uint32_t _Size)
+    {
+        glNamedBufferSubData(m_BufferID, 0, _Size, _Data);
+    }
+
+}    // namespace LM
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Engine/Buffers/UniformBuffer.h"
+
+namespace LM
+{
+
+    class OGL4UniformBuffer : public UniformBuffer
+    {
+    public:
+        OGL4UniformBuffer(uint32_t _Size);
+        OGL4UniformBuffer(const void* _Data, uint32_t _Size);
+        virtual ~OGL4UniformBuffer();
+
+        virtual void Bind(uint32_t _SlotId) const override;
+        virtual void Unbind() const override;
+
+        virtual void SetData(const void* _Data, uint32_t _Size) override;
+
+        inline uint32_t GetBufferID() const { return m_BufferID; }
+
+    protected:
+        uint32_t m_BufferID;
+    };
+
+}    // namespace LM
@@ -40,8 +40,13 @@ namespace LM
 
     void OGL4VertexArray::AddVertexBuffer(const Ref<VertexBuffer>& _VertexBuffer)
     {
-        CORE_ASSERT(_VertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
-        const auto& Layout = _VertexBuffer->GetLayout();
+        AddVertexBuffer(StaticRefCast<OGL4VertexBuffer>(_VertexBuffer)->GetBufferID(), _VertexBuffer->GetLayout());
+        m_VertexBuffers.push_back(_VertexBuffer);
+    }
+
+    void OGL4VertexArray::AddVertexBuffer(uint32_t _BufferID, const BufferLayout& _Layout)
+    {
+        CORE_ASSERT(_Layout.GetElements().size(), "Vertex Buffer has no layout!");
 
         int BuffersOffset = 0;
         // for (const auto& VB : m_VertexBuffers)
@@ -49,10 +54,8 @@ namespace LM
         //	BuffersOffset += VB->GetLayout().GetStride();
         // }
 
-        glVertexArrayVertexBuffer(m_BufferID, m_VertexBuffers.size(),
-                                  StaticRefCast<OGL4VertexBuffer>(_VertexBuffer)->GetBufferID(), BuffersOffset,
-                                  Layout.GetStride());
-        for (const auto& Element : Layout)
+        glVertexArrayVertexBuffer(m_BufferID, m_BindingIndex, _BufferID, BuffersOffset, _Layout.GetStride());
+        for (const auto& Element : _Layout)
         {
             switch (Element.Type)
             {
@@ -64,7 +67,7 @@ namespace LM
                     glVertexArrayAttribFormat(m_BufferID, m_VertexBufferIndex, Element.GetComponentCount(),
                                               ShaderDataTypeToOpenGLBaseType(Element.Type),
                                               Element.Normalized ? GL_TRUE : GL_FALSE, Element.Offset);
-                    glVertexArrayAttribBinding(m_BufferID, m_VertexBufferIndex, m_VertexBuffers.size());
+                    glVertexArrayAttribBinding(m_BufferID, m_VertexBufferIndex, m_BindingIndex);
                     m_VertexBufferIndex++;
                     break;
                 }
@@ -76,7 +79,7 @@ namespace LM
                     glEnableVertexArrayAttrib(m_BufferID, m_VertexBufferIndex);
                     glVertexArrayAttribIFormat(m_BufferID, m_VertexBufferIndex, Element.GetComponentCount(),
                                                ShaderDataTypeToOpenGLBaseType(Element.Type), Element.Offset);
-                    glVertexArrayAttribBinding(m_BufferID, m_VertexBufferIndex, m_VertexBuffers.size());
+                    glVertexArrayAttribBinding(m_BufferID, m_VertexBufferIndex, m_BindingIndex);
                     m_VertexBufferIndex++;
                     break;
                 }
@@ -89,25 +92,27 @@ namespace LM
                         glVertexArrayAttribFormat(
                             m_BufferID, m_VertexBufferIndex, Count, ShaderDataTypeToOpenGLBaseType(Element.Type),
                             Element.Normalized ? GL_TRUE : GL_FALSE, Element.Offset + sizeof(float) * Count * i);
-                        glVertexArrayAttribBinding(m_BufferID, m_VertexBufferIndex, m_VertexBuffers.size());
+                        glVertexArrayAttribBinding(m_BufferID, m_VertexBufferIndex, m_BindingIndex);
                         m_VertexBufferIndex++;
                     }
                     break;
                 }
             }
         }
-        if (Layout.HasDivisor())
+        if (_Layout.HasDivisor())
         {
-            glVertexArrayBindingDivisor(m_BufferID, m_VertexBuffers.size(), Layout.GetDivisor());
+            glVertexArrayBindingDivisor(m_BufferID, m_BindingIndex, _Layout.GetDivisor());
             LOGW("[OGL4]: SET DIV F");
         }
-        m_VertexBuffers.push_back(_VertexBuffer);
+        m_BindingIndex++;
     }
 
     void OGL4VertexArray::SetIndexBuffer(const Ref<IndexBuffer>& _IndexBuffer)
     {
-        glVertexArrayElementBuffer(m_BufferID, StaticRefCast<OGL4IndexBuffer>(_IndexBuffer)->GetBufferID());
+        SetIndexBuffer(StaticRefCast<OGL4IndexBuffer>(_IndexBuffer)->GetBufferID());
         m_IndexBuffer = _IndexBuffer;
     }
 
+    void OGL4VertexArray::SetIndexBuffer(uint32_t _BufferID) { glVertexArrayElementBuffer(m_BufferID, _BufferID); }
+
 }    // namespace LM
@@ -17,12 +17,17 @@ namespace LM
         virtual void AddVertexBuffer(const Ref<VertexBuffer>& _VertexBuffer) override;
         virtual void SetIndexBuffer(const Ref<IndexBuffer>& _IndexBuffer) override;
 
+        // For buffers which are not owned by VertexBuffer / IndexBuffer, e.g. persistent mapped ones
+        void AddVertexBuffer(uint32_t _BufferID, const BufferLayout& _Layout);
+        void SetIndexBuffer(uint32_t _BufferID);
+
         virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override { return m_VertexBuffers; }
         virtual const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
 
     protected:
         uint32_t m_BufferID;
         mutable uint32_t m_VertexBufferIndex = 0;
+        uint32_t m_BindingIndex = 0;
         std::vector<Ref<VertexBuffer>> m_VertexBuffers;
         Ref<IndexBuffer> m_IndexBuffer;
     };
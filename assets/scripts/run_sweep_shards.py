@@ -0,0 +1,52 @@
+"""Runs a sweep job as several local SweepWorker processes (one per shard) and merges the shard files.
+
+Example:
+    python3 run_sweep_shards.py build/App/SweepWorker sweep/job.json sweep --shards 8
+
+Shards of the same job can also be started on other machines with the same out_dir on a shared directory,
+the merge step only needs all shard files to be present.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("worker", help="path to the SweepWorker executable")
+    parser.add_argument("job", help="sweep job file exported from the editor")
+    parser.add_argument("out_dir", help="directory for the shard files and the merged result")
+    parser.add_argument("--shards", type=int, default=os.cpu_count() or 1, help="count of worker processes")
+    parser.add_argument("--top", type=int, default=100, help="count of best results to keep")
+    parser.add_argument("--threads", action="store_true", help="let every worker use all cores too")
+    parser.add_argument("--checkpoint",
+                        action="store_true",
+                        help="save shard progress to out_dir, a rerun continues from the saved progress")
+    parser.add_argument("--checkpoint-interval", type=int, default=60, help="seconds between checkpoints")
+    args = parser.parse_args()
+
+    if args.shards < 1:
+        parser.error("--shards must be greater than 0")
+
+    processes = []
+    for shard in range(args.shards):
+        command = [args.worker, "run", args.job, str(shard), str(args.shards), args.out_dir, "--top", str(args.top)]
+        if not args.threads:
+            command.append("--single-thread")
+        if args.checkpoint:
+            checkpoint = os.path.join(args.out_dir, "shard_{}_of_{}.checkpoint.json".format(shard, args.shards))
+            command += ["--checkpoint", checkpoint, "--checkpoint-interval", str(args.checkpoint_interval)]
+        processes.append(subprocess.Popen(command))
+
+    failed = [shard for shard, process in enumerate(processes) if process.wait() != 0]
+    if failed:
+        print("Failed shards: " + ", ".join(str(shard) for shard in failed), file=sys.stderr)
+        return 1
+
+    return subprocess.call([args.worker, "merge", args.out_dir, str(args.shards), "--top", str(args.top)])
+
+
+if __name__ == "__main__":
+    sys.exit(main())
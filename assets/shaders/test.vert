@@ -2,8 +2,12 @@
 
 out vec4 v_Position;
 
-uniform mat4 u_ProjectionMatrix = mat4(1.0);
-uniform mat4 u_ViewMatrix = mat4(1.0);
+layout(std140, binding = 0) uniform Camera
+{
+    mat4 u_ProjectionMatrix;
+    mat4 u_ViewMatrix;
+};
+
 uniform mat4 u_ModelMatrix = mat4(1.0);
 
 void main()
@@ -0,0 +1,5 @@
+layout(location = 0) out vec4 o_Color;
+
+in vec4 v_Color;
+
+void main() { o_Color = v_Color; }
@@ -0,0 +1,23 @@
+
+struct WheelInstance
+{
+    mat4 ModelMatrix;
+    vec4 Color;
+};
+
+layout(std430, binding = 0) readonly buffer WheelInstances { WheelInstance u_Instances[]; };
+
+out vec4 v_Color;
+
+layout(std140, binding = 0) uniform Camera
+{
+    mat4 u_ProjectionMatrix;
+    mat4 u_ViewMatrix;
+};
+
+void main()
+{
+    WheelInstance instance = u_Instances[a_InstanceId];
+    v_Color = instance.Color;
+    gl_Position = u_ProjectionMatrix * u_ViewMatrix * instance.ModelMatrix * a_Position;
+}